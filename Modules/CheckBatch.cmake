@@ -0,0 +1,144 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+#.rst:
+# CheckBatch
+# ----------
+#
+# Provides macros to run several checks concurrently.
+#
+# .. command:: CHECK_BATCH_BEGIN
+#
+#   ::
+#
+#     CHECK_BATCH_BEGIN()
+#
+#   Start collecting checks.  The checks listed below generate their
+#   test projects right away but leave building them to the matching
+#   :command:`CHECK_BATCH_END` call.  Their result variables are not
+#   defined before that call.
+#
+# .. command:: CHECK_BATCH_END
+#
+#   ::
+#
+#     CHECK_BATCH_END([PARALLEL_LEVEL <n>])
+#
+#   Build the test projects of all checks collected since
+#   :command:`CHECK_BATCH_BEGIN`, running up to ``<n>`` builds at once,
+#   and store each result, print each status message, and append to the
+#   log files as the check would have done when run on its own.  The
+#   logged build output names the test project directory of each check,
+#   which is a subdirectory of ``CMakeFiles/CheckBatch``.
+#   By default as many builds are run at once as there are logical
+#   processors.
+#
+# The following checks take part in a batch:
+#
+# * ``CHECK_C_SOURCE_COMPILES`` and ``CHECK_CXX_SOURCE_COMPILES``,
+#   unless called with ``FAIL_REGEX``
+# * ``CHECK_FUNCTION_EXISTS``
+# * ``CHECK_INCLUDE_FILE``, ``CHECK_INCLUDE_FILE_CXX``, and
+#   ``CHECK_INCLUDE_FILES``
+# * ``CHECK_SYMBOL_EXISTS`` and ``CHECK_CXX_SYMBOL_EXISTS``
+#
+# Checks implemented on top of these, such as those of the
+# :module:`CheckStructHasMember` module, take part as well.  Other checks
+# called between the two macros run immediately as usual.
+#
+# Example:
+#
+# .. code-block:: cmake
+#
+#   include(CheckBatch)
+#   include(CheckIncludeFile)
+#   include(CheckSymbolExists)
+#   check_batch_begin()
+#   check_include_file(unistd.h HAVE_UNISTD_H)
+#   check_symbol_exists(strlcpy string.h HAVE_STRLCPY)
+#   check_batch_end()
+#   # HAVE_UNISTD_H and HAVE_STRLCPY are defined from here on.
+
+function(CHECK_BATCH_BEGIN)
+  get_property(active GLOBAL PROPERTY _CHECK_BATCH_ACTIVE)
+  if(active)
+    message(FATAL_ERROR "CHECK_BATCH_BEGIN called again before CHECK_BATCH_END")
+  endif()
+  set(dir "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckBatch")
+  file(REMOVE_RECURSE "${dir}")
+  file(WRITE "${dir}/Finish.cmake" "")
+  set_property(GLOBAL PROPERTY _CHECK_BATCH_ACTIVE 1)
+  set_property(GLOBAL PROPERTY _CHECK_BATCH_COUNT 0)
+endfunction()
+
+function(CHECK_BATCH_END)
+  get_property(active GLOBAL PROPERTY _CHECK_BATCH_ACTIVE)
+  if(NOT active)
+    message(FATAL_ERROR "CHECK_BATCH_END called without CHECK_BATCH_BEGIN")
+  endif()
+  if(ARGC EQUAL 2 AND ARGV0 STREQUAL "PARALLEL_LEVEL")
+    set(parallel "${ARGV1}")
+  elseif(ARGC EQUAL 0)
+    cmake_host_system_information(RESULT parallel
+      QUERY NUMBER_OF_LOGICAL_CORES)
+  else()
+    message(FATAL_ERROR "CHECK_BATCH_END given unknown arguments:\n  ${ARGV}\n")
+  endif()
+  set_property(GLOBAL PROPERTY _CHECK_BATCH_ACTIVE "")
+
+  try_compile(BUILD_DEFERRED PARALLEL_LEVEL ${parallel})
+
+  # Report the results in the order the checks were called.
+  set(dir "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckBatch")
+  include("${dir}/Finish.cmake")
+  file(REMOVE_RECURSE "${dir}")
+endfunction()
+
+# Choose how a check runs try_compile.  Sets <dir_var> to the <bindir>
+# to use, <output_var> to the name of the variable to pass as the
+# OUTPUT_VARIABLE, and <defer_var> to the DEFER option within a batch.
+# Pass IMMEDIATE to build the test project now even within a batch.
+macro(_CHECK_BATCH_PROBE _dir_var _output_var _defer_var)
+  get_property(_CHECK_BATCH_PROBE_active GLOBAL PROPERTY _CHECK_BATCH_ACTIVE)
+  if(_CHECK_BATCH_PROBE_active AND NOT "${ARGN}" STREQUAL "IMMEDIATE")
+    get_property(_CHECK_BATCH_PROBE_count GLOBAL PROPERTY _CHECK_BATCH_COUNT)
+    math(EXPR _CHECK_BATCH_PROBE_count "${_CHECK_BATCH_PROBE_count} + 1")
+    set_property(GLOBAL PROPERTY _CHECK_BATCH_COUNT ${_CHECK_BATCH_PROBE_count})
+    set(${_dir_var}
+      "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckBatch/${_CHECK_BATCH_PROBE_count}")
+    set(${_output_var} _CHECK_BATCH_OUTPUT_${_CHECK_BATCH_PROBE_count})
+    # A check of an earlier batch may have left the variable set here.
+    # It must be defined only when try_compile gives a result at once.
+    unset(_CHECK_BATCH_OUTPUT_${_CHECK_BATCH_PROBE_count})
+    set(${_defer_var} DEFER)
+  else()
+    set(${_dir_var} "${CMAKE_BINARY_DIR}")
+    set(${_output_var} OUTPUT)
+    set(${_defer_var})
+  endif()
+endmacro()
+
+# Record a call of the given macro to be made by CHECK_BATCH_END once
+# the build of a deferred check finished.  The remaining arguments are
+# passed verbatim, followed by the value of the check's output variable.
+function(_CHECK_BATCH_DEFER _output_var _macro)
+  set(call "${_macro}(")
+  if(ARGC GREATER 2)
+    math(EXPR last "${ARGC} - 1")
+    foreach(i RANGE 2 ${last})
+      # Quote the argument with a bracket argument that it does not
+      # close itself.  The newline after the opening bracket is dropped.
+      set(arg "${ARGV${i}}")
+      set(eq "=")
+      string(FIND "${arg}" "]${eq}]" pos)
+      while(NOT pos EQUAL -1)
+        string(APPEND eq "=")
+        string(FIND "${arg}" "]${eq}]" pos)
+      endwhile()
+      string(APPEND call " [${eq}[\n${arg}]${eq}]")
+    endforeach()
+  endif()
+  string(APPEND call " \"\${${_output_var}}\")\n")
+  file(APPEND "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckBatch/Finish.cmake"
+    "${call}")
+endfunction()
@@ -26,6 +26,10 @@
 #   CMAKE_REQUIRED_INCLUDES = list of include directories
 #   CMAKE_REQUIRED_LIBRARIES = list of libraries to link
 #   CMAKE_REQUIRED_QUIET = execute quietly without messages
+#
+# See the :module:`CheckBatch` module to run several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_C_SOURCE_COMPILES SOURCE VAR)
   if(NOT DEFINED "${VAR}")
@@ -54,46 +58,62 @@ macro(CHECK_C_SOURCE_COMPILES SOURCE VAR)
     else()
       set(CHECK_C_SOURCE_COMPILES_ADD_INCLUDES)
     endif()
-    file(WRITE "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c"
+    # The output of a check with FAIL_REGEX must be matched right away.
+    if(_FAIL_REGEX)
+      _CHECK_BATCH_PROBE(_CCSC_BINARY_DIR _CCSC_OUTPUT _CCSC_DEFER IMMEDIATE)
+    else()
+      _CHECK_BATCH_PROBE(_CCSC_BINARY_DIR _CCSC_OUTPUT _CCSC_DEFER)
+    endif()
+    file(WRITE "${_CCSC_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c"
       "${SOURCE}\n")
 
     if(NOT CMAKE_REQUIRED_QUIET)
       message(STATUS "Performing Test ${VAR}")
     endif()
     try_compile(${VAR}
-      ${CMAKE_BINARY_DIR}
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c
+      ${_CCSC_BINARY_DIR}
+      ${_CCSC_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       ${CHECK_C_SOURCE_COMPILES_ADD_LIBRARIES}
       CMAKE_FLAGS -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_FUNCTION_DEFINITIONS}
       "${CHECK_C_SOURCE_COMPILES_ADD_INCLUDES}"
-      OUTPUT_VARIABLE OUTPUT)
-
-    foreach(_regex ${_FAIL_REGEX})
-      if("${OUTPUT}" MATCHES "${_regex}")
-        set(${VAR} 0)
-      endif()
-    endforeach()
+      OUTPUT_VARIABLE ${_CCSC_OUTPUT}
+      ${_CCSC_DEFER})
 
-    if(${VAR})
-      set(${VAR} 1 CACHE INTERNAL "Test ${VAR}")
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Performing Test ${VAR} - Success")
-      endif()
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Performing C SOURCE FILE Test ${VAR} succeeded with the following output:\n"
-        "${OUTPUT}\n"
-        "Source file was:\n${SOURCE}\n")
+    if(DEFINED ${_CCSC_OUTPUT})
+      _CHECK_C_SOURCE_COMPILES_RESULT("${SOURCE}" "${VAR}" "${_FAIL_REGEX}"
+        "${CMAKE_REQUIRED_QUIET}" "${${_CCSC_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Performing Test ${VAR} - Failed")
-      endif()
-      set(${VAR} "" CACHE INTERNAL "Test ${VAR}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Performing C SOURCE FILE Test ${VAR} failed with the following output:\n"
-        "${OUTPUT}\n"
-        "Source file was:\n${SOURCE}\n")
+      _CHECK_BATCH_DEFER(${_CCSC_OUTPUT} _CHECK_C_SOURCE_COMPILES_RESULT
+        "${SOURCE}" "${VAR}" "" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
 
+function(_CHECK_C_SOURCE_COMPILES_RESULT SOURCE VAR FAIL_REGEX QUIET OUTPUT)
+  foreach(_regex ${FAIL_REGEX})
+    if("${OUTPUT}" MATCHES "${_regex}")
+      set(${VAR} 0)
+    endif()
+  endforeach()
+
+  if(${VAR})
+    set(${VAR} 1 CACHE INTERNAL "Test ${VAR}")
+    if(NOT QUIET)
+      message(STATUS "Performing Test ${VAR} - Success")
+    endif()
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Performing C SOURCE FILE Test ${VAR} succeeded with the following output:\n"
+      "${OUTPUT}\n"
+      "Source file was:\n${SOURCE}\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Performing Test ${VAR} - Failed")
+    endif()
+    set(${VAR} "" CACHE INTERNAL "Test ${VAR}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Performing C SOURCE FILE Test ${VAR} failed with the following output:\n"
+      "${OUTPUT}\n"
+      "Source file was:\n${SOURCE}\n")
+  endif()
+endfunction()
@@ -25,6 +25,10 @@
 #   CMAKE_REQUIRED_INCLUDES = list of include directories
 #   CMAKE_REQUIRED_LIBRARIES = list of libraries to link
 #   CMAKE_REQUIRED_QUIET = execute quietly without messages
+#
+# See the :module:`CheckBatch` module to run several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_FUNCTION_EXISTS FUNCTION VARIABLE)
   if(NOT DEFINED "${VARIABLE}" OR "x${${VARIABLE}}" STREQUAL "x${VARIABLE}")
@@ -55,32 +59,44 @@ macro(CHECK_FUNCTION_EXISTS FUNCTION VARIABLE)
       message(FATAL_ERROR "CHECK_FUNCTION_EXISTS needs either C or CXX language enabled")
     endif()
 
+    _CHECK_BATCH_PROBE(_CFE_BINARY_DIR _CFE_OUTPUT _CFE_DEFER)
     try_compile(${VARIABLE}
-      ${CMAKE_BINARY_DIR}
+      ${_CFE_BINARY_DIR}
       ${_cfe_source}
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       ${CHECK_FUNCTION_EXISTS_ADD_LIBRARIES}
       CMAKE_FLAGS -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_FUNCTION_DEFINITIONS}
       "${CHECK_FUNCTION_EXISTS_ADD_INCLUDES}"
-      OUTPUT_VARIABLE OUTPUT)
+      OUTPUT_VARIABLE ${_CFE_OUTPUT}
+      ${_CFE_DEFER})
     unset(_cfe_source)
 
-    if(${VARIABLE})
-      set(${VARIABLE} 1 CACHE INTERNAL "Have function ${FUNCTION}")
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${FUNCTION} - found")
-      endif()
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the function ${FUNCTION} exists passed with the following output:\n"
-        "${OUTPUT}\n\n")
+    if(DEFINED ${_CFE_OUTPUT})
+      _CHECK_FUNCTION_EXISTS_RESULT("${FUNCTION}" "${VARIABLE}"
+        "${CMAKE_REQUIRED_QUIET}" "${${_CFE_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${FUNCTION} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have function ${FUNCTION}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the function ${FUNCTION} exists failed with the following output:\n"
-        "${OUTPUT}\n\n")
+      _CHECK_BATCH_DEFER(${_CFE_OUTPUT} _CHECK_FUNCTION_EXISTS_RESULT
+        "${FUNCTION}" "${VARIABLE}" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
+
+function(_CHECK_FUNCTION_EXISTS_RESULT FUNCTION VARIABLE QUIET OUTPUT)
+  if(${VARIABLE})
+    set(${VARIABLE} 1 CACHE INTERNAL "Have function ${FUNCTION}")
+    if(NOT QUIET)
+      message(STATUS "Looking for ${FUNCTION} - found")
+    endif()
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if the function ${FUNCTION} exists passed with the following output:\n"
+      "${OUTPUT}\n\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Looking for ${FUNCTION} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have function ${FUNCTION}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if the function ${FUNCTION} exists failed with the following output:\n"
+      "${OUTPUT}\n\n")
+  endif()
+endfunction()
@@ -32,7 +32,10 @@
 #
 # See the :module:`CheckIncludeFiles` module to check for multiple headers
 # at once.  See the :module:`CheckIncludeFileCXX` module to check for headers
-# using the ``CXX`` language.
+# using the ``CXX`` language.  See the :module:`CheckBatch` module to run
+# several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
   if(NOT DEFINED "${VARIABLE}")
@@ -43,8 +46,9 @@ macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
     endif()
     set(MACRO_CHECK_INCLUDE_FILE_FLAGS ${CMAKE_REQUIRED_FLAGS})
     set(CHECK_INCLUDE_FILE_VAR ${INCLUDE})
+    _CHECK_BATCH_PROBE(_CIF_BINARY_DIR _CIF_OUTPUT _CIF_DEFER)
     configure_file(${CMAKE_ROOT}/Modules/CheckIncludeFile.c.in
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c)
+      ${_CIF_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c)
     if(NOT CMAKE_REQUIRED_QUIET)
       message(STATUS "Looking for ${INCLUDE}")
     endif()
@@ -54,36 +58,47 @@ macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
     endif()
 
     try_compile(${VARIABLE}
-      ${CMAKE_BINARY_DIR}
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c
+      ${_CIF_BINARY_DIR}
+      ${_CIF_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_INCLUDE_FILE_FLAGS}
       "${CHECK_INCLUDE_FILE_C_INCLUDE_DIRS}"
-      OUTPUT_VARIABLE OUTPUT)
+      OUTPUT_VARIABLE ${_CIF_OUTPUT}
+      ${_CIF_DEFER})
 
     if(${ARGC} EQUAL 3)
       set(CMAKE_C_FLAGS ${CMAKE_C_FLAGS_SAVE})
     endif()
 
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${INCLUDE} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the include file ${INCLUDE} "
-        "exists passed with the following output:\n"
-        "${OUTPUT}\n\n")
+    if(DEFINED ${_CIF_OUTPUT})
+      _CHECK_INCLUDE_FILE_RESULT("${INCLUDE}" "${VARIABLE}"
+        "${CMAKE_REQUIRED_QUIET}" "${${_CIF_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${INCLUDE} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the include file ${INCLUDE} "
-        "exists failed with the following output:\n"
-        "${OUTPUT}\n\n")
+      _CHECK_BATCH_DEFER(${_CIF_OUTPUT} _CHECK_INCLUDE_FILE_RESULT
+        "${INCLUDE}" "${VARIABLE}" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
+
+function(_CHECK_INCLUDE_FILE_RESULT INCLUDE VARIABLE QUIET OUTPUT)
+  if(${VARIABLE})
+    if(NOT QUIET)
+      message(STATUS "Looking for ${INCLUDE} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if the include file ${INCLUDE} "
+      "exists passed with the following output:\n"
+      "${OUTPUT}\n\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Looking for ${INCLUDE} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if the include file ${INCLUDE} "
+      "exists failed with the following output:\n"
+      "${OUTPUT}\n\n")
+  endif()
+endfunction()
@@ -31,7 +31,10 @@
 #   execute quietly without messages
 #
 # See modules :module:`CheckIncludeFile` and :module:`CheckIncludeFiles`
-# to check for one or more ``C`` headers.
+# to check for one or more ``C`` headers.  See the :module:`CheckBatch`
+# module to run several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_INCLUDE_FILE_CXX INCLUDE VARIABLE)
   if(NOT DEFINED "${VARIABLE}" OR "x${${VARIABLE}}" STREQUAL "x${VARIABLE}")
@@ -42,8 +45,9 @@ macro(CHECK_INCLUDE_FILE_CXX INCLUDE VARIABLE)
     endif()
     set(MACRO_CHECK_INCLUDE_FILE_FLAGS ${CMAKE_REQUIRED_FLAGS})
     set(CHECK_INCLUDE_FILE_VAR ${INCLUDE})
+    _CHECK_BATCH_PROBE(_CIFX_BINARY_DIR _CIFX_OUTPUT _CIFX_DEFER)
     configure_file(${CMAKE_ROOT}/Modules/CheckIncludeFile.cxx.in
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.cxx)
+      ${_CIFX_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.cxx)
     if(NOT CMAKE_REQUIRED_QUIET)
       message(STATUS "Looking for C++ include ${INCLUDE}")
     endif()
@@ -53,36 +57,47 @@ macro(CHECK_INCLUDE_FILE_CXX INCLUDE VARIABLE)
     endif()
 
     try_compile(${VARIABLE}
-      ${CMAKE_BINARY_DIR}
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.cxx
+      ${_CIFX_BINARY_DIR}
+      ${_CIFX_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.cxx
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_INCLUDE_FILE_FLAGS}
       "${CHECK_INCLUDE_FILE_CXX_INCLUDE_DIRS}"
-      OUTPUT_VARIABLE OUTPUT)
+      OUTPUT_VARIABLE ${_CIFX_OUTPUT}
+      ${_CIFX_DEFER})
 
     if(${ARGC} EQUAL 3)
       set(CMAKE_CXX_FLAGS ${CMAKE_CXX_FLAGS_SAVE})
     endif()
 
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for C++ include ${INCLUDE} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the include file ${INCLUDE} "
-        "exists passed with the following output:\n"
-        "${OUTPUT}\n\n")
+    if(DEFINED ${_CIFX_OUTPUT})
+      _CHECK_INCLUDE_FILE_CXX_RESULT("${INCLUDE}" "${VARIABLE}"
+        "${CMAKE_REQUIRED_QUIET}" "${${_CIFX_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for C++ include ${INCLUDE} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the include file ${INCLUDE} "
-        "exists failed with the following output:\n"
-        "${OUTPUT}\n\n")
+      _CHECK_BATCH_DEFER(${_CIFX_OUTPUT} _CHECK_INCLUDE_FILE_CXX_RESULT
+        "${INCLUDE}" "${VARIABLE}" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
+
+function(_CHECK_INCLUDE_FILE_CXX_RESULT INCLUDE VARIABLE QUIET OUTPUT)
+  if(${VARIABLE})
+    if(NOT QUIET)
+      message(STATUS "Looking for C++ include ${INCLUDE} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if the include file ${INCLUDE} "
+      "exists passed with the following output:\n"
+      "${OUTPUT}\n\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Looking for C++ include ${INCLUDE} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if the include file ${INCLUDE} "
+      "exists failed with the following output:\n"
+      "${OUTPUT}\n\n")
+  endif()
+endfunction()
@@ -33,6 +33,9 @@
 #
 # See modules :module:`CheckIncludeFile` and :module:`CheckIncludeFileCXX`
 # to check for a single header file in ``C`` or ``CXX`` languages.
+# See the :module:`CheckBatch` module to run several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_INCLUDE_FILES INCLUDE VARIABLE)
   if(NOT DEFINED "${VARIABLE}")
@@ -50,8 +53,9 @@ macro(CHECK_INCLUDE_FILES INCLUDE VARIABLE)
     endforeach()
     string(APPEND CMAKE_CONFIGURABLE_FILE_CONTENT
       "\n\nint main(void){return 0;}\n")
+    _CHECK_BATCH_PROBE(_CIFS_BINARY_DIR _CIFS_OUTPUT _CIFS_DEFER)
     configure_file("${CMAKE_ROOT}/Modules/CMakeConfigurableFile.in"
-      "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFiles.c" @ONLY)
+      "${_CIFS_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFiles.c" @ONLY)
 
     set(_INCLUDE ${INCLUDE}) # remove empty elements
     if("${_INCLUDE}" MATCHES "^([^;]+);.+;([^;]+)$")
@@ -67,31 +71,44 @@ macro(CHECK_INCLUDE_FILES INCLUDE VARIABLE)
       message(STATUS "Looking for ${_description}")
     endif()
     try_compile(${VARIABLE}
-      ${CMAKE_BINARY_DIR}
-      ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFiles.c
+      ${_CIFS_BINARY_DIR}
+      ${_CIFS_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFiles.c
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_INCLUDE_FILES_FLAGS}
       "${CHECK_INCLUDE_FILES_INCLUDE_DIRS}"
-      OUTPUT_VARIABLE OUTPUT)
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${_description} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if files ${INCLUDE} "
-        "exist passed with the following output:\n"
-        "${OUTPUT}\n\n")
+      OUTPUT_VARIABLE ${_CIFS_OUTPUT}
+      ${_CIFS_DEFER})
+    if(DEFINED ${_CIFS_OUTPUT})
+      _CHECK_INCLUDE_FILES_RESULT("${INCLUDE}" "${VARIABLE}" "${_description}"
+        "${CMAKE_CONFIGURABLE_FILE_CONTENT}" "${CMAKE_REQUIRED_QUIET}"
+        "${${_CIFS_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${_description} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have includes ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if files ${INCLUDE} "
-        "exist failed with the following output:\n"
-        "${OUTPUT}\nSource:\n${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
+      _CHECK_BATCH_DEFER(${_CIFS_OUTPUT} _CHECK_INCLUDE_FILES_RESULT
+        "${INCLUDE}" "${VARIABLE}" "${_description}"
+        "${CMAKE_CONFIGURABLE_FILE_CONTENT}" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
+
+function(_CHECK_INCLUDE_FILES_RESULT INCLUDE VARIABLE DESCRIPTION CONTENT QUIET OUTPUT)
+  if(${VARIABLE})
+    if(NOT QUIET)
+      message(STATUS "Looking for ${DESCRIPTION} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if files ${INCLUDE} "
+      "exist passed with the following output:\n"
+      "${OUTPUT}\n\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Looking for ${DESCRIPTION} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have includes ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if files ${INCLUDE} "
+      "exist failed with the following output:\n"
+      "${OUTPUT}\nSource:\n${CONTENT}\n")
+  endif()
+endfunction()
@@ -33,6 +33,10 @@
 #   CMAKE_REQUIRED_INCLUDES = list of include directories
 #   CMAKE_REQUIRED_LIBRARIES = list of libraries to link
 #   CMAKE_REQUIRED_QUIET = execute quietly without messages
+#
+# See the :module:`CheckBatch` module to run several checks concurrently.
+
+include(${CMAKE_CURRENT_LIST_DIR}/CheckBatch.cmake)
 
 macro(CHECK_SYMBOL_EXISTS SYMBOL FILES VARIABLE)
   if(CMAKE_C_COMPILER_LOADED)
@@ -67,41 +71,63 @@ macro(_CHECK_SYMBOL_EXISTS SOURCEFILE SYMBOL FILES VARIABLE)
     string(APPEND CMAKE_CONFIGURABLE_FILE_CONTENT
       "\nint main(int argc, char** argv)\n{\n  (void)argv;\n#ifndef ${SYMBOL}\n  return ((int*)(&${SYMBOL}))[argc];\n#else\n  (void)argc;\n  return 0;\n#endif\n}\n")
 
+    # Within a batch each check writes its source to its own directory.
+    _CHECK_BATCH_PROBE(_CSE_BINARY_DIR _CSE_OUTPUT _CSE_DEFER)
+    if(_CSE_DEFER)
+      get_filename_component(_CSE_SOURCEFILE "${SOURCEFILE}" NAME)
+      set(_CSE_SOURCEFILE
+        "${_CSE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/${_CSE_SOURCEFILE}")
+    else()
+      set(_CSE_SOURCEFILE "${SOURCEFILE}")
+    endif()
     configure_file("${CMAKE_ROOT}/Modules/CMakeConfigurableFile.in"
-      "${SOURCEFILE}" @ONLY)
+      "${_CSE_SOURCEFILE}" @ONLY)
 
     if(NOT CMAKE_REQUIRED_QUIET)
       message(STATUS "Looking for ${SYMBOL}")
     endif()
     try_compile(${VARIABLE}
-      ${CMAKE_BINARY_DIR}
-      "${SOURCEFILE}"
+      ${_CSE_BINARY_DIR}
+      "${_CSE_SOURCEFILE}"
       COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
       ${CHECK_SYMBOL_EXISTS_LIBS}
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_SYMBOL_EXISTS_FLAGS}
       "${CMAKE_SYMBOL_EXISTS_INCLUDES}"
-      OUTPUT_VARIABLE OUTPUT)
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the ${SYMBOL} "
-        "exist passed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
+      OUTPUT_VARIABLE ${_CSE_OUTPUT}
+      ${_CSE_DEFER})
+    if(DEFINED ${_CSE_OUTPUT})
+      _CHECK_SYMBOL_EXISTS_RESULT("${SOURCEFILE}" "${SYMBOL}" "${VARIABLE}"
+        "${CMAKE_CONFIGURABLE_FILE_CONTENT}" "${CMAKE_REQUIRED_QUIET}"
+        "${${_CSE_OUTPUT}}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the ${SYMBOL} "
-        "exist failed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
+      _CHECK_BATCH_DEFER(${_CSE_OUTPUT} _CHECK_SYMBOL_EXISTS_RESULT
+        "${SOURCEFILE}" "${SYMBOL}" "${VARIABLE}"
+        "${CMAKE_CONFIGURABLE_FILE_CONTENT}" "${CMAKE_REQUIRED_QUIET}")
     endif()
   endif()
 endmacro()
+
+function(_CHECK_SYMBOL_EXISTS_RESULT SOURCEFILE SYMBOL VARIABLE CONTENT QUIET OUTPUT)
+  if(${VARIABLE})
+    if(NOT QUIET)
+      message(STATUS "Looking for ${SYMBOL} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if the ${SYMBOL} "
+      "exist passed with the following output:\n"
+      "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+      "${CONTENT}\n")
+  else()
+    if(NOT QUIET)
+      message(STATUS "Looking for ${SYMBOL} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if the ${SYMBOL} "
+      "exist failed with the following output:\n"
+      "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+      "${CONTENT}\n")
+  endif()
+endfunction()
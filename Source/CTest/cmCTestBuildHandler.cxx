@@ -180,10 +180,11 @@ void cmCTestBuildHandler::Initialize()
   this->ReallyCustomWarningExceptions.clear();
   this->ErrorWarningFileLineRegex.clear();
 
-  this->ErrorMatchRegex.clear();
-  this->ErrorExceptionRegex.clear();
-  this->WarningMatchRegex.clear();
-  this->WarningExceptionRegex.clear();
+  this->BuildOutputRegex.Clear();
+  this->ErrorMatchRegex = 0;
+  this->ErrorExceptionRegex = 0;
+  this->WarningMatchRegex = 0;
+  this->WarningExceptionRegex = 0;
   this->BuildProcessingQueue.clear();
   this->BuildProcessingErrorQueue.clear();
   this->BuildOutputLogSize = 0;
@@ -352,24 +353,29 @@ int cmCTestBuildHandler::ProcessHandler()
   // Pre-compile regular expressions objects for all regular expressions
   std::vector<std::string>::iterator it;
 
-#define cmCTestBuildHandlerPopulateRegexVector(strings, regexes)              \
-  regexes.clear();                                                            \
+#define cmCTestBuildHandlerAddRegexes(strings, regexes)                       \
+  regexes = this->BuildOutputRegex.GetNumberOfPatterns();                     \
   cmCTestOptionalLog(this->CTest, DEBUG,                                      \
                      this << "Add " #regexes << std::endl, this->Quiet);      \
   for (it = (strings).begin(); it != (strings).end(); ++it) {                 \
     cmCTestOptionalLog(this->CTest, DEBUG,                                    \
                        "Add " #strings ": " << *it << std::endl,              \
                        this->Quiet);                                          \
-    (regexes).push_back(it->c_str());                                         \
+    if (!this->BuildOutputRegex.Add(*it)) {                                   \
+      cmCTestLog(this->CTest, ERROR_MESSAGE,                                  \
+                 "Problem Compiling regular expression: " << *it             \
+                                                          << std::endl);      \
+    }                                                                         \
   }
-  cmCTestBuildHandlerPopulateRegexVector(this->CustomErrorMatches,
-                                         this->ErrorMatchRegex);
-  cmCTestBuildHandlerPopulateRegexVector(this->CustomErrorExceptions,
-                                         this->ErrorExceptionRegex);
-  cmCTestBuildHandlerPopulateRegexVector(this->CustomWarningMatches,
-                                         this->WarningMatchRegex);
-  cmCTestBuildHandlerPopulateRegexVector(this->CustomWarningExceptions,
-                                         this->WarningExceptionRegex);
+  this->BuildOutputRegex.Clear();
+  cmCTestBuildHandlerAddRegexes(this->CustomErrorMatches,
+                                this->ErrorMatchRegex);
+  cmCTestBuildHandlerAddRegexes(this->CustomErrorExceptions,
+                                this->ErrorExceptionRegex);
+  cmCTestBuildHandlerAddRegexes(this->CustomWarningMatches,
+                                this->WarningMatchRegex);
+  cmCTestBuildHandlerAddRegexes(this->CustomWarningExceptions,
+                                this->WarningExceptionRegex);
 
   // Determine source and binary tree substitutions to simplify the output.
   this->SimplifySourceDir = "";
@@ -1066,76 +1072,67 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
   cmCTestOptionalLog(this->CTest, DEBUG, "Line: [" << data << "]" << std::endl,
                      this->Quiet);
 
-  std::vector<cmsys::RegularExpression>::iterator it;
-
   int warningLine = 0;
   int errorLine = 0;
 
   // Check for regular expressions
+  if (this->ErrorQuotaReached && this->WarningQuotaReached) {
+    return b_REGULAR_LINE;
+  }
+  this->BuildOutputRegex.Find(data);
+  size_t const regexEnd = this->BuildOutputRegex.GetNumberOfPatterns();
 
   if (!this->ErrorQuotaReached) {
     // Errors
-    int wrxCnt = 0;
-    for (it = this->ErrorMatchRegex.begin(); it != this->ErrorMatchRegex.end();
-         ++it) {
-      if (it->find(data)) {
-        errorLine = 1;
-        cmCTestOptionalLog(this->CTest, DEBUG,
-                           "  Error Line: " << data << " (matches: "
-                                            << this->CustomErrorMatches[wrxCnt]
-                                            << ")" << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
+    size_t match = this->BuildOutputRegex.FirstMatch(
+      this->ErrorMatchRegex, this->ErrorExceptionRegex);
+    if (match != this->ErrorExceptionRegex) {
+      errorLine = 1;
+      cmCTestOptionalLog(
+        this->CTest, DEBUG, "  Error Line: "
+          << data << " (matches: "
+          << this->CustomErrorMatches[match - this->ErrorMatchRegex] << ")"
+          << std::endl,
+        this->Quiet);
     }
     // Error exceptions
-    wrxCnt = 0;
-    for (it = this->ErrorExceptionRegex.begin();
-         it != this->ErrorExceptionRegex.end(); ++it) {
-      if (it->find(data)) {
-        errorLine = 0;
-        cmCTestOptionalLog(this->CTest, DEBUG, "  Not an error Line: "
-                             << data << " (matches: "
-                             << this->CustomErrorExceptions[wrxCnt] << ")"
-                             << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
+    match = this->BuildOutputRegex.FirstMatch(this->ErrorExceptionRegex,
+                                              this->WarningMatchRegex);
+    if (match != this->WarningMatchRegex) {
+      errorLine = 0;
+      cmCTestOptionalLog(
+        this->CTest, DEBUG, "  Not an error Line: "
+          << data << " (matches: "
+          << this->CustomErrorExceptions[match - this->ErrorExceptionRegex]
+          << ")" << std::endl,
+        this->Quiet);
     }
   }
   if (!this->WarningQuotaReached) {
     // Warnings
-    int wrxCnt = 0;
-    for (it = this->WarningMatchRegex.begin();
-         it != this->WarningMatchRegex.end(); ++it) {
-      if (it->find(data)) {
-        warningLine = 1;
-        cmCTestOptionalLog(this->CTest, DEBUG, "  Warning Line: "
-                             << data << " (matches: "
-                             << this->CustomWarningMatches[wrxCnt] << ")"
-                             << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
+    size_t match = this->BuildOutputRegex.FirstMatch(
+      this->WarningMatchRegex, this->WarningExceptionRegex);
+    if (match != this->WarningExceptionRegex) {
+      warningLine = 1;
+      cmCTestOptionalLog(
+        this->CTest, DEBUG, "  Warning Line: "
+          << data << " (matches: "
+          << this->CustomWarningMatches[match - this->WarningMatchRegex]
+          << ")" << std::endl,
+        this->Quiet);
     }
 
-    wrxCnt = 0;
     // Warning exceptions
-    for (it = this->WarningExceptionRegex.begin();
-         it != this->WarningExceptionRegex.end(); ++it) {
-      if (it->find(data)) {
-        warningLine = 0;
-        cmCTestOptionalLog(this->CTest, DEBUG, "  Not a warning Line: "
-                             << data << " (matches: "
-                             << this->CustomWarningExceptions[wrxCnt] << ")"
-                             << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
+    match = this->BuildOutputRegex.FirstMatch(this->WarningExceptionRegex,
+                                              regexEnd);
+    if (match != regexEnd) {
+      warningLine = 0;
+      cmCTestOptionalLog(
+        this->CTest, DEBUG, "  Not a warning Line: "
+          << data << " (matches: "
+          << this->CustomWarningExceptions[match - this->WarningExceptionRegex]
+          << ")" << std::endl,
+        this->Quiet);
     }
   }
   if (errorLine) {
@@ -6,6 +6,7 @@
 #include <cmConfigure.h>
 
 #include "cmCTestGenericHandler.h"
+#include "cmLinearRegularExpressionSet.h"
 
 #include <cmsys/RegularExpression.hxx>
 #include <deque>
@@ -100,10 +101,13 @@ private:
   std::vector<std::string> ReallyCustomWarningExceptions;
   std::vector<cmCTestCompileErrorWarningRex> ErrorWarningFileLineRegex;
 
-  std::vector<cmsys::RegularExpression> ErrorMatchRegex;
-  std::vector<cmsys::RegularExpression> ErrorExceptionRegex;
-  std::vector<cmsys::RegularExpression> WarningMatchRegex;
-  std::vector<cmsys::RegularExpression> WarningExceptionRegex;
+  // The error matches, error exceptions, warning matches and warning
+  // exceptions in this order, checked against each line all at once.
+  cmLinearRegularExpressionSet BuildOutputRegex;
+  size_t ErrorMatchRegex;
+  size_t ErrorExceptionRegex;
+  size_t WarningMatchRegex;
+  size_t WarningExceptionRegex;
 
   typedef std::deque<char> t_BuildProcessingQueueType;
 
@@ -40,6 +40,25 @@ private:
   cmCTestMultiProcessHandler* Handler;
 };
 
+class CriticalPathComparator
+{
+public:
+  CriticalPathComparator(std::map<int, float> const& priorities)
+    : Priorities(priorities)
+  {
+  }
+
+  // Sorts tests in descending order of priority
+  bool operator()(int index1, int index2) const
+  {
+    return this->Priorities.find(index1)->second >
+      this->Priorities.find(index2)->second;
+  }
+
+private:
+  std::map<int, float> const& Priorities;
+};
+
 cmCTestMultiProcessHandler::cmCTestMultiProcessHandler()
 {
   this->ParallelLevel = 1;
@@ -49,6 +68,7 @@ cmCTestMultiProcessHandler::cmCTestMultiProcessHandler()
   this->StopTimePassed = false;
   this->HasCycles = false;
   this->SerialTestRunning = false;
+  this->CriticalPathSchedule = false;
 }
 
 cmCTestMultiProcessHandler::~cmCTestMultiProcessHandler()
@@ -67,6 +87,14 @@ void cmCTestMultiProcessHandler::SetTests(TestMap& tests,
        ++i) {
     this->TestRunningMap[i->first] = false;
     this->TestFinishMap[i->first] = false;
+    for (TestSet::const_iterator j = i->second.begin(); j != i->second.end();
+         ++j) {
+      this->Dependents[*j].insert(i->first);
+    }
+  }
+  for (PropertiesMap::iterator i = this->Properties.begin();
+       i != this->Properties.end(); ++i) {
+    this->TestIndexes[i->second->Name] = i->first;
   }
   if (!this->CTest->GetShowOnly()) {
     this->ReadCostData();
@@ -75,6 +103,7 @@ void cmCTestMultiProcessHandler::SetTests(TestMap& tests,
       return;
     }
     this->CreateTestCostList();
+    this->CreateReadyTests();
   }
 }
 
@@ -96,6 +125,22 @@ void cmCTestMultiProcessHandler::RunTests()
     return;
   }
   this->TestHandler->SetMaxIndex(this->FindMaxIndex());
+#ifdef CMAKE_USE_LIBUV
+  // Tests are started from here and then each time one finishes.  The
+  // loop returns once no test is running and none is left to start.
+  uv_loop_init(&this->Loop);
+  uv_timer_init(&this->Loop, &this->StartNextTestsTimer);
+  this->StartNextTestsTimer.data = this;
+  this->StartNextTests();
+  uv_run(&this->Loop, UV_RUN_DEFAULT);
+  uv_close(reinterpret_cast<uv_handle_t*>(&this->StartNextTestsTimer),
+           CM_NULLPTR);
+  uv_run(&this->Loop, UV_RUN_DEFAULT);
+  uv_loop_close(&this->Loop);
+  if (this->StopTimePassed) {
+    return;
+  }
+#else
   this->StartNextTests();
   while (!this->Tests.empty()) {
     if (this->StopTimePassed) {
@@ -107,6 +152,7 @@ void cmCTestMultiProcessHandler::RunTests()
   // let all running tests finish
   while (this->CheckOutput()) {
   }
+#endif
   this->MarkFinished();
   this->UpdateCostData();
 }
@@ -120,7 +166,7 @@ void cmCTestMultiProcessHandler::StartTestProcess(int test)
   this->EraseTest(test);
   this->RunningCount += GetProcessorsUsed(test);
 
-  cmCTestRunTest* testRun = new cmCTestRunTest(this->TestHandler);
+  cmCTestRunTest* testRun = new cmCTestRunTest(*this);
   if (this->CTest->GetRepeatUntilFail()) {
     testRun->SetRunUntilFailOn();
     testRun->SetNumberOfRuns(this->CTest->GetTestRepeat());
@@ -129,12 +175,16 @@ void cmCTestMultiProcessHandler::StartTestProcess(int test)
   testRun->SetTestProperties(this->Properties[test]);
 
   // Find any failed dependencies for this test. We assume the more common
-  // scenario has no failed tests, so make it the outer loop.
-  for (std::vector<std::string>::const_iterator it = this->Failed->begin();
-       it != this->Failed->end(); ++it) {
-    if (this->Properties[test]->RequireSuccessDepends.find(*it) !=
-        this->Properties[test]->RequireSuccessDepends.end()) {
-      testRun->AddFailedDependency(*it);
+  // scenario has no failed tests, so make it the outer loop.  Most tests
+  // require no other tests to pass, so skip the loop for them.
+  std::set<std::string> const& requireSuccess =
+    this->Properties[test]->RequireSuccessDepends;
+  if (!requireSuccess.empty()) {
+    for (std::vector<std::string>::const_iterator it = this->Failed->begin();
+         it != this->Failed->end(); ++it) {
+      if (requireSuccess.find(*it) != requireSuccess.end()) {
+        testRun->AddFailedDependency(*it);
+      }
     }
   }
 
@@ -149,14 +199,19 @@ void cmCTestMultiProcessHandler::StartTestProcess(int test)
   } else if (testRun->IsStopTimePassed()) {
     this->StopTimePassed = true;
     delete testRun;
+#ifdef CMAKE_USE_LIBUV
+    // Stop the tests still running too.  Their results are dropped as
+    // they finish, as if they never ran, and then the loop returns.
+    for (std::set<cmCTestRunTest*>::const_iterator i =
+           this->RunningTests.begin();
+         i != this->RunningTests.end(); ++i) {
+      (*i)->KillTest();
+    }
+#endif
     return;
   } else {
 
-    for (TestMap::iterator j = this->Tests.begin(); j != this->Tests.end();
-         ++j) {
-      j->second.erase(test);
-    }
-
+    this->ReleaseDependents(test);
     this->UnlockResources(test);
     this->Completed++;
     this->TestFinishMap[test] = true;
@@ -195,8 +250,38 @@ void cmCTestMultiProcessHandler::UnlockResources(int index)
 void cmCTestMultiProcessHandler::EraseTest(int test)
 {
   this->Tests.erase(test);
-  this->SortedTests.erase(
-    std::find(this->SortedTests.begin(), this->SortedTests.end(), test));
+  std::map<int, size_t>::const_iterator position =
+    this->SortedTestPositions.find(test);
+  if (position != this->SortedTestPositions.end()) {
+    this->ReadyTests.erase(position->second);
+  }
+}
+
+void cmCTestMultiProcessHandler::ReleaseDependents(int test)
+{
+  TestMap::const_iterator dependents = this->Dependents.find(test);
+  if (dependents == this->Dependents.end()) {
+    return;
+  }
+  for (TestSet::const_iterator i = dependents->second.begin();
+       i != dependents->second.end(); ++i) {
+    TestMap::iterator dependent = this->Tests.find(*i);
+    if (dependent != this->Tests.end() && dependent->second.erase(test) &&
+        dependent->second.empty()) {
+      this->ReadyTests[this->SortedTestPositions[*i]] = *i;
+    }
+  }
+}
+
+void cmCTestMultiProcessHandler::CreateReadyTests()
+{
+  for (size_t i = 0; i < this->SortedTests.size(); ++i) {
+    int test = this->SortedTests[i];
+    this->SortedTestPositions[test] = i;
+    if (this->Tests[test].empty()) {
+      this->ReadyTests[i] = test;
+    }
+  }
 }
 
 inline size_t cmCTestMultiProcessHandler::GetProcessorsUsed(int test)
@@ -290,23 +375,26 @@ void cmCTestMultiProcessHandler::StartNextTests()
     }
   }
 
-  TestList copy = this->SortedTests;
-  for (TestList::iterator test = copy.begin(); test != copy.end(); ++test) {
+  // Starting a test removes it from the ready tests and may add others.
+  std::map<size_t, int>::const_iterator next = this->ReadyTests.begin();
+  while (next != this->ReadyTests.end()) {
+    int test = next->second;
+    ++next;
     // Take a nap if we're currently performing a RUN_SERIAL test.
     if (this->SerialTestRunning) {
       break;
     }
     // We can only start a RUN_SERIAL test if no other tests are also running.
-    if (this->Properties[*test]->RunSerial && this->RunningCount > 0) {
+    if (this->Properties[test]->RunSerial && this->RunningCount > 0) {
       continue;
     }
 
-    size_t processors = GetProcessorsUsed(*test);
+    size_t processors = GetProcessorsUsed(test);
     bool testLoadOk = true;
     if (this->TestLoad > 0) {
       if (processors <= spareLoad) {
         cmCTestLog(this->CTest, DEBUG, "OK to run "
-                     << GetName(*test) << ", it requires " << processors
+                     << GetName(test) << ", it requires " << processors
                      << " procs & system load is: " << systemLoad
                      << std::endl);
         allTestsFailedTestLoadCheck = false;
@@ -317,10 +405,10 @@ void cmCTestMultiProcessHandler::StartNextTests()
 
     if (processors <= minProcessorsRequired) {
       minProcessorsRequired = processors;
-      testWithMinProcessors = GetName(*test);
+      testWithMinProcessors = GetName(test);
     }
 
-    if (testLoadOk && processors <= numToStart && this->StartTest(*test)) {
+    if (testLoadOk && processors <= numToStart && this->StartTest(test)) {
       if (this->StopTimePassed) {
         return;
       }
@@ -353,12 +441,44 @@ void cmCTestMultiProcessHandler::StartNextTests()
       this->StopTimePassed = true;
     } else {
       // Wait between 1 and 5 seconds before trying again.
+#ifdef CMAKE_USE_LIBUV
+      this->StartNextTestsOnTimer((cmSystemTools::RandomSeed() % 5 + 1) *
+                                  1000);
+#else
       cmCTestScriptHandler::SleepInSeconds(cmSystemTools::RandomSeed() % 5 +
                                            1);
+#endif
     }
   }
+#ifdef CMAKE_USE_LIBUV
+  else if (this->RunningTests.empty() && !this->Tests.empty() &&
+           !this->StopTimePassed) {
+    // Nothing is running that could finish and wake the loop up again.
+    this->StartNextTestsOnTimer(0);
+  }
+#endif
+}
+
+#ifdef CMAKE_USE_LIBUV
+void cmCTestMultiProcessHandler::StartNextTestsOnTimer(
+  unsigned int milliseconds)
+{
+  uv_timer_start(&this->StartNextTestsTimer,
+                 &cmCTestMultiProcessHandler::OnStartNextTestsTimer,
+                 milliseconds, 0);
 }
 
+void cmCTestMultiProcessHandler::OnStartNextTestsTimer(uv_timer_t* timer)
+{
+  cmCTestMultiProcessHandler* self =
+    static_cast<cmCTestMultiProcessHandler*>(timer->data);
+  if (!self->StopTimePassed) {
+    self->StartNextTests();
+  }
+}
+#endif
+
+#ifndef CMAKE_USE_LIBUV
 bool cmCTestMultiProcessHandler::CheckOutput()
 {
   // no more output we are done
@@ -377,34 +497,49 @@ bool cmCTestMultiProcessHandler::CheckOutput()
   }
   for (std::vector<cmCTestRunTest*>::iterator i = finished.begin();
        i != finished.end(); ++i) {
-    this->Completed++;
-    cmCTestRunTest* p = *i;
-    int test = p->GetIndex();
-
-    bool testResult = p->EndTest(this->Completed, this->Total, true);
-    if (p->StartAgain()) {
-      this->Completed--; // remove the completed test because run again
-      continue;
-    }
-    if (testResult) {
-      this->Passed->push_back(p->GetTestProperties()->Name);
-    } else {
-      this->Failed->push_back(p->GetTestProperties()->Name);
-    }
-    for (TestMap::iterator j = this->Tests.begin(); j != this->Tests.end();
-         ++j) {
-      j->second.erase(test);
-    }
-    this->TestFinishMap[test] = true;
-    this->TestRunningMap[test] = false;
-    this->RunningTests.erase(p);
-    this->WriteCheckpoint(test);
-    this->UnlockResources(test);
-    this->RunningCount -= GetProcessorsUsed(test);
-    delete p;
+    this->FinishTestProcess(*i);
   }
   return true;
 }
+#endif
+
+void cmCTestMultiProcessHandler::FinishTestProcess(cmCTestRunTest* runner)
+{
+#ifdef CMAKE_USE_LIBUV
+  if (this->StopTimePassed) {
+    this->RunningTests.erase(runner);
+    delete runner;
+    return;
+  }
+#endif
+  this->Completed++;
+  int test = runner->GetIndex();
+
+  bool testResult = runner->EndTest(this->Completed, this->Total, true);
+  if (runner->StartAgain()) {
+    this->Completed--; // remove the completed test because run again
+    return;
+  }
+  if (testResult) {
+    this->Passed->push_back(runner->GetTestProperties()->Name);
+  } else {
+    this->Failed->push_back(runner->GetTestProperties()->Name);
+  }
+  this->ReleaseDependents(test);
+  this->TestFinishMap[test] = true;
+  this->TestRunningMap[test] = false;
+  this->RunningTests.erase(runner);
+  this->WriteCheckpoint(test);
+  this->UnlockResources(test);
+  this->RunningCount -= GetProcessorsUsed(test);
+  delete runner;
+
+#ifdef CMAKE_USE_LIBUV
+  if (!this->StopTimePassed && !this->Tests.empty()) {
+    this->StartNextTests();
+  }
+#endif
+}
 
 void cmCTestMultiProcessHandler::UpdateCostData()
 {
@@ -514,20 +649,15 @@ void cmCTestMultiProcessHandler::ReadCostData()
 
 int cmCTestMultiProcessHandler::SearchByName(std::string const& name)
 {
-  int index = -1;
-
-  for (PropertiesMap::iterator i = this->Properties.begin();
-       i != this->Properties.end(); ++i) {
-    if (i->second->Name == name) {
-      index = i->first;
-    }
-  }
-  return index;
+  std::map<std::string, int>::const_iterator i = this->TestIndexes.find(name);
+  return i != this->TestIndexes.end() ? i->second : -1;
 }
 
 void cmCTestMultiProcessHandler::CreateTestCostList()
 {
-  if (this->ParallelLevel > 1) {
+  if (this->ParallelLevel > 1 && this->CriticalPathSchedule) {
+    CreateCriticalPathTestCostList();
+  } else if (this->ParallelLevel > 1) {
     CreateParallelTestCostList();
   } else {
     CreateSerialTestCostList();
@@ -603,6 +733,100 @@ void cmCTestMultiProcessHandler::CreateParallelTestCostList()
   }
 }
 
+void cmCTestMultiProcessHandler::CreateCriticalPathTestCostList()
+{
+  // Tests without cost data are assumed to take the average time of
+  // those with it so that long chains of them still count.
+  float knownCost = 0;
+  size_t knownCount = 0;
+  for (TestMap::const_iterator i = this->Tests.begin(); i != this->Tests.end();
+       ++i) {
+    float cost = this->Properties[i->first]->Cost;
+    if (cost > 0) {
+      knownCost += cost;
+      ++knownCount;
+    }
+  }
+  float defaultCost =
+    knownCount > 0 ? knownCost / static_cast<float>(knownCount) : 1;
+  std::map<int, float> costs;
+  for (TestMap::const_iterator i = this->Tests.begin(); i != this->Tests.end();
+       ++i) {
+    float cost = this->Properties[i->first]->Cost;
+    costs[i->first] = cost > 0 ? cost : defaultCost;
+  }
+
+  // Count the tests depending on each test.  A test's priority is its
+  // own cost plus the highest priority among the tests depending on it,
+  // i.e. the length of the longest chain of tests it holds up.  Visit
+  // the tests once all of their dependents are done.
+  std::map<int, size_t> dependents;
+  for (TestMap::const_iterator i = this->Tests.begin(); i != this->Tests.end();
+       ++i) {
+    dependents.insert(std::make_pair(i->first, 0));
+  }
+  for (TestMap::const_iterator i = this->Tests.begin(); i != this->Tests.end();
+       ++i) {
+    for (TestSet::const_iterator j = i->second.begin(); j != i->second.end();
+         ++j) {
+      std::map<int, size_t>::iterator d = dependents.find(*j);
+      if (d != dependents.end()) {
+        ++d->second;
+      }
+    }
+  }
+
+  std::map<int, float> chain;
+  std::map<int, float> priorities;
+  TestList ready;
+  for (std::map<int, size_t>::const_iterator i = dependents.begin();
+       i != dependents.end(); ++i) {
+    if (i->second == 0) {
+      ready.push_back(i->first);
+    }
+  }
+  while (!ready.empty()) {
+    int test = ready.back();
+    ready.pop_back();
+    float priority = chain[test] + costs[test];
+    priorities[test] = priority;
+
+    TestSet const& dependencies = this->Tests[test];
+    for (TestSet::const_iterator j = dependencies.begin();
+         j != dependencies.end(); ++j) {
+      std::map<int, size_t>::iterator d = dependents.find(*j);
+      if (d == dependents.end()) {
+        continue;
+      }
+      float& longest = chain[*j];
+      if (priority > longest) {
+        longest = priority;
+      }
+      if (--d->second == 0) {
+        ready.push_back(*j);
+      }
+    }
+  }
+
+  // Tests that failed last time still run first.
+  TestList presortedList;
+  for (TestMap::const_iterator i = this->Tests.begin(); i != this->Tests.end();
+       ++i) {
+    if (std::find(this->LastTestsFailed.begin(), this->LastTestsFailed.end(),
+                  this->Properties[i->first]->Name) !=
+        this->LastTestsFailed.end()) {
+      this->SortedTests.push_back(i->first);
+    } else {
+      presortedList.push_back(i->first);
+    }
+  }
+
+  CriticalPathComparator comp(priorities);
+  std::stable_sort(presortedList.begin(), presortedList.end(), comp);
+  this->SortedTests.insert(this->SortedTests.end(), presortedList.begin(),
+                           presortedList.end());
+}
+
 void cmCTestMultiProcessHandler::GetAllTestDependencies(int test,
                                                         TestList& dependencies)
 {
@@ -687,7 +911,7 @@ void cmCTestMultiProcessHandler::PrintTestList()
     std::string current_dir = cmSystemTools::GetCurrentWorkingDirectory();
     cmSystemTools::ChangeDirectory(p.Directory);
 
-    cmCTestRunTest testRun(this->TestHandler);
+    cmCTestRunTest testRun(*this);
     testRun.SetIndex(p.Index);
     testRun.SetTestProperties(&p);
     testRun.ComputeArguments(); // logs the command in verbose mode
@@ -784,7 +1008,16 @@ void cmCTestMultiProcessHandler::CheckResume()
 void cmCTestMultiProcessHandler::RemoveTest(int index)
 {
   this->EraseTest(index);
-  this->Properties.erase(index);
+  this->ReleaseDependents(index);
+  PropertiesMap::iterator properties = this->Properties.find(index);
+  if (properties != this->Properties.end()) {
+    std::map<std::string, int>::iterator name =
+      this->TestIndexes.find(properties->second->Name);
+    if (name != this->TestIndexes.end() && name->second == index) {
+      this->TestIndexes.erase(name);
+    }
+    this->Properties.erase(properties);
+  }
   this->TestRunningMap[index] = false;
   this->TestFinishMap[index] = true;
   this->Completed++;
@@ -808,6 +1041,38 @@ bool cmCTestMultiProcessHandler::CheckCycles()
   cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                      "Checking test dependency graph..." << std::endl,
                      this->Quiet);
+
+  // Repeatedly take away tests with no dependencies left.  Only if this
+  // gets stuck is there a cycle, so search for it only in that case.
+  std::map<int, size_t> pending;
+  TestList ready;
+  for (TestMap::const_iterator it = this->Tests.begin();
+       it != this->Tests.end(); ++it) {
+    pending[it->first] = it->second.size();
+    if (it->second.empty()) {
+      ready.push_back(it->first);
+    }
+  }
+  size_t taken = 0;
+  while (!ready.empty()) {
+    int test = ready.back();
+    ready.pop_back();
+    ++taken;
+    TestSet const& dependents = this->Dependents[test];
+    for (TestSet::const_iterator d = dependents.begin(); d != dependents.end();
+         ++d) {
+      if (--pending[*d] == 0) {
+        ready.push_back(*d);
+      }
+    }
+  }
+  if (taken == this->Tests.size()) {
+    cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                       "Checking test dependency graph end" << std::endl,
+                       this->Quiet);
+    return true;
+  }
+
   for (TestMap::iterator it = this->Tests.begin(); it != this->Tests.end();
        ++it) {
     // DFS from each element to itself
@@ -12,6 +12,10 @@
 #include <string>
 #include <vector>
 
+#ifdef CMAKE_USE_LIBUV
+#include "cm_uv.h"
+#endif
+
 class cmCTest;
 class cmCTestRunTest;
 
@@ -23,6 +27,7 @@ class cmCTestRunTest;
 class cmCTestMultiProcessHandler
 {
   friend class TestComparator;
+  friend class cmCTestRunTest;
 
 public:
   struct TestSet : public std::set<int>
@@ -71,6 +76,13 @@ public:
   cmCTestTestHandler* GetTestHandler() { return this->TestHandler; }
 
   void SetQuiet(bool b) { this->Quiet = b; }
+
+  // Order tests by the longest path of historical cost they start.
+  void SetCriticalPathSchedule(bool b) { this->CriticalPathSchedule = b; }
+
+  // Record the end of a test run and start the tests it unblocked.
+  void FinishTestProcess(cmCTestRunTest* runner);
+
 protected:
   // Start the next test or tests as many as are allowed by
   // ParallelLevel
@@ -92,12 +104,24 @@ protected:
 
   void CreateParallelTestCostList();
 
+  void CreateCriticalPathTestCostList();
+
   // Removes the checkpoint file
   void MarkFinished();
   void EraseTest(int index);
+  // Make the tests depending on the given one ready once it was the
+  // last dependency they waited for
+  void ReleaseDependents(int index);
+  void CreateReadyTests();
+#ifdef CMAKE_USE_LIBUV
+  // Call StartNextTests from the event loop after a delay.
+  void StartNextTestsOnTimer(unsigned int milliseconds);
+  static void OnStartNextTestsTimer(uv_timer_t* timer);
+#else
   // Return true if there are still tests running
   // check all running processes for output and exit case
   bool CheckOutput();
+#endif
   void RemoveTest(int index);
   // Check if we need to resume an interrupted test set
   void CheckResume();
@@ -111,7 +135,13 @@ protected:
   void UnlockResources(int index);
   // map from test number to set of depend tests
   TestMap Tests;
+  // map from test number to set of tests depending on it
+  TestMap Dependents;
   TestList SortedTests;
+  // tests with no dependency left to run by position in SortedTests
+  std::map<size_t, int> ReadyTests;
+  std::map<int, size_t> SortedTestPositions;
+  std::map<std::string, int> TestIndexes;
   // Total number of tests we'll be running
   size_t Total;
   // Number of tests that are complete
@@ -136,6 +166,12 @@ protected:
   bool HasCycles;
   bool Quiet;
   bool SerialTestRunning;
+  bool CriticalPathSchedule;
+#ifdef CMAKE_USE_LIBUV
+  // The loop waiting on all test processes at once
+  uv_loop_t Loop;
+  uv_timer_t StartNextTestsTimer;
+#endif
 };
 
 #endif
@@ -4,6 +4,7 @@
 
 #include "cmCTest.h"
 #include "cmCTestMemCheckHandler.h"
+#include "cmCTestMultiProcessHandler.h"
 #include "cmCTestTestHandler.h"
 #include "cmProcess.h"
 #include "cmSystemTools.h"
@@ -20,10 +21,11 @@
 #include <time.h>
 #include <utility>
 
-cmCTestRunTest::cmCTestRunTest(cmCTestTestHandler* handler)
+cmCTestRunTest::cmCTestRunTest(cmCTestMultiProcessHandler& multiHandler)
+  : MultiTestHandler(multiHandler)
 {
-  this->CTest = handler->CTest;
-  this->TestHandler = handler;
+  this->TestHandler = multiHandler.GetTestHandler();
+  this->CTest = this->TestHandler->CTest;
   this->TestProcess = CM_NULLPTR;
   this->TestResult.ExecutionTime = 0;
   this->TestResult.ReturnValue = 0;
@@ -43,6 +45,7 @@ cmCTestRunTest::~cmCTestRunTest()
 {
 }
 
+#ifndef CMAKE_USE_LIBUV
 bool cmCTestRunTest::CheckOutput()
 {
   // Read lines for up to 0.1 seconds of total time.
@@ -56,39 +59,54 @@ bool cmCTestRunTest::CheckOutput()
       return false;
     }
     if (p == cmsysProcess_Pipe_STDOUT) {
-      // Store this line of output.
-      cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->GetIndex()
-                   << ": " << line << std::endl);
-      this->ProcessOutput += line;
-      this->ProcessOutput += "\n";
-
-      // Check for TIMEOUT_AFTER_MATCH property.
-      if (!this->TestProperties->TimeoutRegularExpressions.empty()) {
-        std::vector<
-          std::pair<cmsys::RegularExpression, std::string> >::iterator regIt;
-        for (regIt = this->TestProperties->TimeoutRegularExpressions.begin();
-             regIt != this->TestProperties->TimeoutRegularExpressions.end();
-             ++regIt) {
-          if (regIt->first.find(this->ProcessOutput.c_str())) {
-            cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->GetIndex()
-                         << ": "
-                         << "Test timeout changed to "
-                         << this->TestProperties->AlternateTimeout
-                         << std::endl);
-            this->TestProcess->ResetStartTime();
-            this->TestProcess->ChangeTimeout(
-              this->TestProperties->AlternateTimeout);
-            this->TestProperties->TimeoutRegularExpressions.clear();
-            break;
-          }
-        }
-      }
+      this->CheckOutput(line);
     } else { // if(p == cmsysProcess_Pipe_Timeout)
       break;
     }
   }
   return true;
 }
+#else
+void cmCTestRunTest::FinalizeTest()
+{
+  this->MultiTestHandler.FinishTestProcess(this);
+}
+
+void cmCTestRunTest::KillTest()
+{
+  this->TestProcess->Kill();
+}
+#endif
+
+void cmCTestRunTest::CheckOutput(std::string const& line)
+{
+  // Store this line of output.
+  cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->GetIndex()
+               << ": " << line << std::endl);
+  this->ProcessOutput += line;
+  this->ProcessOutput += "\n";
+
+  // Check for TIMEOUT_AFTER_MATCH property.
+  if (!this->TestProperties->TimeoutRegularExpressions.empty()) {
+    std::vector<std::pair<cmsys::RegularExpression, std::string> >::iterator
+      regIt;
+    for (regIt = this->TestProperties->TimeoutRegularExpressions.begin();
+         regIt != this->TestProperties->TimeoutRegularExpressions.end();
+         ++regIt) {
+      if (regIt->first.find(this->ProcessOutput.c_str())) {
+        cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->GetIndex()
+                     << ": "
+                     << "Test timeout changed to "
+                     << this->TestProperties->AlternateTimeout << std::endl);
+        this->TestProcess->ResetStartTime();
+        this->TestProcess->ChangeTimeout(
+          this->TestProperties->AlternateTimeout);
+        this->TestProperties->TimeoutRegularExpressions.clear();
+        break;
+      }
+    }
+  }
+}
 
 // Streamed compression of test output.  The compressed data
 // is appended to this->CompressedOutput
@@ -686,7 +704,11 @@ bool cmCTestRunTest::ForkProcess(double testTimeOut, bool explicitTimeout,
     cmSystemTools::AppendEnv(*environment);
   }
 
+#ifdef CMAKE_USE_LIBUV
+  return this->TestProcess->StartProcess(this->MultiTestHandler.Loop, this);
+#else
   return this->TestProcess->StartProcess();
+#endif
 }
 
 void cmCTestRunTest::WriteLogOutputTop(size_t completed, size_t total)
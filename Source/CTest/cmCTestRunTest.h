@@ -11,6 +11,7 @@
 #include <vector>
 
 class cmCTest;
+class cmCTestMultiProcessHandler;
 class cmProcess;
 
 /** \class cmRunTest
@@ -21,7 +22,7 @@ class cmProcess;
 class cmCTestRunTest
 {
 public:
-  cmCTestRunTest(cmCTestTestHandler* handler);
+  cmCTestRunTest(cmCTestMultiProcessHandler& multiHandler);
   ~cmCTestRunTest();
 
   void SetNumberOfRuns(int n) { this->NumberOfRunsLeft = n; }
@@ -54,8 +55,20 @@ public:
     return this->TestResult;
   }
 
+#ifndef CMAKE_USE_LIBUV
   // Read and store output.  Returns true if it must be called again.
   bool CheckOutput();
+#endif
+
+  // Store a line of output.
+  void CheckOutput(std::string const& line);
+
+#ifdef CMAKE_USE_LIBUV
+  // Called by the test process once it exited and its output was read.
+  void FinalizeTest();
+  // Kill the test process.  FinalizeTest is still called once it exited.
+  void KillTest();
+#endif
 
   // Compresses the output, writing to CompressedOutput
   void CompressOutput();
@@ -84,6 +97,8 @@ private:
   void MemCheckPostProcess();
 
   cmCTestTestHandler::cmCTestTestProperties* TestProperties;
+  // The handler scheduling this test run
+  cmCTestMultiProcessHandler& MultiTestHandler;
   // Pointer back to the "parent"; the handler that invoked this test run
   cmCTestTestHandler* TestHandler;
   cmCTest* CTest;
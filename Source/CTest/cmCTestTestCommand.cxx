@@ -22,6 +22,7 @@ cmCTestTestCommand::cmCTestTestCommand()
   this->Arguments[ctt_INCLUDE_LABEL] = "INCLUDE_LABEL";
   this->Arguments[ctt_PARALLEL_LEVEL] = "PARALLEL_LEVEL";
   this->Arguments[ctt_SCHEDULE_RANDOM] = "SCHEDULE_RANDOM";
+  this->Arguments[ctt_SCHEDULE_CRITICAL_PATH] = "SCHEDULE_CRITICAL_PATH";
   this->Arguments[ctt_STOP_TIME] = "STOP_TIME";
   this->Arguments[ctt_TEST_LOAD] = "TEST_LOAD";
   this->Arguments[ctt_LAST] = CM_NULLPTR;
@@ -81,6 +82,10 @@ cmCTestGenericHandler* cmCTestTestCommand::InitializeHandler()
   if (this->Values[ctt_SCHEDULE_RANDOM]) {
     handler->SetOption("ScheduleRandom", this->Values[ctt_SCHEDULE_RANDOM]);
   }
+  if (this->Values[ctt_SCHEDULE_CRITICAL_PATH]) {
+    handler->SetOption("ScheduleCriticalPath",
+                       this->Values[ctt_SCHEDULE_CRITICAL_PATH]);
+  }
   if (this->Values[ctt_STOP_TIME]) {
     this->CTest->SetStopTime(this->Values[ctt_STOP_TIME]);
   }
@@ -55,6 +55,7 @@ protected:
     ctt_INCLUDE_LABEL,
     ctt_PARALLEL_LEVEL,
     ctt_SCHEDULE_RANDOM,
+    ctt_SCHEDULE_CRITICAL_PATH,
     ctt_STOP_TIME,
     ctt_TEST_LOAD,
     ctt_LAST
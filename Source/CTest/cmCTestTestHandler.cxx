@@ -365,6 +365,7 @@ void cmCTestTestHandler::Initialize()
   TestsToRunString = "";
   this->UseUnion = false;
   this->TestList.clear();
+  this->TestsByName.clear();
 }
 
 void cmCTestTestHandler::PopulateCustomVectors(cmMakefile* mf)
@@ -413,6 +414,9 @@ int cmCTestTestHandler::ProcessHandler()
   if (cmSystemTools::IsOn(this->GetOption("ScheduleRandom"))) {
     this->CTest->SetScheduleType("Random");
   }
+  if (cmSystemTools::IsOn(this->GetOption("ScheduleCriticalPath"))) {
+    this->CTest->SetScheduleType("CriticalPath");
+  }
   if (this->GetOption("ParallelLevel")) {
     this->CTest->SetParallelLevel(atoi(this->GetOption("ParallelLevel")));
   }
@@ -692,6 +696,7 @@ void cmCTestTestHandler::CheckLabelFilter(cmCTestTestProperties& it)
 void cmCTestTestHandler::ComputeTestList()
 {
   this->TestList.clear(); // clear list of test
+  this->TestsByName.clear();
   this->GetListOfTests();
 
   if (this->RerunFailed) {
@@ -752,7 +757,7 @@ void cmCTestTestHandler::ComputeTestList()
   // Save the total number of tests before exclusions
   this->TotalNumberOfTests = this->TestList.size();
   // Set the TestList to the final list of all test
-  this->TestList = finalList;
+  this->SetTestList(finalList);
 
   this->UpdateMaxTestNameWidth();
 }
@@ -784,7 +789,7 @@ void cmCTestTestHandler::ComputeTestListForRerunFailed()
   this->TotalNumberOfTests = this->TestList.size();
 
   // Set the TestList to the list of failed tests to rerun
-  this->TestList = finalList;
+  this->SetTestList(finalList);
 
   this->UpdateMaxTestNameWidth();
 }
@@ -952,6 +957,15 @@ void cmCTestTestHandler::UpdateForFixtures(ListOfTests& tests) const
                      this->Quiet);
 }
 
+void cmCTestTestHandler::SetTestList(ListOfTests const& tests)
+{
+  this->TestList = tests;
+  this->TestsByName.clear();
+  for (size_t i = 0; i < this->TestList.size(); ++i) {
+    this->TestsByName[this->TestList[i].Name].push_back(i);
+  }
+}
+
 void cmCTestTestHandler::UpdateMaxTestNameWidth()
 {
   std::string::size_type max = this->CTest->GetMaxTestNameWidth();
@@ -1076,6 +1090,8 @@ void cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
   parallel->SetParallelLevel(this->CTest->GetParallelLevel());
   parallel->SetTestHandler(this);
   parallel->SetQuiet(this->Quiet);
+  parallel->SetCriticalPathSchedule(this->CTest->GetScheduleType() ==
+                                    "CriticalPath");
   if (this->TestLoad > 0) {
     parallel->SetTestLoad(this->TestLoad);
   } else {
@@ -1095,6 +1111,14 @@ void cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
     srand((unsigned)time(CM_NULLPTR));
   }
 
+  // Index the tests by name to look up their dependencies.  As names
+  // can only match one test the first one wins.
+  std::map<std::string, int> testIndexes;
+  for (ListOfTests::iterator it = this->TestList.begin();
+       it != this->TestList.end(); ++it) {
+    testIndexes.insert(std::make_pair(it->Name, it->Index));
+  }
+
   for (ListOfTests::iterator it = this->TestList.begin();
        it != this->TestList.end(); ++it) {
     cmCTestTestProperties& p = *it;
@@ -1111,12 +1135,9 @@ void cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
     if (!p.Depends.empty()) {
       for (std::vector<std::string>::iterator i = p.Depends.begin();
            i != p.Depends.end(); ++i) {
-        for (ListOfTests::iterator it2 = this->TestList.begin();
-             it2 != this->TestList.end(); ++it2) {
-          if (it2->Name == *i) {
-            depends.insert(it2->Index);
-            break; // break out of test loop as name can only match 1
-          }
+        std::map<std::string, int>::const_iterator dep = testIndexes.find(*i);
+        if (dep != testIndexes.end()) {
+          depends.insert(dep->second);
         }
       }
     }
@@ -1962,9 +1983,15 @@ bool cmCTestTestHandler::SetTestsProperties(
     std::string val = *it;
     std::vector<std::string>::const_iterator tit;
     for (tit = tests.begin(); tit != tests.end(); ++tit) {
-      cmCTestTestHandler::ListOfTests::iterator rtit;
-      for (rtit = this->TestList.begin(); rtit != this->TestList.end();
-           ++rtit) {
+      std::map<std::string, std::vector<size_t> >::const_iterator named =
+        this->TestsByName.find(*tit);
+      if (named == this->TestsByName.end()) {
+        continue;
+      }
+      std::vector<size_t>::const_iterator ti;
+      for (ti = named->second.begin(); ti != named->second.end(); ++ti) {
+        cmCTestTestHandler::ListOfTests::iterator rtit =
+          this->TestList.begin() + *ti;
         if (*tit == rtit->Name) {
           if (key == "WILL_FAIL") {
             rtit->WillFail = cmSystemTools::IsOn(val.c_str());
@@ -2161,6 +2188,7 @@ bool cmCTestTestHandler::AddTest(const std::vector<std::string>& args)
              this->ExcludeTestsRegularExpression.find(testname.c_str())) {
     test.IsInBasedOnREOptions = false;
   }
+  this->TestsByName[testname].push_back(this->TestList.size());
   this->TestList.push_back(test);
   return true;
 }
@@ -251,6 +251,9 @@ private:
 
   void UpdateMaxTestNameWidth();
 
+  // replace the list of tests and index it by name
+  void SetTestList(ListOfTests const& tests);
+
   bool GetValue(const char* tag, std::string& value, std::istream& fin);
   bool GetValue(const char* tag, int& value, std::istream& fin);
   bool GetValue(const char* tag, size_t& value, std::istream& fin);
@@ -293,6 +296,8 @@ private:
   std::string TestsToRunString;
   bool UseUnion;
   ListOfTests TestList;
+  // Positions in TestList of the tests with each name
+  std::map<std::string, std::vector<size_t> > TestsByName;
   size_t TotalNumberOfTests;
   cmsys::RegularExpression DartStuff;
 
@@ -6,9 +6,33 @@
 #include <cmSystemTools.h>
 #include <iostream>
 
+#ifdef CMAKE_USE_LIBUV
+#include "cmCTestRunTest.h"
+
+#include <string.h>
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+#endif
+
 cmProcess::cmProcess()
 {
   this->Process = CM_NULLPTR;
+#ifdef CMAKE_USE_LIBUV
+  this->PipeReader = CM_NULLPTR;
+  this->Timer = CM_NULLPTR;
+  this->Runner = CM_NULLPTR;
+  this->State = cmsysProcess_State_Starting;
+  this->ExitException = cmsysProcess_Exception_None;
+  this->ProcessExited = false;
+  this->OutputClosed = false;
+#endif
   this->Timeout = 0;
   this->TotalTime = 0;
   this->ExitValue = 0;
@@ -16,10 +40,148 @@ cmProcess::cmProcess()
   this->StartTime = 0;
 }
 
+#ifdef CMAKE_USE_LIBUV
+namespace {
+
+template <typename T>
+void cmProcessDeleteHandle(uv_handle_t* handle)
+{
+  delete reinterpret_cast<T*>(handle);
+}
+
+// Close a handle and free it once the loop is done with it.
+template <typename T>
+void cmProcessCloseHandle(T*& handle)
+{
+  if (handle) {
+    uv_close(reinterpret_cast<uv_handle_t*>(handle),
+             &cmProcessDeleteHandle<T>);
+    handle = CM_NULLPTR;
+  }
+}
+
+// Create a pipe whose ends are not inherited by child processes
+// unless passed to them explicitly.
+bool cmProcessCreatePipe(int fds[2])
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  SECURITY_ATTRIBUTES attr;
+  HANDLE readh;
+  HANDLE writeh;
+  attr.nLength = sizeof(attr);
+  attr.lpSecurityDescriptor = CM_NULLPTR;
+  attr.bInheritHandle = FALSE;
+  if (!CreatePipe(&readh, &writeh, &attr, 0)) {
+    return false;
+  }
+  fds[0] = _open_osfhandle(reinterpret_cast<intptr_t>(readh), 0);
+  fds[1] = _open_osfhandle(reinterpret_cast<intptr_t>(writeh), 0);
+  if (fds[0] == -1 || fds[1] == -1) {
+    CloseHandle(readh);
+    CloseHandle(writeh);
+    return false;
+  }
+#else
+  if (pipe(fds) == -1) {
+    return false;
+  }
+  if (fcntl(fds[0], F_SETFD, FD_CLOEXEC) == -1 ||
+      fcntl(fds[1], F_SETFD, FD_CLOEXEC) == -1) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+#endif
+  return true;
+}
+
+void cmProcessClosePipeEnd(int fd)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  _close(fd);
+#else
+  close(fd);
+#endif
+}
+
+// Tell how a process ended in the terms kwsys uses, or return
+// cmsysProcess_Exception_None if it exited normally.
+int cmProcessExitException(int64_t exit_status, int term_signal)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  if (term_signal != 0) {
+    return cmsysProcess_Exception_Other;
+  }
+  // The process terminated due to an exception.
+  DWORD const code = static_cast<DWORD>(exit_status);
+  if ((code & 0xF0000000) != 0xC0000000) {
+    return cmsysProcess_Exception_None;
+  }
+  switch (code) {
+    case STATUS_CONTROL_C_EXIT:
+      return cmsysProcess_Exception_Interrupt;
+    case STATUS_FLOAT_DENORMAL_OPERAND:
+    case STATUS_FLOAT_DIVIDE_BY_ZERO:
+    case STATUS_FLOAT_INEXACT_RESULT:
+    case STATUS_FLOAT_INVALID_OPERATION:
+    case STATUS_FLOAT_OVERFLOW:
+    case STATUS_FLOAT_STACK_CHECK:
+    case STATUS_FLOAT_UNDERFLOW:
+    case STATUS_INTEGER_DIVIDE_BY_ZERO:
+    case STATUS_INTEGER_OVERFLOW:
+      return cmsysProcess_Exception_Numerical;
+    case STATUS_DATATYPE_MISALIGNMENT:
+    case STATUS_ACCESS_VIOLATION:
+    case STATUS_IN_PAGE_ERROR:
+    case STATUS_INVALID_HANDLE:
+    case STATUS_NONCONTINUABLE_EXCEPTION:
+    case STATUS_INVALID_DISPOSITION:
+    case STATUS_ARRAY_BOUNDS_EXCEEDED:
+    case STATUS_STACK_OVERFLOW:
+      return cmsysProcess_Exception_Fault;
+    case STATUS_ILLEGAL_INSTRUCTION:
+    case STATUS_PRIVILEGED_INSTRUCTION:
+      return cmsysProcess_Exception_Illegal;
+    default:
+      return cmsysProcess_Exception_Other;
+  }
+#else
+  static_cast<void>(exit_status);
+  switch (term_signal) {
+    case 0:
+      return cmsysProcess_Exception_None;
+    case SIGSEGV:
+#ifdef SIGBUS
+#if !defined(SIGSEGV) || SIGBUS != SIGSEGV
+    case SIGBUS:
+#endif
+#endif
+      return cmsysProcess_Exception_Fault;
+    case SIGFPE:
+      return cmsysProcess_Exception_Numerical;
+    case SIGILL:
+      return cmsysProcess_Exception_Illegal;
+    case SIGINT:
+      return cmsysProcess_Exception_Interrupt;
+    default:
+      return cmsysProcess_Exception_Other;
+  }
+#endif
+}
+}
+
+cmProcess::~cmProcess()
+{
+  cmProcessCloseHandle(this->Timer);
+  cmProcessCloseHandle(this->PipeReader);
+  cmProcessCloseHandle(this->Process);
+}
+#else
 cmProcess::~cmProcess()
 {
   cmsysProcess_Delete(this->Process);
 }
+#endif
 void cmProcess::SetCommand(const char* command)
 {
   this->Command = command;
@@ -30,6 +192,195 @@ void cmProcess::SetCommandArguments(std::vector<std::string> const& args)
   this->Arguments = args;
 }
 
+#ifdef CMAKE_USE_LIBUV
+bool cmProcess::StartProcess(uv_loop_t& loop, cmCTestRunTest* runner)
+{
+  this->State = cmsysProcess_State_Error;
+  if (this->Command.empty()) {
+    return false;
+  }
+  this->Runner = runner;
+  this->StartTime = cmSystemTools::GetTime();
+  this->ProcessArgs.clear();
+  // put the command as arg0
+  this->ProcessArgs.push_back(this->Command.c_str());
+  // now put the command arguments in
+  for (std::vector<std::string>::iterator i = this->Arguments.begin();
+       i != this->Arguments.end(); ++i) {
+    this->ProcessArgs.push_back(i->c_str());
+  }
+  this->ProcessArgs.push_back(CM_NULLPTR); // null terminate the list
+
+  // The child writes both stdout and stderr to one pipe so that the
+  // output is read back in the order it was written.
+  int fds[2];
+  if (!cmProcessCreatePipe(fds)) {
+    this->ErrorString = "Failed to create the output pipe.";
+    return false;
+  }
+  this->PipeReader = new uv_pipe_t;
+  uv_pipe_init(&loop, this->PipeReader, 0);
+  this->PipeReader->data = this;
+  uv_pipe_open(this->PipeReader, fds[0]);
+
+  uv_stdio_container_t stdio[3];
+  stdio[0].flags = UV_INHERIT_FD;
+  stdio[0].data.fd = 0;
+  stdio[1].flags = UV_INHERIT_FD;
+  stdio[1].data.fd = fds[1];
+  stdio[2].flags = UV_INHERIT_FD;
+  stdio[2].data.fd = fds[1];
+
+  uv_process_options_t options;
+  memset(&options, 0, sizeof(options));
+  options.file = this->ProcessArgs[0];
+  options.args = const_cast<char**>(&*this->ProcessArgs.begin());
+  if (!this->WorkingDirectory.empty()) {
+    options.cwd = this->WorkingDirectory.c_str();
+  }
+  options.exit_cb = &cmProcess::OnExit;
+  options.stdio_count = 3;
+  options.stdio = stdio;
+  cmUVProcessGroup::SetupOptions(options);
+
+  this->Process = new uv_process_t;
+  this->Process->data = this;
+  int status = uv_spawn(&loop, this->Process, &options);
+  cmProcessClosePipeEnd(fds[1]);
+  if (status != 0) {
+    this->ErrorString = uv_strerror(status);
+    cmProcessCloseHandle(this->PipeReader);
+    return false;
+  }
+
+  this->Group.Attach(this->Process);
+
+  this->State = cmsysProcess_State_Executing;
+  uv_read_start(reinterpret_cast<uv_stream_t*>(this->PipeReader),
+                &cmProcess::OnAllocate, &cmProcess::OnRead);
+  this->Timer = new uv_timer_t;
+  uv_timer_init(&loop, this->Timer);
+  this->Timer->data = this;
+  this->StartTimer();
+  return true;
+}
+
+void cmProcess::StartTimer()
+{
+  if (!this->Timer) {
+    return;
+  }
+  uv_timer_stop(this->Timer);
+  if (this->Timeout > 0) {
+    double remaining =
+      this->StartTime + this->Timeout - cmSystemTools::GetTime();
+    if (remaining < 0) {
+      remaining = 0;
+    }
+    uv_timer_start(this->Timer, &cmProcess::OnTimeout,
+                   static_cast<uint64_t>(remaining * 1000), 0);
+  }
+}
+
+void cmProcess::OnAllocate(uv_handle_t* handle, size_t suggested_size,
+                           uv_buf_t* buf)
+{
+  cmProcess* self = static_cast<cmProcess*>(handle->data);
+  self->ReadBuffer.resize(suggested_size);
+  *buf = uv_buf_init(&self->ReadBuffer[0],
+                     static_cast<unsigned int>(suggested_size));
+}
+
+void cmProcess::OnRead(uv_stream_t* stream, ssize_t nread,
+                       const uv_buf_t* buf)
+{
+  cmProcess* self = static_cast<cmProcess*>(stream->data);
+  std::string line;
+  if (nread > 0) {
+    self->Output.insert(self->Output.end(), buf->base, buf->base + nread);
+    while (self->Output.GetLine(line)) {
+      self->Runner->CheckOutput(line);
+    }
+  } else if (nread < 0) {
+    // The process will provide no more data.
+    if (self->Output.GetLast(line)) {
+      self->Runner->CheckOutput(line);
+    }
+    self->CloseOutput();
+    self->Finish();
+  }
+}
+
+void cmProcess::OnExit(uv_process_t* process, int64_t exit_status,
+                       int term_signal)
+{
+  cmProcess* self = static_cast<cmProcess*>(process->data);
+  self->ProcessExited = true;
+  if (self->Timer) {
+    uv_timer_stop(self->Timer);
+  }
+
+  // Record exit information.
+  self->TotalTime = cmSystemTools::GetTime() - self->StartTime;
+  // Because of a processor clock scew the runtime may become slightly
+  // negative. If someone changed the system clock while the process was
+  // running this may be even more. Make sure not to report a negative
+  // duration here.
+  if (self->TotalTime <= 0.0) {
+    self->TotalTime = 0.0;
+  }
+
+  if (self->State == cmsysProcess_State_Expired) {
+    // Children of a process killed on timeout may still hold the output
+    // pipe open.  Do not wait for them.
+    self->ExitValue = 1;
+    self->CloseOutput();
+  } else {
+    self->ExitException = cmProcessExitException(exit_status, term_signal);
+    if (self->ExitException != cmsysProcess_Exception_None) {
+      self->State = cmsysProcess_State_Exception;
+      self->ExitValue = 1;
+    } else {
+      self->State = cmsysProcess_State_Exited;
+      self->ExitValue = static_cast<int>(exit_status);
+    }
+  }
+  self->Finish();
+}
+
+void cmProcess::OnTimeout(uv_timer_t* timer)
+{
+  cmProcess* self = static_cast<cmProcess*>(timer->data);
+  if (!self->ProcessExited) {
+    // Kill the whole process tree as kwsys does on timeout.  The exit
+    // callback then finishes the test.
+    self->State = cmsysProcess_State_Expired;
+    self->Group.Kill();
+  }
+}
+
+void cmProcess::Kill()
+{
+  if (this->Process && !this->ProcessExited) {
+    this->Group.Kill();
+  }
+}
+
+void cmProcess::CloseOutput()
+{
+  this->OutputClosed = true;
+  cmProcessCloseHandle(this->PipeReader);
+}
+
+void cmProcess::Finish()
+{
+  // Report completion only once the process exited and all its output
+  // was read.  The runner may delete this object.
+  if (this->ProcessExited && this->OutputClosed) {
+    this->Runner->FinalizeTest();
+  }
+}
+#else
 bool cmProcess::StartProcess()
 {
   if (this->Command.empty()) {
@@ -57,6 +408,7 @@ bool cmProcess::StartProcess()
   return (cmsysProcess_GetState(this->Process) ==
           cmsysProcess_State_Executing);
 }
+#endif
 
 bool cmProcess::Buffer::GetLine(std::string& line)
 {
@@ -102,6 +454,7 @@ bool cmProcess::Buffer::GetLast(std::string& line)
   return false;
 }
 
+#ifndef CMAKE_USE_LIBUV
 int cmProcess::GetNextOutputLine(std::string& line, double timeout)
 {
   for (;;) {
@@ -148,33 +501,43 @@ int cmProcess::GetNextOutputLine(std::string& line, double timeout)
   //  std::cerr << "Time to run: " << this->TotalTime << "\n";
   return cmsysProcess_Pipe_None;
 }
+#endif
 
 // return the process status
 int cmProcess::GetProcessStatus()
 {
+#ifdef CMAKE_USE_LIBUV
+  return this->State;
+#else
   if (!this->Process) {
     return cmsysProcess_State_Exited;
   }
   return cmsysProcess_GetState(this->Process);
+#endif
 }
 
 int cmProcess::ReportStatus()
 {
   int result = 1;
-  switch (cmsysProcess_GetState(this->Process)) {
+  switch (this->GetProcessStatus()) {
     case cmsysProcess_State_Starting: {
       std::cerr << "cmProcess: Never started " << this->Command
                 << " process.\n";
     } break;
     case cmsysProcess_State_Error: {
       std::cerr << "cmProcess: Error executing " << this->Command
-                << " process: " << cmsysProcess_GetErrorString(this->Process)
+                << " process: "
+#ifdef CMAKE_USE_LIBUV
+                << this->ErrorString
+#else
+                << cmsysProcess_GetErrorString(this->Process)
+#endif
                 << "\n";
     } break;
     case cmsysProcess_State_Exception: {
       std::cerr << "cmProcess: " << this->Command
                 << " process exited with an exception: ";
-      switch (cmsysProcess_GetExitException(this->Process)) {
+      switch (this->GetExitException()) {
         case cmsysProcess_Exception_None: {
           std::cerr << "None";
         } break;
@@ -201,7 +564,7 @@ int cmProcess::ReportStatus()
                 << " process.\n";
     } break;
     case cmsysProcess_State_Exited: {
-      result = cmsysProcess_GetExitValue(this->Process);
+      result = this->ExitValue;
       std::cerr << "cmProcess: " << this->Command
                 << " process exited with code " << result << "\n";
     } break;
@@ -216,6 +579,27 @@ int cmProcess::ReportStatus()
   return result;
 }
 
+#ifdef CMAKE_USE_LIBUV
+void cmProcess::ChangeTimeout(double t)
+{
+  this->Timeout = t;
+  this->StartTimer();
+}
+
+void cmProcess::ResetStartTime()
+{
+  this->StartTime = cmSystemTools::GetTime();
+  this->StartTimer();
+}
+
+int cmProcess::GetExitException()
+{
+  if (this->State != cmsysProcess_State_Exception) {
+    return cmsysProcess_Exception_None;
+  }
+  return this->ExitException;
+}
+#else
 void cmProcess::ChangeTimeout(double t)
 {
   this->Timeout = t;
@@ -232,3 +616,4 @@ int cmProcess::GetExitException()
 {
   return cmsysProcess_GetExitException(this->Process);
 }
+#endif
@@ -9,10 +9,21 @@
 #include <string>
 #include <vector>
 
+#ifdef CMAKE_USE_LIBUV
+#include "cmUVProcessGroup.h"
+#include "cm_uv.h"
+
+class cmCTestRunTest;
+#endif
+
 /** \class cmProcess
  * \brief run a process with c++
  *
- * cmProcess wraps the kwsys process stuff in a c++ class.
+ * cmProcess wraps the kwsys process stuff in a c++ class.  When CMake
+ * is built with libuv the process is instead run on a libuv event loop
+ * and reports its output and exit to the cmCTestRunTest that started it,
+ * so that the caller never has to poll.  Either way the status values
+ * reported are those of kwsys.
  */
 class cmProcess
 {
@@ -26,8 +37,18 @@ public:
   void SetTimeout(double t) { this->Timeout = t; }
   void ChangeTimeout(double t);
   void ResetStartTime();
+#ifdef CMAKE_USE_LIBUV
+  // Return true if the process starts.  Each line of output is passed
+  // to runner->CheckOutput and runner->FinalizeTest is called once the
+  // process exited and all of its output was read.
+  bool StartProcess(uv_loop_t& loop, cmCTestRunTest* runner);
+  // Kill the process and all of its descendants.  The runner is still
+  // finalized once it exited.
+  void Kill();
+#else
   // Return true if the process starts
   bool StartProcess();
+#endif
 
   // return the process status
   int GetProcessStatus();
@@ -38,6 +59,7 @@ public:
   int GetExitValue() { return this->ExitValue; }
   double GetTotalTime() { return this->TotalTime; }
   int GetExitException();
+#ifndef CMAKE_USE_LIBUV
   /**
    * Read one line of output but block for no more than timeout.
    * Returns:
@@ -46,12 +68,37 @@ public:
    *   cmsysProcess_Pipe_Timeout = Timeout expired while waiting
    */
   int GetNextOutputLine(std::string& line, double timeout);
+#endif
 
 private:
   double Timeout;
   double StartTime;
   double TotalTime;
+#ifdef CMAKE_USE_LIBUV
+  uv_process_t* Process;
+  uv_pipe_t* PipeReader;
+  uv_timer_t* Timer;
+  cmUVProcessGroup Group;
+  cmCTestRunTest* Runner;
+  std::vector<char> ReadBuffer;
+  std::string ErrorString;
+  int State;
+  int ExitException;
+  bool ProcessExited;
+  bool OutputClosed;
+
+  static void OnAllocate(uv_handle_t* handle, size_t suggested_size,
+                         uv_buf_t* buf);
+  static void OnRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
+  static void OnExit(uv_process_t* process, int64_t exit_status,
+                     int term_signal);
+  static void OnTimeout(uv_timer_t* timer);
+  void StartTimer();
+  void CloseOutput();
+  void Finish();
+#else
   cmsysProcess* Process;
+#endif
   class Buffer : public std::vector<char>
   {
     // Half-open index range of partial line already scanned.
@@ -2061,6 +2061,11 @@ int cmCTest::Run(std::vector<std::string>& args, std::string* output)
       this->ScheduleType = "Random";
     }
 
+    // --schedule-critical-path
+    if (this->CheckArgument(arg, "--schedule-critical-path")) {
+      this->ScheduleType = "CriticalPath";
+    }
+
     // pass the argument to all the handlers as well, but i may no longer be
     // set to what it was originally so I'm not sure this is working as
     // intended
@@ -19,6 +19,7 @@
 #include "cmSourceFile.h"
 #include "cmStateDirectory.h"
 #include "cmStateTypes.h"
+#include "cmSystemTools.h"
 
 cmCommonTargetGenerator::cmCommonTargetGenerator(cmGeneratorTarget* gt)
   : GeneratorTarget(gt)
@@ -28,6 +29,8 @@ cmCommonTargetGenerator::cmCommonTargetGenerator(cmGeneratorTarget* gt)
       gt->LocalGenerator->GetGlobalGenerator()))
   , ConfigName(LocalGenerator->GetConfigName())
   , ModuleDefinitionFile(GeneratorTarget->GetModuleDefinitionFile(ConfigName))
+  , ConfigDefinitionsProperty("COMPILE_DEFINITIONS_" +
+                              cmSystemTools::UpperCase(ConfigName))
 {
 }
 
@@ -112,7 +115,7 @@ void cmCommonTargetGenerator::AppendFortranFormatFlags(
   }
 }
 
-std::string cmCommonTargetGenerator::GetFlags(const std::string& l)
+std::string const& cmCommonTargetGenerator::GetFlags(const std::string& l)
 {
   ByLanguageMap::iterator i = this->FlagsByLanguage.find(l);
   if (i == this->FlagsByLanguage.end()) {
@@ -127,7 +130,7 @@ std::string cmCommonTargetGenerator::GetFlags(const std::string& l)
   return i->second;
 }
 
-std::string cmCommonTargetGenerator::GetDefines(const std::string& l)
+std::string const& cmCommonTargetGenerator::GetDefines(const std::string& l)
 {
   ByLanguageMap::iterator i = this->DefinesByLanguage.find(l);
   if (i == this->DefinesByLanguage.end()) {
@@ -144,7 +147,7 @@ std::string cmCommonTargetGenerator::GetDefines(const std::string& l)
   return i->second;
 }
 
-std::string cmCommonTargetGenerator::GetIncludes(std::string const& l)
+std::string const& cmCommonTargetGenerator::GetIncludes(std::string const& l)
 {
   ByLanguageMap::iterator i = this->IncludesByLanguage.find(l);
   if (i == this->IncludesByLanguage.end()) {
@@ -156,6 +159,18 @@ std::string cmCommonTargetGenerator::GetIncludes(std::string const& l)
   return i->second;
 }
 
+bool cmCommonTargetGenerator::HasSourceSpecificFlags(
+  cmSourceFile const& source, std::string const& lang)
+{
+  // Fortran sources may choose their own format.
+  bool const specific = lang == "Fortran" ||
+    source.GetProperty("COMPILE_FLAGS") ||
+    source.GetProperty("COMPILE_DEFINITIONS") ||
+    source.GetProperty(this->ConfigDefinitionsProperty);
+  this->GlobalGenerator->CountObjectFlags(!specific);
+  return specific;
+}
+
 std::vector<std::string> cmCommonTargetGenerator::GetLinkedTargetDirectories()
   const
 {
@@ -60,12 +60,18 @@ protected:
                         const char* name, bool so);
 
   typedef std::map<std::string, std::string> ByLanguageMap;
-  std::string GetFlags(const std::string& l);
+  std::string const& GetFlags(const std::string& l);
   ByLanguageMap FlagsByLanguage;
-  std::string GetDefines(const std::string& l);
+  std::string const& GetDefines(const std::string& l);
   ByLanguageMap DefinesByLanguage;
-  std::string GetIncludes(std::string const& l);
+  std::string const& GetIncludes(std::string const& l);
   ByLanguageMap IncludesByLanguage;
+
+  // Whether a source sets compile flags or definitions of its own, so
+  // that its object cannot use the ones above as they are.
+  bool HasSourceSpecificFlags(cmSourceFile const& source,
+                              std::string const& lang);
+  std::string ConfigDefinitionsProperty;
   std::string GetManifests();
 
   std::vector<std::string> GetLinkedTargetDirectories() const;
@@ -168,6 +168,25 @@ original user link line followed by minimal additional items needed to
 satisfy dependencies.  The final list is then filtered to de-duplicate
 items that we know the linker will re-use automatically (shared libs).
 
+------------------------------------------------------------------------------
+
+Targets of one directory that link the same items in the same
+configuration usually get the same final list.  The item names resolve
+to the same targets in the same directory, and the link interfaces
+followed are those of the dependencies.  The final list computed for
+one target is therefore kept in a cmComputeLinkDependsCache owned by
+the local generator, keyed by the configuration and the original link
+line, and given to the next target linking the same items.  A result
+is not kept when it depends on the target being linked:
+
+  - A link interface followed had a head-sensitive condition such as
+    $<TARGET_PROPERTY:prop>.
+  - An item was dropped because it names the target being linked.
+
+A kept result lists the names of all items it followed, and it is not
+given to a target whose name is among them because that target would
+have dropped the item.
+
 */
 
 cmComputeLinkDepends::cmComputeLinkDepends(const cmGeneratorTarget* target,
@@ -193,6 +212,10 @@ cmComputeLinkDepends::cmComputeLinkDepends(const cmGeneratorTarget* target,
   // Assume no compatibility until set.
   this->OldLinkDirMode = false;
 
+  // Share the result with other targets of the directory if possible.
+  this->Cache = &this->Target->GetLocalGenerator()->GetLinkDependsCache();
+  this->HeadSensitive = false;
+
   // No computation has been done.
   this->CCG = CM_NULLPTR;
 }
@@ -211,6 +234,15 @@ void cmComputeLinkDepends::SetOldLinkDirMode(bool b)
 std::vector<cmComputeLinkDepends::LinkEntry> const&
 cmComputeLinkDepends::Compute()
 {
+  // Use the result computed for another target linking the same items.
+  std::string key;
+  if (!this->DebugMode) {
+    key = this->GetCacheKey();
+    if (EntryVector const* entries = this->FindCachedResult(key)) {
+      return *entries;
+    }
+  }
+
   // Follow the link dependencies of the target to be linked.
   this->AddDirectLinkEntries();
 
@@ -273,11 +305,86 @@ cmComputeLinkDepends::Compute()
   // Display the final set.
   if (this->DebugMode) {
     this->DisplayFinalEntries();
+  } else {
+    this->StoreCachedResult(key);
   }
+  this->Cache->Count(false);
 
   return this->FinalLinkEntries;
 }
 
+std::string cmComputeLinkDepends::GetCacheKey() const
+{
+  // Within the directory the same names resolve to the same items.
+  std::string key = this->Config;
+  key += this->OldLinkDirMode ? ";OLD" : ";NEW";
+  cmLinkImplementation const* impl =
+    this->Target->GetLinkImplementation(this->Config);
+  for (std::vector<cmLinkImplItem>::const_iterator li =
+         impl->Libraries.begin();
+       li != impl->Libraries.end(); ++li) {
+    key += '\n';
+    key += *li;
+  }
+  if (this->OldLinkDirMode) {
+    key += '\n';
+    for (std::vector<cmLinkItem>::const_iterator wi =
+           impl->WrongConfigLibraries.begin();
+         wi != impl->WrongConfigLibraries.end(); ++wi) {
+      key += '\n';
+      key += *wi;
+    }
+  }
+  return key;
+}
+
+cmComputeLinkDepends::EntryVector const*
+cmComputeLinkDepends::FindCachedResult(std::string const& key)
+{
+  cmComputeLinkDependsCache::Result const* result = this->Cache->Find(key);
+  if (!result) {
+    return CM_NULLPTR;
+  }
+
+  // This target would drop an item named like it.
+  if (std::binary_search(result->ItemNames.begin(), result->ItemNames.end(),
+                         this->Target->GetName())) {
+    return CM_NULLPTR;
+  }
+
+  this->OldWrongConfigItems = result->OldWrongConfigItems;
+  this->Cache->Count(true);
+  return &result->FinalLinkEntries;
+}
+
+void cmComputeLinkDepends::StoreCachedResult(std::string const& key)
+{
+  if (this->HeadSensitive) {
+    return;
+  }
+
+  cmComputeLinkDependsCache::Result result;
+  result.FinalLinkEntries = this->FinalLinkEntries;
+  result.OldWrongConfigItems = this->OldWrongConfigItems;
+  for (std::vector<LinkEntry>::const_iterator ei = this->EntryList.begin();
+       ei != this->EntryList.end(); ++ei) {
+    result.ItemNames.push_back(ei->Item);
+  }
+  std::sort(result.ItemNames.begin(), result.ItemNames.end());
+  this->Cache->Store(key, result);
+}
+
+cmLinkInterface const* cmComputeLinkDepends::GetLinkInterface(
+  cmGeneratorTarget const* target)
+{
+  cmLinkInterface const* iface =
+    target->GetLinkInterface(this->Config, this->Target);
+  if (iface && iface->HadHeadSensitiveCondition) {
+    this->HeadSensitive = true;
+  }
+  return iface;
+}
+
 std::map<std::string, int>::iterator cmComputeLinkDepends::AllocateLinkEntry(
   std::string const& item)
 {
@@ -342,8 +449,7 @@ void cmComputeLinkDepends::FollowLinkEntry(BFSEntry const& qe)
   // Follow the item's dependencies.
   if (entry.Target) {
     // Follow the target dependencies.
-    if (cmLinkInterface const* iface =
-          entry.Target->GetLinkInterface(this->Config, this->Target)) {
+    if (cmLinkInterface const* iface = this->GetLinkInterface(entry.Target)) {
       const bool isIface =
         entry.Target->GetType() == cmStateEnums::INTERFACE_LIBRARY;
       // This target provides its own link interface information.
@@ -424,8 +530,7 @@ void cmComputeLinkDepends::HandleSharedDependency(SharedDepEntry const& dep)
 
   // Target items may have their own dependencies.
   if (entry.Target) {
-    if (cmLinkInterface const* iface =
-          entry.Target->GetLinkInterface(this->Config, this->Target)) {
+    if (cmLinkInterface const* iface = this->GetLinkInterface(entry.Target)) {
       // Follow public and private dependencies transitively.
       this->FollowSharedDeps(index, iface, true);
     }
@@ -438,6 +543,8 @@ void cmComputeLinkDepends::AddVarLinkEntries(int depender_index,
   // This is called to add the dependencies named by
   // <item>_LIB_DEPENDS.  The variable contains a semicolon-separated
   // list.  The list contains link-type;item pairs and just items.
+  // They are looked up in the scope of the target being linked.
+  this->HeadSensitive = true;
   std::vector<std::string> deplist;
   cmSystemTools::ExpandListArgument(value, deplist);
 
@@ -519,7 +626,11 @@ void cmComputeLinkDepends::AddLinkEntries(int depender_index,
     // Skip entries that will resolve to the target getting linked or
     // are empty.
     cmLinkItem const& item = *li;
-    if (item == this->Target->GetName() || item.empty()) {
+    if (item.empty()) {
+      continue;
+    }
+    if (item == this->Target->GetName()) {
+      this->HeadSensitive = true;
       continue;
     }
 
@@ -818,8 +929,7 @@ int cmComputeLinkDepends::ComputeComponentCount(NodeList const& nl)
   unsigned int count = 2;
   for (NodeList::const_iterator ni = nl.begin(); ni != nl.end(); ++ni) {
     if (cmGeneratorTarget const* target = this->EntryList[*ni].Target) {
-      if (cmLinkInterface const* iface =
-            target->GetLinkInterface(this->Config, this->Target)) {
+      if (cmLinkInterface const* iface = this->GetLinkInterface(target)) {
         if (iface->Multiplicity > count) {
           count = iface->Multiplicity;
         }
@@ -857,3 +967,34 @@ void cmComputeLinkDepends::CheckWrongConfigItem(cmLinkItem const& item)
     this->OldWrongConfigItems.insert(item.Target);
   }
 }
+
+cmComputeLinkDependsCache::cmComputeLinkDependsCache()
+  : Computed(0)
+  , Shared(0)
+{
+}
+
+cmComputeLinkDependsCache::Result const* cmComputeLinkDependsCache::Find(
+  std::string const& key) const
+{
+  std::map<std::string, Result>::const_iterator i = this->Results.find(key);
+  return i != this->Results.end() ? &i->second : CM_NULLPTR;
+}
+
+void cmComputeLinkDependsCache::Store(std::string const& key,
+                                      Result const& result)
+{
+  this->Results.insert(std::make_pair(key, result));
+}
+
+void cmComputeLinkDependsCache::Count(bool shared)
+{
+  ++(shared ? this->Shared : this->Computed);
+}
+
+void cmComputeLinkDependsCache::GetStatistics(unsigned long& computed,
+                                              unsigned long& shared) const
+{
+  computed = this->Computed;
+  shared = this->Shared;
+}
@@ -16,6 +16,7 @@
 #include <vector>
 
 class cmComputeComponentGraph;
+class cmComputeLinkDependsCache;
 class cmGeneratorTarget;
 class cmGlobalGenerator;
 class cmMakefile;
@@ -72,6 +73,14 @@ private:
   std::string Config;
   EntryVector FinalLinkEntries;
 
+  // Sharing of the result with other targets of the directory.
+  cmComputeLinkDependsCache* Cache;
+  bool HeadSensitive;
+  std::string GetCacheKey() const;
+  EntryVector const* FindCachedResult(std::string const& key);
+  void StoreCachedResult(std::string const& key);
+  cmLinkInterface const* GetLinkInterface(cmGeneratorTarget const* target);
+
   std::map<std::string, int>::iterator AllocateLinkEntry(
     std::string const& item);
   int AddLinkEntry(cmLinkItem const& item);
@@ -170,4 +179,38 @@ private:
   bool OldLinkDirMode;
 };
 
+/** \class cmComputeLinkDependsCache
+ * \brief Link dependencies shared by the targets of one directory.
+ *
+ * Targets of a directory that link the same items in the same
+ * configuration mostly get the same link dependencies.  The first of
+ * them to compute the dependencies keeps them here for the others.
+ */
+class cmComputeLinkDependsCache
+{
+public:
+  cmComputeLinkDependsCache();
+
+  struct Result
+  {
+    cmComputeLinkDepends::EntryVector FinalLinkEntries;
+    std::set<cmGeneratorTarget const*> OldWrongConfigItems;
+    // The names of all items followed, sorted.
+    std::vector<std::string> ItemNames;
+  };
+
+  Result const* Find(std::string const& key) const;
+  void Store(std::string const& key, Result const& result);
+
+  /** Count a computation of link dependencies and whether it was
+      given a result kept for another target.  */
+  void Count(bool shared);
+  void GetStatistics(unsigned long& computed, unsigned long& shared) const;
+
+private:
+  std::map<std::string, Result> Results;
+  unsigned long Computed;
+  unsigned long Shared;
+};
+
 #endif
@@ -5,6 +5,7 @@
 #include "cmAlgorithms.h"
 #include "cmMakefile.h"
 #include "cmOutputConverter.h"
+#include "cmRegularExpressionCache.h"
 #include "cmState.h"
 #include "cmSystemTools.h"
 
@@ -527,16 +528,17 @@ bool cmConditionEvaluator::HandleLevel2(cmArgumentList& newArgs,
         }
         const char* rex = argP2->c_str();
         this->Makefile.ClearMatches();
-        cmsys::RegularExpression regEntry;
-        if (!regEntry.compile(rex)) {
+        cmsys::RegularExpression* regEntry =
+          cmRegularExpressionCache::Get(argP2->GetValue());
+        if (!regEntry) {
           std::ostringstream error;
           error << "Regular expression \"" << rex << "\" cannot compile";
           errorString = error.str();
           status = cmake::FATAL_ERROR;
           return false;
         }
-        if (regEntry.find(def)) {
-          this->Makefile.StoreMatches(regEntry);
+        if (regEntry->find(def)) {
+          this->Makefile.StoreMatches(*regEntry);
           *arg = cmExpandedCommandArgument("1", true);
         } else {
           *arg = cmExpandedCommandArgument("0", true);
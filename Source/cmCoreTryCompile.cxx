@@ -8,9 +8,19 @@
 #include "cmMakefile.h"
 #include "cmOutputConverter.h"
 #include "cmState.h"
+#include "cmVersion.h"
 #include "cmake.h"
 #include <cmsys/Directory.hxx>
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#include "cmCryptoHash.h"
+#include "cmTryCompileBatch.h"
+#include "cmTryCompileCache.h"
+
+#include <cmsys/FStream.hxx>
+#include <iterator>
+#endif
+
 #include <assert.h>
 
 static std::string const kCMAKE_C_COMPILER_EXTERNAL_TOOLCHAIN =
@@ -37,11 +47,27 @@ static std::string const kCMAKE_TRY_COMPILE_OSX_ARCHITECTURES =
 static std::string const kCMAKE_TRY_COMPILE_PLATFORM_VARIABLES =
   "CMAKE_TRY_COMPILE_PLATFORM_VARIABLES";
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+// Placeholders for the parts of a test project that differ between
+// otherwise identical try_compile calls, so they can share a result.
+static const char* const kTryCompileCacheBinaryDir = "<TRY_COMPILE_DIR>";
+static const char* const kTryCompileCacheTargetName = "<TRY_COMPILE_TARGET>";
+
+static void cmTryCompileCacheNormalize(std::string& str,
+                                       std::string const& binaryDir,
+                                       std::string const& targetName)
+{
+  cmSystemTools::ReplaceString(str, binaryDir, kTryCompileCacheBinaryDir);
+  cmSystemTools::ReplaceString(str, targetName, kTryCompileCacheTargetName);
+}
+#endif
+
 int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
                                      bool isTryRun)
 {
   this->BinaryDirectory = argv[1];
   this->OutputFile = "";
+  this->Deferred = false;
   // which signature were we called with ?
   this->SrcFileSignature = true;
 
@@ -85,8 +111,11 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   bool didOutputVariable = false;
   bool didCopyFile = false;
   bool didCopyFileError = false;
+  bool defer = false;
   bool useSources = argv[2] == "SOURCES";
   std::vector<std::string> sources;
+  std::string cacheDir;
+  std::string cacheKey;
 
   enum Doing
   {
@@ -117,6 +146,9 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     } else if (argv[i] == "COPY_FILE_ERROR") {
       doing = DoingCopyFileError;
       didCopyFileError = true;
+    } else if (argv[i] == "DEFER") {
+      doing = DoingNone;
+      defer = true;
     } else if (doing == DoingCMakeFlags) {
       cmakeFlags.push_back(argv[i]);
     } else if (doing == DoingCompileDefinitions) {
@@ -197,6 +229,19 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     return -1;
   }
 
+  if (defer && (isTryRun || !this->SrcFileSignature)) {
+    this->Makefile->IssueMessage(
+      cmake::FATAL_ERROR,
+      "DEFER may be used only with the try_compile source file signature");
+    return -1;
+  }
+
+  if (defer && didCopyFile) {
+    this->Makefile->IssueMessage(cmake::FATAL_ERROR,
+                                 "DEFER may not be used with COPY_FILE");
+    return -1;
+  }
+
   if (useSources && sources.empty()) {
     this->Makefile->IssueMessage(
       cmake::FATAL_ERROR,
@@ -517,17 +562,91 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     }
     fclose(fout);
     projectName = "CMAKE_TRY_COMPILE";
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    // The result may come from the try_compile cache unless the caller
+    // needs the file built by the test project.
+    const char* cd =
+      this->Makefile->GetDefinition("CMAKE_TRY_COMPILE_CACHE_DIR");
+    if (cd && *cd && !isTryRun && copyFile.empty()) {
+      cacheDir = cmSystemTools::CollapseFullPath(
+        cd, this->Makefile->GetHomeOutputDirectory());
+      cacheKey = this->ComputeCacheKey(targetName, targetType, sources,
+                                       testLangs, cmakeFlags);
+    }
+#endif
   }
 
-  bool erroroc = cmSystemTools::GetErrorOccuredFlag();
-  cmSystemTools::ResetErrorOccuredFlag();
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(
-    sourceDirectory, this->BinaryDirectory, projectName, targetName,
-    this->SrcFileSignature, &cmakeFlags, output);
-  if (erroroc) {
-    cmSystemTools::SetErrorOccured();
+  int res = 1;
+  bool cached = false;
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmTryCompileCache* cache =
+    this->Makefile->GetCMakeInstance()->GetTryCompileCache();
+  if (!cacheKey.empty() &&
+      cache->Lookup(cacheDir, cacheKey, res, output)) {
+    cmSystemTools::ReplaceString(output, kTryCompileCacheBinaryDir,
+                                 this->BinaryDirectory.c_str());
+    cmSystemTools::ReplaceString(output, kTryCompileCacheTargetName,
+                                 targetName.c_str());
+    cached = true;
+  }
+  if (!cached && defer) {
+    // Generate the test project now but leave its build, and setting
+    // the result, to a later try_compile(BUILD_DEFERRED).
+    cmTryCompileBatch* batch =
+      this->Makefile->GetCMakeInstance()->GetTryCompileBatch();
+    if (batch->HasBinaryDirectory(this->BinaryDirectory)) {
+      this->Makefile->IssueMessage(
+        cmake::FATAL_ERROR, "DEFER given binary directory\n  " +
+          this->BinaryDirectory +
+          "\nalready used by a try_compile whose build is deferred.");
+      return -1;
+    }
+    if (this->Makefile->GenerateTryCompile(sourceDirectory,
+                                           this->BinaryDirectory, true,
+                                           &cmakeFlags) == 0) {
+      cmTryCompileBatch::Job job;
+      job.BinaryDirectory = this->BinaryDirectory;
+      job.ProjectName = projectName;
+      job.TargetName = targetName;
+      job.ResultVariable = argv[0];
+      job.OutputVariable = outputVariable;
+      job.CacheDirectory = cacheDir;
+      job.CacheKey = cacheKey;
+      job.Backtrace = this->Makefile->GetBacktrace();
+      batch->AddJob(job);
+      this->Deferred = true;
+      return 0;
+    }
+    // Report the failure to generate like an undeferred build would.
+    cached = true;
+  }
+#endif
+  if (!cached) {
+    bool erroroc = cmSystemTools::GetErrorOccuredFlag();
+    cmSystemTools::ResetErrorOccuredFlag();
+    // actually do the try compile now that everything is setup
+    res = this->Makefile->TryCompile(sourceDirectory, this->BinaryDirectory,
+                                     projectName, targetName,
+                                     this->SrcFileSignature, &cmakeFlags,
+                                     output);
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    // Do not record results of test projects that failed to generate.
+    if (!cacheKey.empty() && !cmSystemTools::GetErrorOccuredFlag()) {
+      std::string cacheOutput = output;
+      cmTryCompileCacheNormalize(cacheOutput, this->BinaryDirectory,
+                                 targetName);
+      if (!cache->Store(cacheDir, cacheKey, res, cacheOutput)) {
+        this->Makefile->IssueMessage(
+          cmake::WARNING,
+          "Could not write try_compile cache entry in\n  " + cacheDir);
+      }
+    }
+#endif
+    if (erroroc) {
+      cmSystemTools::SetErrorOccured();
+    }
   }
 
   // set the result var to the return value to indicate success or failure
@@ -572,6 +691,156 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   return res;
 }
 
+std::string cmCoreTryCompile::ComputeCacheKey(
+  std::string const& targetName, cmStateEnums::TargetType targetType,
+  std::vector<std::string> const& sources, std::set<std::string> const& langs,
+  std::vector<std::string> const& cmakeFlags)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Collect everything the outcome of the test project depends on.
+  // Headers reached from the sources are not included, so the cache
+  // assumes the toolchain installation does not change underneath it.
+  std::ostringstream key;
+  key << "cmake " << cmVersion::GetCMakeVersion() << "\n";
+  key << "generator "
+      << this->Makefile->GetGlobalGenerator()->GetName() << "\n";
+  const char* const generatorVars[] = { "CMAKE_GENERATOR_PLATFORM",
+                                        "CMAKE_GENERATOR_TOOLSET",
+                                        "CMAKE_TRY_COMPILE_CONFIGURATION" };
+  for (size_t i = 0; i < cmArraySize(generatorVars); ++i) {
+    key << generatorVars[i] << "="
+        << this->Makefile->GetSafeDefinition(generatorVars[i]) << "\n";
+  }
+  key << "type " << cmState::GetTargetTypeName(targetType) << "\n";
+
+  // Identify each compiler by its id, version, and the file itself so
+  // that upgrading a compiler in place invalidates its entries.
+  for (std::set<std::string>::const_iterator li = langs.begin();
+       li != langs.end(); ++li) {
+    std::string const compilerVar = "CMAKE_" + *li + "_COMPILER";
+    std::string const compiler =
+      this->Makefile->GetSafeDefinition(compilerVar);
+    key << compilerVar << "=" << compiler << "\n";
+    key << "size " << cmSystemTools::FileLength(compiler) << " mtime "
+        << cmSystemTools::ModifiedTime(compiler) << "\n";
+    const char* const compilerVars[] = { "_ARG1", "_ID", "_VERSION" };
+    for (size_t i = 0; i < cmArraySize(compilerVars); ++i) {
+      key << compilerVar << compilerVars[i] << "="
+          << this->Makefile->GetSafeDefinition(compilerVar + compilerVars[i])
+          << "\n";
+    }
+  }
+
+  // The flags forwarded to the test project include the values of the
+  // CMAKE_TRY_COMPILE_PLATFORM_VARIABLES.
+  for (std::vector<std::string>::const_iterator fi = cmakeFlags.begin();
+       fi != cmakeFlags.end(); ++fi) {
+    std::string flag = *fi;
+    cmTryCompileCacheNormalize(flag, this->BinaryDirectory, targetName);
+    key << "flag " << flag << "\n";
+  }
+
+  cmCryptoHashSHA256 sha;
+  for (std::vector<std::string>::const_iterator si = sources.begin();
+       si != sources.end(); ++si) {
+    std::string const hash = sha.HashFile(*si);
+    if (hash.empty()) {
+      return std::string();
+    }
+    std::string source = *si;
+    cmTryCompileCacheNormalize(source, this->BinaryDirectory, targetName);
+    key << "source " << source << " " << hash << "\n";
+  }
+
+  // Include the generated project files, which carry the compile and
+  // link flags and the imported targets to link.
+  std::vector<std::string> files;
+  files.push_back("CMakeLists.txt");
+  files.push_back(targetName + "Targets.cmake");
+  for (std::vector<std::string>::const_iterator fi = files.begin();
+       fi != files.end(); ++fi) {
+    std::string const path = this->BinaryDirectory + "/" + *fi;
+    if (!cmSystemTools::FileExists(path.c_str())) {
+      continue;
+    }
+    cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin) {
+      return std::string();
+    }
+    std::string content((std::istreambuf_iterator<char>(fin)),
+                        std::istreambuf_iterator<char>());
+    cmTryCompileCacheNormalize(content, this->BinaryDirectory, targetName);
+    key << "file " << *fi << "\n" << content << "\n";
+  }
+
+  return sha.HashString(key.str());
+#else
+  (void)targetName;
+  (void)targetType;
+  (void)sources;
+  (void)langs;
+  (void)cmakeFlags;
+  return std::string();
+#endif
+}
+
+bool cmCoreTryCompile::BuildDeferred(std::vector<std::string> const& argv)
+{
+  unsigned long parallel = 1;
+  if (argv.size() == 3 && argv[1] == "PARALLEL_LEVEL") {
+    if (!cmSystemTools::StringToULong(argv[2].c_str(), &parallel) ||
+        parallel < 1) {
+      this->SetError("BUILD_DEFERRED given invalid PARALLEL_LEVEL \"" +
+                     argv[2] + "\".");
+      return false;
+    }
+  } else if (argv.size() != 1) {
+    this->SetError("BUILD_DEFERRED given unknown arguments.");
+    return false;
+  }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmake* cm = this->Makefile->GetCMakeInstance();
+  std::vector<cmTryCompileBatch::Job> jobs;
+  bool erroroc = cmSystemTools::GetErrorOccuredFlag();
+  cmSystemTools::ResetErrorOccuredFlag();
+  cm->GetTryCompileBatch()->Build(
+    this->Makefile->GetGlobalGenerator(),
+    this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION"),
+    static_cast<unsigned int>(parallel), jobs);
+  bool storeResults = !cmSystemTools::GetErrorOccuredFlag();
+  if (erroroc) {
+    cmSystemTools::SetErrorOccured();
+  }
+
+  for (std::vector<cmTryCompileBatch::Job>::iterator ji = jobs.begin();
+       ji != jobs.end(); ++ji) {
+    this->Makefile->AddCacheDefinition(
+      ji->ResultVariable, (ji->Result == 0 ? "TRUE" : "FALSE"),
+      "Result of TRY_COMPILE", cmStateEnums::INTERNAL);
+    if (!ji->OutputVariable.empty()) {
+      this->Makefile->AddDefinition(ji->OutputVariable, ji->Output.c_str());
+    }
+    if (!ji->CacheKey.empty() && storeResults) {
+      std::string cacheOutput = ji->Output;
+      cmTryCompileCacheNormalize(cacheOutput, ji->BinaryDirectory,
+                                 ji->TargetName);
+      if (!cm->GetTryCompileCache()->Store(ji->CacheDirectory, ji->CacheKey,
+                                           ji->Result, cacheOutput)) {
+        this->Makefile->IssueMessage(cmake::WARNING,
+                                     "Could not write try_compile cache "
+                                     "entry in\n  " +
+                                       ji->CacheDirectory);
+      }
+    }
+    if (!cm->GetDebugTryCompile()) {
+      this->CleanupFiles(ji->BinaryDirectory.c_str());
+    }
+  }
+#endif
+  return true;
+}
+
 void cmCoreTryCompile::CleanupFiles(const char* binDir)
 {
   if (!binDir) {
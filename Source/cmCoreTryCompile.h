@@ -6,6 +6,8 @@
 #include "cmCommand.h"
 #include "cmStateTypes.h"
 
+#include <set>
+
 /** \class cmCoreTryCompile
  * \brief Base class for cmTryCompileCommand and cmTryRunCommand
  *
@@ -23,6 +25,13 @@ protected:
    */
   int TryCompileCode(std::vector<std::string> const& argv, bool isTryRun);
 
+  /**
+   * Build the test projects of all calls given the DEFER option and set
+   * their result and output variables.  Handles the arguments of the
+   * try_compile(BUILD_DEFERRED) signature.
+   */
+  bool BuildDeferred(std::vector<std::string> const& argv);
+
   /**
    * This deletes all the files created by TryCompileCode.
    * This way we do not have to rely on the timing and
@@ -38,10 +47,22 @@ protected:
   void FindOutputFile(const std::string& targetName,
                       cmStateEnums::TargetType targetType);
 
+  /**
+   * Compute the key of the try_compile cache entry holding the result
+   * of the test project generated in BinaryDirectory.  Returns an
+   * empty string if the inputs of the project cannot all be read.
+   */
+  std::string ComputeCacheKey(std::string const& targetName,
+                              cmStateEnums::TargetType targetType,
+                              std::vector<std::string> const& sources,
+                              std::set<std::string> const& langs,
+                              std::vector<std::string> const& cmakeFlags);
+
   std::string BinaryDirectory;
   std::string OutputFile;
   std::string FindErrorMessage;
   bool SrcFileSignature;
+  bool Deferred;
 };
 
 #endif
@@ -2,52 +2,99 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmDefinitions.h"
 
+#include "cmSystemTools.h"
+
 #include <assert.h>
 #include <set>
 #include <utility>
 
 cmDefinitions::Def cmDefinitions::NoDef;
+cmDefinitions::SymbolMapType cmDefinitions::Symbols;
+std::vector<std::string const*> cmDefinitions::SymbolNames;
+
+bool cmDefinitions::FindSymbol(const std::string& key, Symbol& sym)
+{
+  SymbolMapType::const_iterator i = cmDefinitions::Symbols.find(key);
+  if (i == cmDefinitions::Symbols.end()) {
+    return false;
+  }
+  sym = i->second;
+  return true;
+}
 
-cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
-                                                     StackIter begin,
-                                                     StackIter end, bool raise)
+cmDefinitions::Symbol cmDefinitions::Intern(const std::string& key)
+{
+  std::pair<SymbolMapType::iterator, bool> i =
+    cmDefinitions::Symbols.insert(SymbolMapType::value_type(
+      key, static_cast<Symbol>(cmDefinitions::SymbolNames.size())));
+  if (i.second) {
+    cmDefinitions::SymbolNames.push_back(&i.first->first);
+  }
+  return i.first->second;
+}
+
+cmDefinitions::Def& cmDefinitions::GetInternal(Symbol sym, StackIter begin,
+                                               StackIter end, bool raise)
 {
   assert(begin != end);
-  MapType::iterator i = begin->Map.find(key);
+  MapType::iterator i = begin->Map.find(sym);
   if (i != begin->Map.end()) {
     i->second.Used = true;
     return i->second;
   }
+  Def& def = cmDefinitions::GetOuter(sym, begin, end);
+  if (!raise) {
+    return def;
+  }
+  begin->Found.erase(sym);
+  return begin->Map.insert(MapType::value_type(sym, def)).first->second;
+}
+
+cmDefinitions::Def& cmDefinitions::GetOuter(Symbol sym, StackIter begin,
+                                            StackIter end)
+{
   StackIter it = begin;
   ++it;
   if (it == end) {
     return cmDefinitions::NoDef;
   }
-  Def const& def = cmDefinitions::GetInternal(key, it, end, raise);
-  if (!raise) {
-    return def;
+  FoundType::iterator fi = begin->Found.find(sym);
+  if (fi == begin->Found.end()) {
+    Def* def = &cmDefinitions::GetInternal(sym, it, end, false);
+    return *begin->Found.insert(FoundType::value_type(sym, def)).first->second;
+  }
+  if (fi->second != &cmDefinitions::NoDef) {
+    fi->second->Used = true;
   }
-  return begin->Map.insert(MapType::value_type(key, def)).first->second;
+  return *fi->second;
 }
 
 const char* cmDefinitions::Get(const std::string& key, StackIter begin,
                                StackIter end)
 {
-  Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
+  Symbol sym;
+  if (!cmDefinitions::FindSymbol(key, sym)) {
+    return CM_NULLPTR;
+  }
+  Def const& def = cmDefinitions::GetInternal(sym, begin, end, false);
   return def.Exists ? def.c_str() : CM_NULLPTR;
 }
 
 void cmDefinitions::Raise(const std::string& key, StackIter begin,
                           StackIter end)
 {
-  cmDefinitions::GetInternal(key, begin, end, true);
+  cmDefinitions::GetInternal(cmDefinitions::Intern(key), begin, end, true);
 }
 
 bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
                            StackIter end)
 {
+  Symbol sym;
+  if (!cmDefinitions::FindSymbol(key, sym)) {
+    return false;
+  }
   for (StackIter it = begin; it != end; ++it) {
-    MapType::const_iterator i = it->Map.find(key);
+    MapType::const_iterator i = it->Map.find(sym);
     if (i != it->Map.end()) {
       return true;
     }
@@ -55,10 +102,75 @@ bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
   return false;
 }
 
+void cmDefinitions::Def::SplitElements(const char* value, size_t first) const
+{
+  // Split the value starting with the last element, which is still open.
+  if (this->Elements[first].empty()) {
+    --this->EmptyElements;
+  }
+  cmSystemTools::SplitListArgument(value, this->Elements, this->Nesting);
+  for (size_t i = first; i < this->Elements.size(); ++i) {
+    if (this->Elements[i].empty()) {
+      ++this->EmptyElements;
+    }
+  }
+}
+
+std::vector<std::string> const* cmDefinitions::GetList(const std::string& key,
+                                                       StackIter begin,
+                                                       StackIter end,
+                                                       size_t& emptyElements)
+{
+  Symbol sym;
+  if (!cmDefinitions::FindSymbol(key, sym)) {
+    return CM_NULLPTR;
+  }
+  Def const& def = cmDefinitions::GetInternal(sym, begin, end, false);
+  if (!def.Exists) {
+    return CM_NULLPTR;
+  }
+  if (!def.HaveElements) {
+    def.Elements.assign(1, std::string());
+    def.EmptyElements = 1;
+    def.Nesting = 0;
+    def.SplitElements(def.c_str(), 0);
+    def.HaveElements = true;
+  }
+  emptyElements = def.EmptyElements;
+  return &def.Elements;
+}
+
+bool cmDefinitions::Append(const std::string& key, const char* value,
+                           StackIter begin, StackIter end)
+{
+  Symbol sym;
+  if (!cmDefinitions::FindSymbol(key, sym) ||
+      !cmDefinitions::GetInternal(sym, begin, end, false).Exists) {
+    return false;
+  }
+  Def& def = cmDefinitions::GetInternal(sym, begin, end, true);
+
+  // Keep splitting the elements where they end unless an escape at the
+  // end of the old value would apply to the new one.
+  if (def.HaveElements) {
+    if (!def.empty() && *def.rbegin() == '\\') {
+      def.HaveElements = false;
+      def.Elements.clear();
+    } else {
+      def.SplitElements(value, def.Elements.size() - 1);
+    }
+  }
+  def.append(value);
+  def.Used = false;
+  return true;
+}
+
 void cmDefinitions::Set(const std::string& key, const char* value)
 {
+  Symbol sym = cmDefinitions::Intern(key);
   Def def(value);
-  this->Map[key] = def;
+  this->Map[sym] = def;
+  this->Found.erase(sym);
 }
 
 std::vector<std::string> cmDefinitions::UnusedKeys() const
@@ -69,7 +181,7 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
   for (MapType::const_iterator mi = this->Map.begin(); mi != this->Map.end();
        ++mi) {
     if (!mi->second.Used) {
-      keys.push_back(mi->first);
+      keys.push_back(*cmDefinitions::SymbolNames[mi->first]);
     }
   }
   return keys;
@@ -78,7 +190,7 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
 cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 {
   cmDefinitions closure;
-  std::set<std::string> undefined;
+  std::set<Symbol> undefined;
   for (StackIter it = begin; it != end; ++it) {
     // Consider local definitions.
     for (MapType::const_iterator mi = it->Map.begin(); mi != it->Map.end();
@@ -100,7 +212,7 @@ cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
                                                     StackIter end)
 {
-  std::set<std::string> bound;
+  std::set<Symbol> bound;
   std::vector<std::string> defined;
 
   for (StackIter it = begin; it != end; ++it) {
@@ -109,7 +221,7 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
          ++mi) {
       // Use this key if it is not already set or unset.
       if (bound.insert(mi->first).second && mi->second.Exists) {
-        defined.push_back(mi->first);
+        defined.push_back(*cmDefinitions::SymbolNames[mi->first]);
       }
     }
   }
@@ -16,13 +16,33 @@
  *
  * This stores the state of variable definitions (set or unset) for
  * one scope.  Sets are always local.  Gets search parent scopes
- * transitively and save results locally.
+ * transitively and remember where they found the key.
+ *
+ * Keys are interned so that each scope is searched by a symbol and the
+ * name is hashed once per lookup.  Only the innermost scope of a stack
+ * gains keys, or its parent after the innermost scope localized them
+ * for PARENT_SCOPE, so a key found in a parent scope stays the one
+ * visible from the scopes inside it for as long as they exist.
  */
 class cmDefinitions
 {
   typedef cmLinkedTree<cmDefinitions>::iterator StackIter;
 
 public:
+  cmDefinitions() {}
+
+  // Copies do not keep where keys were found in the scopes they are in.
+  cmDefinitions(cmDefinitions const& other)
+    : Map(other.Map)
+  {
+  }
+  cmDefinitions& operator=(cmDefinitions const& other)
+  {
+    this->Map = other.Map;
+    this->Found.clear();
+    return *this;
+  }
+
   static const char* Get(const std::string& key, StackIter begin,
                          StackIter end);
 
@@ -30,6 +50,23 @@ public:
 
   static bool HasKey(const std::string& key, StackIter begin, StackIter end);
 
+  /**
+   * Get the value of a key split into list elements, empty ones included,
+   * or null if the key is not defined.  The elements are kept with the
+   * value until it changes.
+   */
+  static std::vector<std::string> const* GetList(const std::string& key,
+                                                 StackIter begin,
+                                                 StackIter end,
+                                                 size_t& emptyElements);
+
+  /**
+   * Append to the value of a key, localizing it in the first scope.
+   * Returns false without a change if the key is not defined.
+   */
+  static bool Append(const std::string& key, const char* value,
+                     StackIter begin, StackIter end);
+
   /** Set (or unset if null) a value associated with a key.  */
   void Set(const std::string& key, const char* value);
 
@@ -51,36 +88,72 @@ private:
       : std_string()
       , Exists(false)
       , Used(false)
+      , HaveElements(false)
     {
     }
     Def(const char* v)
       : std_string(v ? v : "")
       , Exists(v ? true : false)
       , Used(false)
+      , HaveElements(false)
     {
     }
     Def(const std_string& v)
       : std_string(v)
       , Exists(true)
       , Used(false)
+      , HaveElements(false)
     {
     }
+    // Copies split their value again if needed.
     Def(Def const& d)
       : std_string(d)
       , Exists(d.Exists)
       , Used(d.Used)
+      , HaveElements(false)
     {
     }
+    Def& operator=(Def const& d)
+    {
+      this->std_string::operator=(d);
+      this->Exists = d.Exists;
+      this->Used = d.Used;
+      this->HaveElements = false;
+      this->Elements.clear();
+      return *this;
+    }
     bool Exists;
     bool Used;
+
+    // The value split as a list on first use, the number of empty
+    // elements, and the depth of square brackets at the end of the value.
+    mutable bool HaveElements;
+    mutable std::vector<std::string> Elements;
+    mutable size_t EmptyElements;
+    mutable int Nesting;
+
+    void SplitElements(const char* value, size_t first) const;
   };
   static Def NoDef;
 
-  typedef CM_UNORDERED_MAP<std::string, Def> MapType;
+  typedef unsigned int Symbol;
+  typedef CM_UNORDERED_MAP<std::string, Symbol> SymbolMapType;
+  static SymbolMapType Symbols;
+  static std::vector<std::string const*> SymbolNames;
+
+  static bool FindSymbol(const std::string& key, Symbol& sym);
+  static Symbol Intern(const std::string& key);
+
+  typedef CM_UNORDERED_MAP<Symbol, Def> MapType;
   MapType Map;
 
-  static Def const& GetInternal(const std::string& key, StackIter begin,
-                                StackIter end, bool raise);
+  // The definitions of keys found in the parent scopes.
+  typedef CM_UNORDERED_MAP<Symbol, Def*> FoundType;
+  FoundType Found;
+
+  static Def& GetInternal(Symbol sym, StackIter begin, StackIter end,
+                          bool raise);
+  static Def& GetOuter(Symbol sym, StackIter begin, StackIter end);
 };
 
 #endif
@@ -52,6 +52,7 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
     std::string const& obj = *si++;
     dependencies[obj].insert(src);
   }
+  this->PrepareDependencies(dependencies);
   for (std::map<std::string, std::set<std::string> >::const_iterator it =
          dependencies.begin();
        it != dependencies.end(); ++it) {
@@ -66,6 +67,11 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
   return this->Finalize(makeDepends, internalDepends);
 }
 
+void cmDepends::PrepareDependencies(
+  const std::map<std::string, std::set<std::string> >& /*unused*/)
+{
+}
+
 bool cmDepends::Finalize(std::ostream& /*unused*/, std::ostream& /*unused*/)
 {
   return true;
@@ -75,6 +75,11 @@ public:
   }
 
 protected:
+  // Look at the sources of all the object files before their
+  // dependencies are written one at a time.
+  virtual void PrepareDependencies(
+    const std::map<std::string, std::set<std::string> >& dependencies);
+
   // Write dependencies for the target file to the given stream.
   // Return true for success and false for failure.
   virtual bool WriteDependencies(const std::set<std::string>& sources,
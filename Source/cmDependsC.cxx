@@ -8,8 +8,16 @@
 #include "cmMakefile.h"
 #include "cmOutputConverter.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
+#ifdef CMAKE_BUILD_WITH_CMAKE
+#include "cmCryptoHash.h"
+#endif
+
+#include <cmsys/Directory.hxx>
 #include <cmsys/FStream.hxx>
+#include <queue>
+#include <sstream>
 #include <utility>
 
 #define INCLUDE_REGEX_LINE                                                    \
@@ -20,9 +28,48 @@
 #define INCLUDE_REGEX_COMPLAIN_MARKER "#IncludeRegexComplain: "
 #define INCLUDE_REGEX_TRANSFORM_MARKER "#IncludeRegexTransform: "
 
+// Starting threads costs more than scanning a few objects takes, and
+// more threads than this contend for the caches more than they help.
+#define MAX_SCAN_THREADS 8
+
+static std::string cmDependsCSharedCacheDir(std::string const& binaryDir)
+{
+  return binaryDir + cmake::GetCMakeFilesDirectory() + "/IncludeCache";
+}
+
+// Read the name of the header from a shared cache entry.  The entry is
+// valid for it if it was written after the header was last modified and
+// the size of the header did not change.  The name may be relative to
+// the top of the build tree, in which the scanner runs.
+static bool cmDependsCSharedCacheValid(std::string const& cacheFile,
+                                       std::istream& fin,
+                                       std::string& fullName,
+                                       std::string const& binaryDir)
+{
+  if (!cmSystemTools::GetLineFromStream(fin, fullName)) {
+    return false;
+  }
+  std::string const path =
+    cmSystemTools::CollapseFullPath(fullName, binaryDir);
+  std::ostringstream size;
+  size << cmSystemTools::FileLength(path);
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(fin, line) || line != size.str()) {
+    return false;
+  }
+  int newer = 0;
+  cmFileTimeComparison comp;
+  return comp.FileTimeCompare(cacheFile.c_str(), path.c_str(), &newer) &&
+    newer == 1;
+}
+
 cmDependsC::cmDependsC()
   : ValidDeps(CM_NULLPTR)
 {
+#ifdef CMAKE_USE_LIBUV
+  this->NextScanJob = 0;
+  this->Threaded = false;
+#endif
 }
 
 cmDependsC::cmDependsC(
@@ -54,9 +101,9 @@ cmDependsC::cmDependsC(
     }
   }
 
-  this->IncludeRegexLine.compile(INCLUDE_REGEX_LINE);
-  this->IncludeRegexScan.compile(scanRegex.c_str());
-  this->IncludeRegexComplain.compile(complainRegex.c_str());
+  this->Regex.Line.compile(INCLUDE_REGEX_LINE);
+  this->Regex.Scan.compile(scanRegex.c_str());
+  this->Regex.Complain.compile(complainRegex.c_str());
   this->IncludeRegexLineString = INCLUDE_REGEX_LINE_MARKER INCLUDE_REGEX_LINE;
   this->IncludeRegexScanString = INCLUDE_REGEX_SCAN_MARKER;
   this->IncludeRegexScanString += scanRegex;
@@ -71,6 +118,21 @@ cmDependsC::cmDependsC(
   this->CacheFileName += ".includecache";
 
   this->ReadCacheFile();
+
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  // Complaining about missing headers does not change the include lines
+  // of a header so the complain regex is not part of the key.
+  this->SharedCacheDir = cmDependsCSharedCacheDir(lg->GetBinaryDirectory());
+  this->SharedCacheKey = this->IncludeRegexLineString + "\n" +
+    this->IncludeRegexScanString + "\n" + this->IncludeRegexTransformString +
+    "\n";
+  cmSystemTools::MakeDirectory(this->SharedCacheDir.c_str());
+#endif
+
+#ifdef CMAKE_USE_LIBUV
+  this->NextScanJob = 0;
+  this->Threaded = false;
+#endif
 }
 
 cmDependsC::~cmDependsC()
@@ -79,6 +141,109 @@ cmDependsC::~cmDependsC()
   cmDeleteAll(this->FileCache);
 }
 
+void cmDependsC::PrepareDependencies(
+  const std::map<std::string, std::set<std::string> >& dependencies)
+{
+#ifdef CMAKE_USE_LIBUV
+  // Scan the objects whose dependencies are not known yet in parallel.
+  for (std::map<std::string, std::set<std::string> >::const_iterator it =
+         dependencies.begin();
+       it != dependencies.end(); ++it) {
+    if (this->ValidDeps == CM_NULLPTR ||
+        this->ValidDeps->find(it->first) == this->ValidDeps->end()) {
+      ScanJob job;
+      job.Sources = &it->second;
+      job.Result = &this->Prescanned[it->first];
+      job.Result->Okay = false;
+      this->ScanJobs.push_back(job);
+    }
+  }
+
+  // The CMAKE_DEPENDS_SCAN_THREADS environment variable may choose
+  // another number of threads than there are processors.
+  size_t threadCount = 1;
+  std::string threadsEnv;
+  if (cmSystemTools::GetEnv("CMAKE_DEPENDS_SCAN_THREADS", threadsEnv)) {
+    unsigned long count;
+    if (cmSystemTools::StringToULong(threadsEnv.c_str(), &count)) {
+      threadCount = count;
+    }
+  } else {
+    uv_cpu_info_t* cpus;
+    int cpuCount;
+    if (uv_cpu_info(&cpus, &cpuCount) == 0) {
+      uv_free_cpu_info(cpus, cpuCount);
+      threadCount = cpuCount > 1 ? static_cast<size_t>(cpuCount) : 1;
+    }
+  }
+  if (threadCount > MAX_SCAN_THREADS) {
+    threadCount = MAX_SCAN_THREADS;
+  }
+  if (threadCount < 2 || this->ScanJobs.size() < threadCount) {
+    // Scan the objects one at a time as their dependencies are written.
+    this->Prescanned.clear();
+    this->ScanJobs.clear();
+    return;
+  }
+
+  // This thread scans objects too.
+  uv_mutex_init(&this->CacheMutex);
+  this->Threaded = true;
+  std::vector<uv_thread_t> threads(threadCount - 1);
+  for (std::vector<uv_thread_t>::iterator ti = threads.begin();
+       ti != threads.end(); ++ti) {
+    uv_thread_create(&*ti, &cmDependsC::ScanThread, this);
+  }
+  cmDependsC::ScanThread(this);
+  for (std::vector<uv_thread_t>::iterator ti = threads.begin();
+       ti != threads.end(); ++ti) {
+    uv_thread_join(&*ti);
+  }
+  this->Threaded = false;
+  uv_mutex_destroy(&this->CacheMutex);
+  this->ScanJobs.clear();
+#else
+  static_cast<void>(dependencies);
+#endif
+}
+
+#ifdef CMAKE_USE_LIBUV
+void cmDependsC::ScanThread(void* arg)
+{
+  cmDependsC* self = static_cast<cmDependsC*>(arg);
+  IncludeRegex rx = self->Regex;
+  for (;;) {
+    uv_mutex_lock(&self->CacheMutex);
+    size_t const next = self->NextScanJob++;
+    uv_mutex_unlock(&self->CacheMutex);
+    if (next >= self->ScanJobs.size()) {
+      break;
+    }
+    ScanJob const& job = self->ScanJobs[next];
+    job.Result->Okay = self->ScanObject(
+      *job.Sources, rx, job.Result->Dependencies, job.Result->Missing);
+  }
+}
+#endif
+
+void cmDependsC::LockCaches()
+{
+#ifdef CMAKE_USE_LIBUV
+  if (this->Threaded) {
+    uv_mutex_lock(&this->CacheMutex);
+  }
+#endif
+}
+
+void cmDependsC::UnlockCaches()
+{
+#ifdef CMAKE_USE_LIBUV
+  if (this->Threaded) {
+    uv_mutex_unlock(&this->CacheMutex);
+  }
+#endif
+}
+
 bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
                                    const std::string& obj,
                                    std::ostream& makeDepends,
@@ -106,123 +271,22 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
     }
   }
 
+  std::string missing;
   if (!haveDeps) {
-    // Walk the dependency graph starting with the source file.
-    int srcFiles = (int)sources.size();
-    this->Encountered.clear();
-
-    for (std::set<std::string>::const_iterator srcIt = sources.begin();
-         srcIt != sources.end(); ++srcIt) {
-      UnscannedEntry root;
-      root.FileName = *srcIt;
-      this->Unscanned.push(root);
-      this->Encountered.insert(*srcIt);
+    std::map<std::string, ScanResult>::iterator pi =
+      this->Prescanned.find(obj);
+    bool okay;
+    if (pi != this->Prescanned.end()) {
+      dependencies.swap(pi->second.Dependencies);
+      missing = pi->second.Missing;
+      okay = pi->second.Okay;
+      this->Prescanned.erase(pi);
+    } else {
+      okay = this->ScanObject(sources, this->Regex, dependencies, missing);
     }
-
-    std::set<std::string> scanned;
-
-    // Use reserve to allocate enough memory for tempPathStr
-    // so that during the loops no memory is allocated or freed
-    std::string tempPathStr;
-    tempPathStr.reserve(4 * 1024);
-
-    while (!this->Unscanned.empty()) {
-      // Get the next file to scan.
-      UnscannedEntry current = this->Unscanned.front();
-      this->Unscanned.pop();
-
-      // If not a full path, find the file in the include path.
-      std::string fullName;
-      if ((srcFiles > 0) ||
-          cmSystemTools::FileIsFullPath(current.FileName.c_str())) {
-        if (cmSystemTools::FileExists(current.FileName.c_str(), true)) {
-          fullName = current.FileName;
-        }
-      } else if (!current.QuotedLocation.empty() &&
-                 cmSystemTools::FileExists(current.QuotedLocation.c_str(),
-                                           true)) {
-        // The include statement producing this entry was a double-quote
-        // include and the included file is present in the directory of
-        // the source containing the include statement.
-        fullName = current.QuotedLocation;
-      } else {
-        std::map<std::string, std::string>::iterator headerLocationIt =
-          this->HeaderLocationCache.find(current.FileName);
-        if (headerLocationIt != this->HeaderLocationCache.end()) {
-          fullName = headerLocationIt->second;
-        } else {
-          for (std::vector<std::string>::const_iterator i =
-                 this->IncludePath.begin();
-               i != this->IncludePath.end(); ++i) {
-            // Construct the name of the file as if it were in the current
-            // include directory.  Avoid using a leading "./".
-
-            tempPathStr =
-              cmSystemTools::CollapseCombinedPath(*i, current.FileName);
-
-            // Look for the file in this location.
-            if (cmSystemTools::FileExists(tempPathStr.c_str(), true)) {
-              fullName = tempPathStr;
-              HeaderLocationCache[current.FileName] = fullName;
-              break;
-            }
-          }
-        }
-      }
-
-      // Complain if the file cannot be found and matches the complain
-      // regex.
-      if (fullName.empty() &&
-          this->IncludeRegexComplain.find(current.FileName.c_str())) {
-        cmSystemTools::Error("Cannot find file \"", current.FileName.c_str(),
-                             "\".");
-        return false;
-      }
-
-      // Scan the file if it was found and has not been scanned already.
-      if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
-        // Record scanned files.
-        scanned.insert(fullName);
-
-        // Check whether this file is already in the cache
-        std::map<std::string, cmIncludeLines*>::iterator fileIt =
-          this->FileCache.find(fullName);
-        if (fileIt != this->FileCache.end()) {
-          fileIt->second->Used = true;
-          dependencies.insert(fullName);
-          for (std::vector<UnscannedEntry>::const_iterator incIt =
-                 fileIt->second->UnscannedEntries.begin();
-               incIt != fileIt->second->UnscannedEntries.end(); ++incIt) {
-            if (this->Encountered.find(incIt->FileName) ==
-                this->Encountered.end()) {
-              this->Encountered.insert(incIt->FileName);
-              this->Unscanned.push(*incIt);
-            }
-          }
-        } else {
-
-          // Try to scan the file.  Just leave it out if we cannot find
-          // it.
-          cmsys::ifstream fin(fullName.c_str());
-          if (fin) {
-            cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
-            if (bom == cmsys::FStream::BOM_None ||
-                bom == cmsys::FStream::BOM_UTF8) {
-              // Add this file as a dependency.
-              dependencies.insert(fullName);
-
-              // Scan this file for new dependencies.  Pass the directory
-              // containing the file to handle double-quote includes.
-              std::string dir = cmSystemTools::GetFilenamePath(fullName);
-              this->Scan(fin, dir.c_str(), fullName);
-            } else {
-              // Skip file with encoding we do not implement.
-            }
-          }
-        }
-      }
-
-      srcFiles--;
+    if (!okay) {
+      cmSystemTools::Error("Cannot find file \"", missing.c_str(), "\".");
+      return false;
     }
   }
 
@@ -249,6 +313,160 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   return true;
 }
 
+bool cmDependsC::ScanObject(const std::set<std::string>& sources,
+                            IncludeRegex& rx,
+                            std::set<std::string>& dependencies,
+                            std::string& missing)
+{
+  // Walk the dependency graph starting with the source file.
+  int srcFiles = (int)sources.size();
+  std::set<std::string> encountered;
+  std::queue<UnscannedEntry> unscanned;
+
+  for (std::set<std::string>::const_iterator srcIt = sources.begin();
+       srcIt != sources.end(); ++srcIt) {
+    UnscannedEntry root;
+    root.FileName = *srcIt;
+    unscanned.push(root);
+    encountered.insert(*srcIt);
+  }
+
+  std::set<std::string> scanned;
+
+  // Use reserve to allocate enough memory for tempPathStr
+  // so that during the loops no memory is allocated or freed
+  std::string tempPathStr;
+  tempPathStr.reserve(4 * 1024);
+
+  while (!unscanned.empty()) {
+    // Get the next file to scan.
+    UnscannedEntry current = unscanned.front();
+    unscanned.pop();
+
+    // If not a full path, find the file in the include path.
+    std::string fullName;
+    if ((srcFiles > 0) ||
+        cmSystemTools::FileIsFullPath(current.FileName.c_str())) {
+      if (cmSystemTools::FileExists(current.FileName.c_str(), true)) {
+        fullName = current.FileName;
+      }
+    } else if (!current.QuotedLocation.empty() &&
+               cmSystemTools::FileExists(current.QuotedLocation.c_str(),
+                                         true)) {
+      // The include statement producing this entry was a double-quote
+      // include and the included file is present in the directory of
+      // the source containing the include statement.
+      fullName = current.QuotedLocation;
+    } else {
+      this->LockCaches();
+      std::map<std::string, std::string>::iterator headerLocationIt =
+        this->HeaderLocationCache.find(current.FileName);
+      bool const haveLocation =
+        headerLocationIt != this->HeaderLocationCache.end();
+      if (haveLocation) {
+        fullName = headerLocationIt->second;
+      }
+      this->UnlockCaches();
+      if (!haveLocation) {
+        for (std::vector<std::string>::const_iterator i =
+               this->IncludePath.begin();
+             i != this->IncludePath.end(); ++i) {
+          // Construct the name of the file as if it were in the current
+          // include directory.  Avoid using a leading "./".
+
+          tempPathStr =
+            cmSystemTools::CollapseCombinedPath(*i, current.FileName);
+
+          // Look for the file in this location.
+          if (cmSystemTools::FileExists(tempPathStr.c_str(), true)) {
+            fullName = tempPathStr;
+            this->LockCaches();
+            this->HeaderLocationCache[current.FileName] = fullName;
+            this->UnlockCaches();
+            break;
+          }
+        }
+      }
+    }
+
+    // Complain if the file cannot be found and matches the complain
+    // regex.
+    if (fullName.empty() && rx.Complain.find(current.FileName.c_str())) {
+      missing = current.FileName;
+      return false;
+    }
+
+    // Scan the file if it was found and has not been scanned already.
+    if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
+      // Record scanned files.
+      scanned.insert(fullName);
+
+      // Check whether this file is already in the cache
+      this->LockCaches();
+      std::map<std::string, cmIncludeLines*>::iterator fileIt =
+        this->FileCache.find(fullName);
+      bool const cached = fileIt != this->FileCache.end();
+      cmIncludeLines* lines = CM_NULLPTR;
+      if (cached) {
+        lines = fileIt->second;
+        lines->Used = true;
+      }
+      this->UnlockCaches();
+
+      if (!lines) {
+        // Another target may have scanned the file already.
+        lines = this->ReadSharedCache(fullName);
+      }
+      if (!lines) {
+        // Try to scan the file.  Just leave it out if we cannot find
+        // it.
+        cmsys::ifstream fin(fullName.c_str());
+        if (fin) {
+          cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
+          if (bom == cmsys::FStream::BOM_None ||
+              bom == cmsys::FStream::BOM_UTF8) {
+            // Scan this file for new dependencies.  Pass the directory
+            // containing the file to handle double-quote includes.
+            std::string dir = cmSystemTools::GetFilenamePath(fullName);
+            lines = this->Scan(fin, dir.c_str(), rx);
+            this->WriteSharedCache(fullName, *lines);
+          } else {
+            // Skip file with encoding we do not implement.
+          }
+        }
+      }
+      if (lines && !cached) {
+        lines->Used = true;
+        this->LockCaches();
+        std::pair<std::map<std::string, cmIncludeLines*>::iterator, bool>
+          added = this->FileCache.insert(std::make_pair(fullName, lines));
+        this->UnlockCaches();
+        if (!added.second) {
+          // Another thread scanned the same file meanwhile.
+          delete lines;
+          lines = added.first->second;
+        }
+      }
+
+      if (lines) {
+        // Add this file as a dependency.
+        dependencies.insert(fullName);
+        for (std::vector<UnscannedEntry>::const_iterator incIt =
+               lines->UnscannedEntries.begin();
+             incIt != lines->UnscannedEntries.end(); ++incIt) {
+          if (encountered.find(incIt->FileName) == encountered.end()) {
+            encountered.insert(incIt->FileName);
+            unscanned.push(*incIt);
+          }
+        }
+      }
+    }
+
+    srcFiles--;
+  }
+  return true;
+}
+
 void cmDependsC::ReadCacheFile()
 {
   if (this->CacheFileName.empty()) {
@@ -352,28 +570,147 @@ void cmDependsC::WriteCacheFile() const
   }
 }
 
-void cmDependsC::Scan(std::istream& is, const char* directory,
-                      const std::string& fullName)
+std::string cmDependsC::GetSharedCacheFile(std::string const& fullName) const
+{
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  if (!this->SharedCacheDir.empty()) {
+    cmCryptoHashMD5 md5;
+    return this->SharedCacheDir + "/" +
+      md5.HashString(this->SharedCacheKey + fullName);
+  }
+#else
+  static_cast<void>(fullName);
+#endif
+  return std::string();
+}
+
+cmDependsC::cmIncludeLines* cmDependsC::ReadSharedCache(
+  std::string const& fullName) const
+{
+  std::string const cacheFile = this->GetSharedCacheFile(fullName);
+  if (cacheFile.empty()) {
+    return CM_NULLPTR;
+  }
+  cmsys::ifstream fin(cacheFile.c_str());
+  if (!fin) {
+    return CM_NULLPTR;
+  }
+
+  std::string line;
+  std::string const binaryDir = this->LocalGenerator->GetBinaryDirectory();
+  if (!cmDependsCSharedCacheValid(cacheFile, fin, line, binaryDir) ||
+      line != fullName) {
+    return CM_NULLPTR;
+  }
+
+  cmIncludeLines* entries = new cmIncludeLines;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    UnscannedEntry entry;
+    entry.FileName = line;
+    if (!cmSystemTools::GetLineFromStream(fin, line)) {
+      break;
+    }
+    if (line != "-") {
+      entry.QuotedLocation = line;
+    }
+    entries->UnscannedEntries.push_back(entry);
+  }
+  return entries;
+}
+
+void cmDependsC::WriteSharedCache(std::string const& fullName,
+                                  cmIncludeLines const& lines) const
+{
+  std::string const cacheFile = this->GetSharedCacheFile(fullName);
+  if (cacheFile.empty()) {
+    return;
+  }
+
+  // Other processes may write the same entry at the same time so write
+  // it to a file of our own first and move that into place.
+  std::ostringstream tempFile;
+  tempFile << cacheFile << "." << std::hex << cmSystemTools::RandomSeed()
+           << ".tmp";
+  {
+    cmsys::ofstream cacheOut(tempFile.str().c_str());
+    if (!cacheOut) {
+      return;
+    }
+    cacheOut << fullName << "\n"
+             << cmSystemTools::FileLength(fullName) << "\n";
+    for (std::vector<UnscannedEntry>::const_iterator incIt =
+           lines.UnscannedEntries.begin();
+         incIt != lines.UnscannedEntries.end(); ++incIt) {
+      cacheOut << incIt->FileName << "\n";
+      if (incIt->QuotedLocation.empty()) {
+        cacheOut << "-\n";
+      } else {
+        cacheOut << incIt->QuotedLocation << "\n";
+      }
+    }
+  }
+  if (!cmSystemTools::RenameFile(tempFile.str().c_str(), cacheFile.c_str())) {
+    cmSystemTools::RemoveFile(tempFile.str());
+  }
+}
+
+void cmDependsC::PruneSharedCache(std::string const& binaryDir)
+{
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  std::string const dir = cmDependsCSharedCacheDir(binaryDir);
+  cmsys::Directory d;
+  if (!d.Load(dir)) {
+    return;
+  }
+  std::vector<std::string> stale;
+  for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
+    std::string const name = d.GetFile(i);
+    if (name == "." || name == "..") {
+      continue;
+    }
+    // Entries are named by a hash alone.  Anything else was left behind
+    // by a scan that did not get to move its entry into place.
+    std::string const cacheFile = dir + "/" + name;
+    if (name.find('.') == std::string::npos) {
+      cmsys::ifstream fin(cacheFile.c_str());
+      std::string fullName;
+      if (fin &&
+          cmDependsCSharedCacheValid(cacheFile, fin, fullName, binaryDir)) {
+        continue;
+      }
+    }
+    stale.push_back(cacheFile);
+  }
+  for (std::vector<std::string>::const_iterator si = stale.begin();
+       si != stale.end(); ++si) {
+    cmSystemTools::RemoveFile(*si);
+  }
+#else
+  static_cast<void>(binaryDir);
+#endif
+}
+
+cmDependsC::cmIncludeLines* cmDependsC::Scan(std::istream& is,
+                                             const char* directory,
+                                             IncludeRegex& rx)
 {
   cmIncludeLines* newCacheEntry = new cmIncludeLines;
-  newCacheEntry->Used = true;
-  this->FileCache[fullName] = newCacheEntry;
 
   // Read one line at a time.
   std::string line;
   while (cmSystemTools::GetLineFromStream(is, line)) {
     // Transform the line content first.
     if (!this->TransformRules.empty()) {
-      this->TransformLine(line);
+      this->TransformLine(line, rx);
     }
 
     // Match include directives.
-    if (this->IncludeRegexLine.find(line.c_str())) {
+    if (rx.Line.find(line.c_str())) {
       // Get the file being included.
       UnscannedEntry entry;
-      entry.FileName = this->IncludeRegexLine.match(2);
+      entry.FileName = rx.Line.match(2);
       cmSystemTools::ConvertToUnixSlashes(entry.FileName);
-      if (this->IncludeRegexLine.match(3) == "\"" &&
+      if (rx.Line.match(3) == "\"" &&
           !cmSystemTools::FileIsFullPath(entry.FileName.c_str())) {
         // This was a double-quoted include with a relative path.  We
         // must check for the file in the directory containing the
@@ -382,26 +719,22 @@ void cmDependsC::Scan(std::istream& is, const char* directory,
           cmSystemTools::CollapseCombinedPath(directory, entry.FileName);
       }
 
-      // Queue the file if it has not yet been encountered and it
-      // matches the regular expression for recursive scanning.  Note
-      // that this check does not account for the possibility of two
-      // headers with the same name in different directories when one
-      // is included by double-quotes and the other by angle brackets.
-      // It also does not work properly if two header files with the same
-      // name exist in different directories, and both are included from a
-      // file their own directory by simply using "filename.h" (#12619)
-      // This kind of problem will be fixed when a more
-      // preprocessor-like implementation of this scanner is created.
-      if (this->IncludeRegexScan.find(entry.FileName.c_str())) {
+      // Queue the file if it matches the regular expression for
+      // recursive scanning.  Note that this check does not account for
+      // the possibility of two headers with the same name in different
+      // directories when one is included by double-quotes and the other
+      // by angle brackets.  It also does not work properly if two header
+      // files with the same name exist in different directories, and
+      // both are included from a file their own directory by simply
+      // using "filename.h" (#12619) This kind of problem will be fixed
+      // when a more preprocessor-like implementation of this scanner is
+      // created.
+      if (rx.Scan.find(entry.FileName.c_str())) {
         newCacheEntry->UnscannedEntries.push_back(entry);
-        if (this->Encountered.find(entry.FileName) ==
-            this->Encountered.end()) {
-          this->Encountered.insert(entry.FileName);
-          this->Unscanned.push(entry);
-        }
       }
     }
   }
+  return newCacheEntry;
 }
 
 void cmDependsC::SetupTransforms()
@@ -430,7 +763,7 @@ void cmDependsC::SetupTransforms()
       sep = "|";
     }
     xform += ")[ \t]*\\(([^),]*)\\)";
-    this->IncludeRegexTransform.compile(xform.c_str());
+    this->Regex.Transform.compile(xform.c_str());
 
     // Build a string that encodes all transformation rules and will
     // change when rules are changed.
@@ -458,21 +791,21 @@ void cmDependsC::ParseTransform(std::string const& xform)
   this->TransformRules[name] = value;
 }
 
-void cmDependsC::TransformLine(std::string& line)
+void cmDependsC::TransformLine(std::string& line, IncludeRegex& rx)
 {
   // Check for a transform rule match.  Return if none.
-  if (!this->IncludeRegexTransform.find(line.c_str())) {
+  if (!rx.Transform.find(line.c_str())) {
     return;
   }
   TransformRulesType::const_iterator tri =
-    this->TransformRules.find(this->IncludeRegexTransform.match(3));
+    this->TransformRules.find(rx.Transform.match(3));
   if (tri == this->TransformRules.end()) {
     return;
   }
 
   // Construct the transformed line.
-  std::string newline = this->IncludeRegexTransform.match(1);
-  std::string arg = this->IncludeRegexTransform.match(4);
+  std::string newline = rx.Transform.match(1);
+  std::string arg = rx.Transform.match(4);
   for (const char* c = tri->second.c_str(); *c; ++c) {
     if (*c == '%') {
       newline += arg;
@@ -10,11 +10,15 @@
 #include <cmsys/RegularExpression.hxx>
 #include <iosfwd>
 #include <map>
-#include <queue>
 #include <set>
+#include <stddef.h>
 #include <string>
 #include <vector>
 
+#ifdef CMAKE_USE_LIBUV
+#include "cm_uv.h"
+#endif
+
 class cmLocalGenerator;
 
 /** \class cmDependsC
@@ -33,35 +37,46 @@ public:
   /** Virtual destructor to cleanup subclasses properly.  */
   ~cmDependsC() CM_OVERRIDE;
 
+  /** Remove the entries of the include lines shared by the targets of
+      a build tree that no longer match the header they were read from.
+      Entries of headers that changed or were removed are never read
+      again, so the generator drops them on each generate step.  */
+  static void PruneSharedCache(std::string const& binaryDir);
+
 protected:
   // Implement writing/checking methods required by superclass.
+  void PrepareDependencies(
+    const std::map<std::string, std::set<std::string> >& dependencies)
+    CM_OVERRIDE;
   bool WriteDependencies(const std::set<std::string>& sources,
                          const std::string& obj, std::ostream& makeDepends,
                          std::ostream& internalDepends) CM_OVERRIDE;
 
-  // Method to scan a single file.
-  void Scan(std::istream& is, const char* directory,
-            const std::string& fullName);
-
-  // Regular expression to identify C preprocessor include directives.
-  cmsys::RegularExpression IncludeRegexLine;
+  // Regular expressions used by one scanning thread.  Matching stores
+  // the match in the expression so threads cannot share them.
+  struct IncludeRegex
+  {
+    // Identify C preprocessor include directives.
+    cmsys::RegularExpression Line;
+    // Choose which include files to scan recursively and which to
+    // complain about not finding.
+    cmsys::RegularExpression Scan;
+    cmsys::RegularExpression Complain;
+    // Transform #include lines.
+    cmsys::RegularExpression Transform;
+  };
+  IncludeRegex Regex;
 
-  // Regular expressions to choose which include files to scan
-  // recursively and which to complain about not finding.
-  cmsys::RegularExpression IncludeRegexScan;
-  cmsys::RegularExpression IncludeRegexComplain;
   std::string IncludeRegexLineString;
   std::string IncludeRegexScanString;
   std::string IncludeRegexComplainString;
-
-  // Regex to transform #include lines.
   std::string IncludeRegexTransformString;
-  cmsys::RegularExpression IncludeRegexTransform;
+
   typedef std::map<std::string, std::string> TransformRulesType;
   TransformRulesType TransformRules;
   void SetupTransforms();
   void ParseTransform(std::string const& xform);
-  void TransformLine(std::string& line);
+  void TransformLine(std::string& line, IncludeRegex& rx);
 
 public:
   // Data structures for dependency graph walk.
@@ -82,9 +97,26 @@ public:
   };
 
 protected:
+  // Find the headers included by the sources of one object file.  Return
+  // false with the name of a header matching the complain regex that
+  // cannot be found.  This may run for several objects at once.
+  bool ScanObject(const std::set<std::string>& sources, IncludeRegex& rx,
+                  std::set<std::string>& dependencies, std::string& missing);
+
+  // Method to scan a single file.
+  cmIncludeLines* Scan(std::istream& is, const char* directory,
+                       IncludeRegex& rx);
+
   const std::map<std::string, DependencyVector>* ValidDeps;
-  std::set<std::string> Encountered;
-  std::queue<UnscannedEntry> Unscanned;
+
+  // The dependencies of the objects scanned by PrepareDependencies.
+  struct ScanResult
+  {
+    std::set<std::string> Dependencies;
+    std::string Missing;
+    bool Okay;
+  };
+  std::map<std::string, ScanResult> Prescanned;
 
   std::map<std::string, cmIncludeLines*> FileCache;
   std::map<std::string, std::string> HeaderLocationCache;
@@ -94,6 +126,31 @@ protected:
   void WriteCacheFile() const;
   void ReadCacheFile();
 
+  // The include lines of headers shared by all targets of the build tree
+  // through one file per header and set of regular expressions.
+  std::string SharedCacheDir;
+  std::string SharedCacheKey;
+  std::string GetSharedCacheFile(std::string const& fullName) const;
+  cmIncludeLines* ReadSharedCache(std::string const& fullName) const;
+  void WriteSharedCache(std::string const& fullName,
+                        cmIncludeLines const& lines) const;
+
+  // Guard the caches above while PrepareDependencies runs threads.
+  void LockCaches();
+  void UnlockCaches();
+#ifdef CMAKE_USE_LIBUV
+  struct ScanJob
+  {
+    const std::set<std::string>* Sources;
+    ScanResult* Result;
+  };
+  std::vector<ScanJob> ScanJobs;
+  size_t NextScanJob;
+  bool Threaded;
+  uv_mutex_t CacheMutex;
+  static void ScanThread(void* arg);
+#endif
+
 private:
   cmDependsC(cmDependsC const&);     // Purposely not implemented.
   void operator=(cmDependsC const&); // Purposely not implemented.
@@ -0,0 +1,148 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDependsCompiler.h"
+
+#include "cmLocalGenerator.h"
+#include "cmSystemTools.h"
+
+#include <cmsys/FStream.hxx>
+#include <utility>
+#include <vector>
+
+cmDependsCompiler::cmDependsCompiler(
+  cmLocalGenerator* lg,
+  const std::map<std::string, DependencyVector>* validDeps)
+  : cmDepends(lg)
+  , ValidDeps(validDeps)
+{
+}
+
+cmDependsCompiler::~cmDependsCompiler()
+{
+}
+
+void cmDependsCompiler::ParseDepfile(std::istream& is,
+                                     std::set<std::string>& deps)
+{
+  // The names on each logical line up to the one ending in a colon are
+  // the targets of a rule and the rest its prerequisites.  Lines with
+  // no colon at all, as some compilers write, list prerequisites only.
+  std::vector<std::string> names;
+  std::string name;
+  bool haveTargets = false;
+  char c;
+  for (;;) {
+    bool const more = is.get(c).good();
+    if (more && c == '\\') {
+      int next = is.peek();
+      if (next == ' ' || next == '#') {
+        name += static_cast<char>(is.get());
+        continue;
+      }
+      if (next == '\r') {
+        is.get();
+        next = is.peek();
+      }
+      if (next == '\n') {
+        // Continue the logical line.
+        is.get();
+        c = ' ';
+      }
+    } else if (more && c == '$' && is.peek() == '$') {
+      is.get();
+    }
+    if (more && c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+      name += c;
+      continue;
+    }
+    if (!name.empty()) {
+      if (!haveTargets && *name.rbegin() == ':') {
+        haveTargets = true;
+        names.clear();
+      } else {
+        names.push_back(name);
+      }
+      name.clear();
+    }
+    if (!more || c == '\n') {
+      deps.insert(names.begin(), names.end());
+      names.clear();
+      haveTargets = false;
+    }
+    if (!more) {
+      break;
+    }
+  }
+}
+
+bool cmDependsCompiler::WriteDependencies(
+  const std::set<std::string>& depfiles, const std::string& obj,
+  std::ostream& makeDepends, std::ostream& internalDepends)
+{
+  if (obj.empty()) {
+    cmSystemTools::Error("Cannot read dependencies without an object file.");
+    return false;
+  }
+
+  std::string binDir = this->LocalGenerator->GetBinaryDirectory();
+  std::string obj_i = this->LocalGenerator->ConvertToRelativePath(binDir, obj);
+
+  std::set<std::string> dependencies;
+  std::map<std::string, DependencyVector>::const_iterator valid;
+  if (this->ValidDeps != CM_NULLPTR &&
+      (valid = this->ValidDeps->find(obj_i)) != this->ValidDeps->end()) {
+    dependencies.insert(valid->second.begin(), valid->second.end());
+  } else {
+    // Each object has no dependency file until it was compiled once.
+    std::set<std::string> names;
+    for (std::set<std::string>::const_iterator di = depfiles.begin();
+         di != depfiles.end(); ++di) {
+      cmsys::ifstream fin(di->c_str());
+      if (fin) {
+        ParseDepfile(fin, names);
+      }
+    }
+
+    // The compiler names files relative to the directory it ran in.  A
+    // file that does not exist any more must not be written as make
+    // would fail to find a rule for it.  The object will be rebuilt
+    // anyway as cmDepends::Check removes objects missing a dependency.
+    std::string const compileDir =
+      this->LocalGenerator->GetCurrentBinaryDirectory();
+    for (std::set<std::string>::const_iterator ni = names.begin();
+         ni != names.end(); ++ni) {
+      std::map<std::string, std::string>::iterator fi =
+        this->FileCache.find(*ni);
+      if (fi == this->FileCache.end()) {
+        std::string dep = cmSystemTools::CollapseFullPath(*ni, compileDir);
+        if (!cmSystemTools::FileExists(dep.c_str())) {
+          dep.clear();
+        }
+        fi = this->FileCache.insert(std::make_pair(*ni, dep)).first;
+      }
+      if (!fi->second.empty()) {
+        dependencies.insert(fi->second);
+      }
+    }
+  }
+
+  // Write the dependencies to the output stream the way cmDependsC does.
+  std::string obj_m = cmSystemTools::ConvertToOutputPath(obj_i.c_str());
+  internalDepends << obj_i << std::endl;
+
+  for (std::set<std::string>::const_iterator i = dependencies.begin();
+       i != dependencies.end(); ++i) {
+    std::map<std::string, std::string>::iterator mi =
+      this->MakeFileCache.find(*i);
+    if (mi == this->MakeFileCache.end()) {
+      std::string dep_m = cmSystemTools::ConvertToOutputPath(
+        this->LocalGenerator->ConvertToRelativePath(binDir, *i).c_str());
+      mi = this->MakeFileCache.insert(std::make_pair(*i, dep_m)).first;
+    }
+    makeDepends << obj_m << ": " << mi->second << "\n";
+    internalDepends << " " << *i << "\n";
+  }
+  makeDepends << std::endl;
+
+  return true;
+}
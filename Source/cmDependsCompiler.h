@@ -0,0 +1,57 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDependsCompiler_h
+#define cmDependsCompiler_h
+
+#include <cmConfigure.h>
+
+#include "cmDepends.h"
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+
+class cmLocalGenerator;
+
+/** \class cmDependsCompiler
+ * \brief Dependencies of object files read from the compiler.
+ *
+ * cmDependsCompiler reads the Makefile-syntax dependency files written
+ * by the compiler while compiling each object file instead of scanning
+ * the sources itself.
+ */
+class cmDependsCompiler : public cmDepends
+{
+public:
+  /** Dependencies of objects found in validDeps are reused instead of
+      reading their dependency files again.  */
+  cmDependsCompiler(cmLocalGenerator* lg,
+                    const std::map<std::string, DependencyVector>* validDeps);
+
+  /** Virtual destructor to cleanup subclasses properly.  */
+  ~cmDependsCompiler() CM_OVERRIDE;
+
+  /** Parse the prerequisites of the rules in a dependency file.  */
+  static void ParseDepfile(std::istream& is, std::set<std::string>& deps);
+
+protected:
+  // Implement writing method required by superclass.
+  bool WriteDependencies(const std::set<std::string>& depfiles,
+                         const std::string& obj, std::ostream& makeDepends,
+                         std::ostream& internalDepends) CM_OVERRIDE;
+
+  const std::map<std::string, DependencyVector>* ValidDeps;
+
+  // Full paths of the files named in dependency files, empty for files
+  // that do not exist.  Most objects of a target share their headers.
+  std::map<std::string, std::string> FileCache;
+  // The files as written to the make depends file.
+  std::map<std::string, std::string> MakeFileCache;
+
+private:
+  cmDependsCompiler(cmDependsCompiler const&); // Purposely not implemented.
+  void operator=(cmDependsCompiler const&);    // Purposely not implemented.
+};
+
+#endif
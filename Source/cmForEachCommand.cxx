@@ -200,9 +200,12 @@ bool cmForEachCommand::HandleInMode(std::vector<std::string> const& args)
     } else if (args[i] == "ITEMS") {
       doing = DoingItems;
     } else if (doing == DoingLists) {
-      const char* value = this->Makefile->GetDefinition(args[i]);
-      if (value && *value) {
-        cmSystemTools::ExpandListArgument(value, f->Args, true);
+      std::vector<std::string> storage;
+      size_t emptyElements = 0;
+      std::vector<std::string> const* elements =
+        this->Makefile->GetDefinitionList(args[i], storage, emptyElements);
+      if (elements && !(elements->size() == 1 && emptyElements == 1)) {
+        f->Args.insert(f->Args.end(), elements->begin(), elements->end());
       }
     } else {
       std::ostringstream e;
@@ -12,14 +12,46 @@
 #include "cmState.h"
 #include "cmSystemTools.h"
 
+// The definition of a function shared by all copies of its command.
+// The command is copied for every call, but the body must persist so
+// that its arguments keep their tokens from one call to the next.
+class cmFunctionDefinition
+{
+public:
+  cmFunctionDefinition()
+    : RefCount(1)
+  {
+  }
+
+  void Register() { ++this->RefCount; }
+  void Unregister()
+  {
+    if (--this->RefCount == 0) {
+      delete this;
+    }
+  }
+
+  unsigned int RefCount;
+  std::vector<std::string> Args;
+  std::vector<cmListFileFunction> Functions;
+  cmPolicies::PolicyMap Policies;
+  std::string FilePath;
+
+private:
+  ~cmFunctionDefinition() {}
+};
+
 // define the class for function commands
 class cmFunctionHelperCommand : public cmCommand
 {
 public:
-  cmFunctionHelperCommand() {}
+  cmFunctionHelperCommand(cmFunctionDefinition* def)
+    : Definition(def)
+  {
+  }
 
   ///! clean up any memory allocated by the function
-  ~cmFunctionHelperCommand() CM_OVERRIDE {}
+  ~cmFunctionHelperCommand() CM_OVERRIDE { this->Definition->Unregister(); }
 
   /**
    * This determines if the command is defined in a cmake script.
@@ -31,13 +63,9 @@ public:
    */
   cmCommand* Clone() CM_OVERRIDE
   {
-    cmFunctionHelperCommand* newC = new cmFunctionHelperCommand;
-    // we must copy when we clone
-    newC->Args = this->Args;
-    newC->Functions = this->Functions;
-    newC->Policies = this->Policies;
-    newC->FilePath = this->FilePath;
-    return newC;
+    // the definition never changes so the copies share it
+    this->Definition->Register();
+    return new cmFunctionHelperCommand(this->Definition);
   }
 
   /**
@@ -61,33 +89,36 @@ public:
   /**
    * The name of the command as specified in CMakeList.txt.
    */
-  std::string GetName() const CM_OVERRIDE { return this->Args[0]; }
+  std::string GetName() const CM_OVERRIDE
+  {
+    return this->Definition->Args[0];
+  }
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  std::string FilePath;
+private:
+  cmFunctionDefinition* Definition;
 };
 
 bool cmFunctionHelperCommand::InvokeInitialPass(
   const std::vector<cmListFileArgument>& args, cmExecutionStatus& inStatus)
 {
+  cmFunctionDefinition const* def = this->Definition;
+
   // Expand the argument list to the function.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def->Args.size() - 1) {
     std::string errorMsg =
       "Function invoked with incorrect arguments for function named: ";
-    errorMsg += this->Args[0];
+    errorMsg += def->Args[0];
     this->SetError(errorMsg);
     return false;
   }
 
-  cmMakefile::FunctionPushPop functionScope(this->Makefile, this->FilePath,
-                                            this->Policies);
+  cmMakefile::FunctionPushPop functionScope(this->Makefile, def->FilePath,
+                                            def->Policies);
 
   // set the value of argc
   std::ostringstream strStream;
@@ -104,14 +135,14 @@ bool cmFunctionHelperCommand::InvokeInitialPass(
   }
 
   // define the formal arguments
-  for (unsigned int j = 1; j < this->Args.size(); ++j) {
-    this->Makefile->AddDefinition(this->Args[j], expandedArgs[j - 1].c_str());
+  for (unsigned int j = 1; j < def->Args.size(); ++j) {
+    this->Makefile->AddDefinition(def->Args[j], expandedArgs[j - 1].c_str());
   }
 
   // define ARGV and ARGN
   std::string argvDef = cmJoin(expandedArgs, ";");
   std::vector<std::string>::const_iterator eit =
-    expandedArgs.begin() + (this->Args.size() - 1);
+    expandedArgs.begin() + (def->Args.size() - 1);
   std::string argnDef = cmJoin(cmMakeRange(eit, expandedArgs.end()), ";");
   this->Makefile->AddDefinition("ARGV", argvDef.c_str());
   this->Makefile->MarkVariableAsUsed("ARGV");
@@ -120,9 +151,9 @@ bool cmFunctionHelperCommand::InvokeInitialPass(
 
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (unsigned int c = 0; c < this->Functions.size(); ++c) {
+  for (unsigned int c = 0; c < def->Functions.size(); ++c) {
     cmExecutionStatus status;
-    if (!this->Makefile->ExecuteCommand(this->Functions[c], status) ||
+    if (!this->Makefile->ExecuteCommand(def->Functions[c], status) ||
         status.GetNestedError()) {
       // The error message should have already included the call stack
       // so we do not need to report an error here.
@@ -150,11 +181,12 @@ bool cmFunctionFunctionBlocker::IsFunctionBlocked(
     // if this is the endfunction for this function then execute
     if (!this->Depth) {
       // create a new command and add it to cmake
-      cmFunctionHelperCommand* f = new cmFunctionHelperCommand();
-      f->Args = this->Args;
-      f->Functions = this->Functions;
-      f->FilePath = this->GetStartingContext().FilePath;
-      mf.RecordPolicies(f->Policies);
+      cmFunctionDefinition* def = new cmFunctionDefinition;
+      def->Args = this->Args;
+      def->Functions = this->Functions;
+      def->FilePath = this->GetStartingContext().FilePath;
+      mf.RecordPolicies(def->Policies);
+      cmFunctionHelperCommand* f = new cmFunctionHelperCommand(def);
 
       std::string newName = "_" + this->Args[0];
       mf.GetState()->RenameCommand(this->Args[0], newName);
@@ -10,9 +10,109 @@
 #include "cmGeneratorExpressionParser.h"
 #include "cmSystemTools.h"
 
+#include <cm_unordered_map.hxx>
 #include <cmsys/RegularExpression.hxx>
 #include <utility>
 
+namespace {
+// The evaluators parsed from the text of each generator expression
+// compiled in this process.  They do not change when evaluated, so
+// all expressions compiled from the same text share them.  Their
+// tokens point into the text kept as the key.  The compiled expressions
+// using them are counted so that they are kept while in use.
+struct ParsedExpression
+{
+  bool NeedsEvaluation;
+  unsigned long References;
+  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
+};
+
+class ParsedExpressionTable
+{
+public:
+  typedef CM_UNORDERED_MAP<std::string, ParsedExpression> MapType;
+  ParsedExpressionTable()
+    : Parsed(0)
+    , Shared(0)
+    , Plain(0)
+  {
+  }
+  ~ParsedExpressionTable()
+  {
+    for (MapType::iterator i = this->Expressions.begin();
+         i != this->Expressions.end(); ++i) {
+      cmDeleteAll(i->second.Evaluators);
+    }
+  }
+
+  std::vector<cmGeneratorExpressionEvaluator*> const* Get(
+    std::string const& input);
+  void Release(std::string const& input);
+  void Trim();
+
+  MapType Expressions;
+  unsigned long Parsed;
+  unsigned long Shared;
+  unsigned long Plain;
+};
+
+std::vector<cmGeneratorExpressionEvaluator*> const* ParsedExpressionTable::Get(
+  std::string const& input)
+{
+  // Most strings have no generator expression at all.
+  if (cmGeneratorExpression::Find(input) == std::string::npos) {
+    ++this->Plain;
+    return CM_NULLPTR;
+  }
+
+  MapType::iterator i = this->Expressions.find(input);
+  if (i != this->Expressions.end()) {
+    ++this->Shared;
+  } else {
+    ++this->Parsed;
+    ParsedExpression parsed;
+    parsed.NeedsEvaluation = false;
+    parsed.References = 0;
+    i = this->Expressions.insert(MapType::value_type(input, parsed)).first;
+
+    cmGeneratorExpressionLexer l;
+    std::vector<cmGeneratorExpressionToken> tokens = l.Tokenize(i->first);
+    i->second.NeedsEvaluation = l.GetSawGeneratorExpression();
+    if (i->second.NeedsEvaluation) {
+      cmGeneratorExpressionParser p(tokens);
+      p.Parse(i->second.Evaluators);
+    }
+  }
+  if (!i->second.NeedsEvaluation) {
+    return CM_NULLPTR;
+  }
+  ++i->second.References;
+  return &i->second.Evaluators;
+}
+
+void ParsedExpressionTable::Release(std::string const& input)
+{
+  MapType::iterator i = this->Expressions.find(input);
+  assert(i != this->Expressions.end() && i->second.References > 0);
+  --i->second.References;
+}
+
+void ParsedExpressionTable::Trim()
+{
+  MapType::iterator i = this->Expressions.begin();
+  while (i != this->Expressions.end()) {
+    if (i->second.References == 0) {
+      cmDeleteAll(i->second.Evaluators);
+      this->Expressions.erase(i++);
+    } else {
+      ++i;
+    }
+  }
+}
+
+ParsedExpressionTable ParsedExpressions;
+}
+
 cmGeneratorExpression::cmGeneratorExpression(
   const cmListFileBacktrace& backtrace)
   : Backtrace(backtrace)
@@ -70,9 +170,9 @@ const char* cmCompiledGeneratorExpression::EvaluateWithContext(
   this->Output = "";
 
   std::vector<cmGeneratorExpressionEvaluator*>::const_iterator it =
-    this->Evaluators.begin();
+    this->Evaluators->begin();
   const std::vector<cmGeneratorExpressionEvaluator*>::const_iterator end =
-    this->Evaluators.end();
+    this->Evaluators->end();
 
   for (; it != end; ++it) {
     this->Output += (*it)->Evaluate(&context, dagChecker);
@@ -102,24 +202,34 @@ const char* cmCompiledGeneratorExpression::EvaluateWithContext(
 cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
   cmListFileBacktrace const& backtrace, const std::string& input)
   : Backtrace(backtrace)
+  , Evaluators(ParsedExpressions.Get(input))
   , Input(input)
+  , NeedsEvaluation(Evaluators != CM_NULLPTR)
   , HadContextSensitiveCondition(false)
   , HadHeadSensitiveCondition(false)
   , EvaluateForBuildsystem(false)
 {
-  cmGeneratorExpressionLexer l;
-  std::vector<cmGeneratorExpressionToken> tokens = l.Tokenize(this->Input);
-  this->NeedsEvaluation = l.GetSawGeneratorExpression();
+}
 
-  if (this->NeedsEvaluation) {
-    cmGeneratorExpressionParser p(tokens);
-    p.Parse(this->Evaluators);
+cmCompiledGeneratorExpression::~cmCompiledGeneratorExpression()
+{
+  if (this->Evaluators) {
+    ParsedExpressions.Release(this->Input);
   }
 }
 
-cmCompiledGeneratorExpression::~cmCompiledGeneratorExpression()
+void cmGeneratorExpression::GetCompileStatistics(unsigned long& parsed,
+                                                 unsigned long& shared,
+                                                 unsigned long& plain)
+{
+  parsed = ParsedExpressions.Parsed;
+  shared = ParsedExpressions.Shared;
+  plain = ParsedExpressions.Plain;
+}
+
+void cmGeneratorExpression::ReleaseUnusedParses()
 {
-  cmDeleteAll(this->Evaluators);
+  ParsedExpressions.Trim();
 }
 
 std::string cmGeneratorExpression::StripEmptyListElements(
@@ -60,6 +60,18 @@ public:
 
   static std::string StripEmptyListElements(const std::string& input);
 
+  /** Get how many expressions were compiled in this process by parsing
+      their text, by sharing the evaluators of an expression compiled
+      from the same text before, or without any generator expression.  */
+  static void GetCompileStatistics(unsigned long& parsed,
+                                   unsigned long& shared,
+                                   unsigned long& plain);
+
+  /** Drop the parses of expression text that no compiled expression uses
+      any more.  The next expression compiled from such text parses it
+      again.  */
+  static void ReleaseUnusedParses();
+
 private:
   cmGeneratorExpression(const cmGeneratorExpression&);
   void operator=(const cmGeneratorExpression&);
@@ -137,7 +149,8 @@ private:
   void operator=(const cmCompiledGeneratorExpression&);
 
   cmListFileBacktrace Backtrace;
-  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
+  // Shared by all expressions compiled from the same text.
+  std::vector<cmGeneratorExpressionEvaluator*> const* Evaluators;
   const std::string Input;
   bool NeedsEvaluation;
 
@@ -49,28 +49,37 @@ void cmGeneratorExpressionDAGChecker::Initialize()
     top = p;
     p = p->Parent;
   }
+  this->Top = const_cast<cmGeneratorExpressionDAGChecker*>(top);
+  this->HeadSensitive = false;
+  this->Skipped = 0;
   this->CheckResult = this->CheckGraph();
 
 #define TEST_TRANSITIVE_PROPERTY_METHOD(METHOD) top->METHOD() ||
 
-  if (CheckResult == DAG &&
-      (CM_FOR_EACH_TRANSITIVE_PROPERTY_METHOD(
-        TEST_TRANSITIVE_PROPERTY_METHOD) false)) // NOLINT(clang-tidy)
+  this->RecordsSeen = (CM_FOR_EACH_TRANSITIVE_PROPERTY_METHOD(
+    TEST_TRANSITIVE_PROPERTY_METHOD) false); // NOLINT(clang-tidy)
 #undef TEST_TRANSITIVE_PROPERTY_METHOD
-  {
+
+  if (CheckResult == DAG && this->RecordsSeen) {
     std::map<std::string, std::set<std::string> >::const_iterator it =
       top->Seen.find(this->Target);
     if (it != top->Seen.end()) {
       const std::set<std::string>& propSet = it->second;
       if (propSet.find(this->Property) != propSet.end()) {
         this->CheckResult = ALREADY_SEEN;
-        return;
       }
     }
-    const_cast<cmGeneratorExpressionDAGChecker*>(top)
-      ->Seen[this->Target]
-      .insert(this->Property);
+    if (this->CheckResult == DAG) {
+      this->Top->Seen[this->Target].insert(this->Property);
+      this->Top->SeenOrder.push_back(
+        std::make_pair(this->Target, this->Property));
+    }
   }
+  if (this->CheckResult != DAG) {
+    ++this->Top->Skipped;
+  }
+  this->SeenStart = top->SeenOrder.size();
+  this->SkippedStart = top->Skipped;
 }
 
 cmGeneratorExpressionDAGChecker::Result
@@ -222,3 +231,48 @@ bool additionalTest<COMPILE_DEFINITIONS>(const char* const prop)
 CM_FOR_EACH_TRANSITIVE_PROPERTY(DEFINE_TRANSITIVE_PROPERTY_METHOD)
 
 #undef DEFINE_TRANSITIVE_PROPERTY_METHOD
+
+void cmGeneratorExpressionDAGChecker::SetHeadSensitive()
+{
+  for (const cmGeneratorExpressionDAGChecker* p = this;
+       p && !p->HeadSensitive; p = p->Parent) {
+    const_cast<cmGeneratorExpressionDAGChecker*>(p)->HeadSensitive = true;
+  }
+}
+
+bool cmGeneratorExpressionDAGChecker::IsHeadIndependent() const
+{
+  return this->RecordsSeen && !this->HeadSensitive &&
+    this->Top->Skipped == this->SkippedStart;
+}
+
+void cmGeneratorExpressionDAGChecker::GetSeenProperties(
+  PropertyList& props) const
+{
+  props.assign(this->Top->SeenOrder.begin() + this->SeenStart,
+               this->Top->SeenOrder.end());
+}
+
+bool cmGeneratorExpressionDAGChecker::AddSeenProperties(
+  PropertyList const& props)
+{
+  if (!this->RecordsSeen) {
+    return false;
+  }
+  std::map<std::string, std::set<std::string> >& seen = this->Top->Seen;
+  for (PropertyList::const_iterator it = props.begin(); it != props.end();
+       ++it) {
+    std::map<std::string, std::set<std::string> >::const_iterator ti =
+      seen.find(it->first);
+    if (ti != seen.end() && ti->second.count(it->second)) {
+      return false;
+    }
+  }
+  for (PropertyList::const_iterator it = props.begin(); it != props.end();
+       ++it) {
+    seen[it->first].insert(it->second);
+  }
+  this->Top->SeenOrder.insert(this->Top->SeenOrder.end(), props.begin(),
+                              props.end());
+  return true;
+}
@@ -9,7 +9,10 @@
 
 #include <map>
 #include <set>
+#include <stddef.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 struct GeneratorExpressionContent;
 struct cmGeneratorExpressionContext;
@@ -74,6 +77,31 @@ struct cmGeneratorExpressionDAGChecker
 
   std::string TopTarget() const;
 
+  typedef std::vector<std::pair<std::string, std::string> > PropertyList;
+
+  /** Record that the value of the checked property depends on the
+      target whose property is evaluated.  This holds for all the
+      properties that read it too.  */
+  void SetHeadSensitive();
+
+  /** Whether the value of the checked property, as evaluated so far,
+      is the same for any head target reading it in this evaluation.
+      That is the case if it read nothing of the head target, and read
+      every target property it refers to in full instead of skipping
+      some that were seen before or are part of a cycle.  */
+  bool IsHeadIndependent() const;
+
+  /** Get the target properties read to evaluate the checked property,
+      not counting itself, in the order first read.  */
+  void GetSeenProperties(PropertyList& props) const;
+
+  /** Record target properties read by an evaluation of the checked
+      property made for another head target, which is then used for
+      this one.  Returns false without recording anything if one of
+      them was already read in this evaluation, in which case the
+      property must be evaluated again to skip it.  */
+  bool AddSeenProperties(PropertyList const& props);
+
 private:
   Result CheckGraph() const;
   void Initialize();
@@ -87,6 +115,20 @@ private:
   const cmListFileBacktrace Backtrace;
   Result CheckResult;
   bool TransitivePropertiesOnly;
+
+  cmGeneratorExpressionDAGChecker* Top;
+
+  // Whether the top evaluation records the target properties seen.
+  bool RecordsSeen;
+  bool HeadSensitive;
+
+  // The target properties seen and the references skipped by the
+  // whole evaluation, kept by the top checker, and how many of each
+  // there were when this one started.
+  PropertyList SeenOrder;
+  size_t Skipped;
+  size_t SeenStart;
+  size_t SkippedStart;
 };
 
 #endif
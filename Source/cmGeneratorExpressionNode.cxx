@@ -1057,8 +1057,6 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
       }
     }
 
-    std::string linkedTargetsContent;
-
     std::string interfacePropertyName;
     bool isInterfaceProperty = false;
 
@@ -1081,6 +1079,83 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
       }
     }
 #undef POPULATE_INTERFACE_PROPERTY_NAME
+    if (isInterfaceProperty) {
+      return this->EvaluateInterfaceProperty(target, propertyName, prop,
+                                             interfacePropertyName, context,
+                                             &dagChecker, dagCheckerParent);
+    }
+    return this->EvaluateProperty(target, propertyName, prop,
+                                  interfacePropertyName, isInterfaceProperty,
+                                  context, &dagChecker, dagCheckerParent);
+  }
+
+private:
+  // The value of an INTERFACE_ property read by the targets depending on
+  // its target is often the same for all of them.  Evaluate it once for
+  // those in a directory unless the DAG checker tells it is not.
+  std::string EvaluateInterfaceProperty(
+    cmGeneratorTarget const* target, std::string const& propertyName,
+    const char* prop, std::string const& interfacePropertyName,
+    cmGeneratorExpressionContext* context,
+    cmGeneratorExpressionDAGChecker* dagChecker,
+    cmGeneratorExpressionDAGChecker* dagCheckerParent) const
+  {
+    std::string key = propertyName;
+    key += '\n';
+    key += context->Config;
+    key += '\n';
+    key += context->Language;
+    key += context->EvaluateForBuildsystem ? "\n1" : "\n0";
+    cmGeneratorTarget::InterfacePropertyValue const* shared =
+      target->GetInterfacePropertyValue(context->LG, key);
+    if (shared && dagChecker->AddSeenProperties(shared->SeenProperties)) {
+      if (shared->HadContextSensitiveCondition) {
+        context->HadContextSensitiveCondition = true;
+      }
+      return shared->Value;
+    }
+
+    bool const hadContextSensitiveCondition =
+      context->HadContextSensitiveCondition;
+    bool const hadHeadSensitiveCondition = context->HadHeadSensitiveCondition;
+    context->HadContextSensitiveCondition = false;
+    context->HadHeadSensitiveCondition = false;
+
+    std::string result =
+      this->EvaluateProperty(target, propertyName, prop, interfacePropertyName,
+                             true, context, dagChecker, dagCheckerParent);
+
+    if (context->HadHeadSensitiveCondition) {
+      dagChecker->SetHeadSensitive();
+    }
+    if (!shared && !context->HadError && dagChecker->IsHeadIndependent() &&
+        !cmSystemTools::GetErrorOccuredFlag()) {
+      cmGeneratorTarget::InterfacePropertyValue value;
+      value.Value = result;
+      value.HadContextSensitiveCondition =
+        context->HadContextSensitiveCondition;
+      dagChecker->GetSeenProperties(value.SeenProperties);
+      target->SetInterfacePropertyValue(context->LG, key, value);
+    }
+
+    if (hadContextSensitiveCondition) {
+      context->HadContextSensitiveCondition = true;
+    }
+    if (hadHeadSensitiveCondition) {
+      context->HadHeadSensitiveCondition = true;
+    }
+    return result;
+  }
+
+  std::string EvaluateProperty(
+    cmGeneratorTarget const* target, std::string const& propertyName,
+    const char* prop, std::string const& interfacePropertyName,
+    bool isInterfaceProperty, cmGeneratorExpressionContext* context,
+    cmGeneratorExpressionDAGChecker* dagChecker,
+    cmGeneratorExpressionDAGChecker* dagCheckerParent) const
+  {
+    std::string linkedTargetsContent;
+
     cmGeneratorTarget const* headTarget =
       context->HeadTarget && isInterfaceProperty ? context->HeadTarget
                                                  : target;
@@ -1089,16 +1164,19 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
       if (cmLinkInterfaceLibraries const* iface =
             target->GetLinkInterfaceLibraries(context->Config, headTarget,
                                               true)) {
+        if (iface->HadHeadSensitiveCondition) {
+          dagChecker->SetHeadSensitive();
+        }
         linkedTargetsContent =
           getLinkedTargetsContent(iface->Libraries, target, headTarget,
-                                  context, &dagChecker, interfacePropertyName);
+                                  context, dagChecker, interfacePropertyName);
       }
     } else if (!interfacePropertyName.empty()) {
       if (cmLinkImplementationLibraries const* impl =
             target->GetLinkImplementationLibraries(context->Config)) {
         linkedTargetsContent =
           getLinkedTargetsContent(impl->Libraries, target, target, context,
-                                  &dagChecker, interfacePropertyName);
+                                  dagChecker, interfacePropertyName);
       }
     }
 
@@ -1164,7 +1242,7 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
     }
     if (!interfacePropertyName.empty()) {
       std::string result = this->EvaluateDependentExpression(
-        prop, context->LG, context, headTarget, target, &dagChecker);
+        prop, context->LG, context, headTarget, target, dagChecker);
       if (!linkedTargetsContent.empty()) {
         result += (result.empty() ? "" : ";") + linkedTargetsContent;
       }
@@ -1975,6 +1975,25 @@ cmGeneratorTarget::GetLinkImplementationClosure(
   return tgts;
 }
 
+cmGeneratorTarget::InterfacePropertyValue const*
+cmGeneratorTarget::GetInterfacePropertyValue(cmLocalGenerator const* lg,
+                                             std::string const& key) const
+{
+  InterfacePropertyValueMapType::const_iterator it =
+    this->InterfacePropertyValues.find(std::make_pair(lg, key));
+  if (it == this->InterfacePropertyValues.end()) {
+    return CM_NULLPTR;
+  }
+  return &it->second;
+}
+
+void cmGeneratorTarget::SetInterfacePropertyValue(
+  cmLocalGenerator const* lg, std::string const& key,
+  InterfacePropertyValue const& value) const
+{
+  this->InterfacePropertyValues[std::make_pair(lg, key)] = value;
+}
+
 class cmTargetTraceDependencies
 {
 public:
@@ -729,6 +729,30 @@ public:
     return this->MaxLanguageStandards;
   }
 
+  /** The value of a transitive INTERFACE_ property of this target as
+      read by the targets depending on it, where it is the same for all
+      of them.  It is kept for each directory reading it and a key that
+      also names the configuration and language evaluated for.  */
+  struct InterfacePropertyValue
+  {
+    std::string Value;
+    bool HadContextSensitiveCondition;
+    // The target properties read to evaluate it.
+    std::vector<std::pair<std::string, std::string> > SeenProperties;
+  };
+  InterfacePropertyValue const* GetInterfacePropertyValue(
+    cmLocalGenerator const* lg, std::string const& key) const;
+  void SetInterfacePropertyValue(cmLocalGenerator const* lg,
+                                 std::string const& key,
+                                 InterfacePropertyValue const& value) const;
+
+private:
+  typedef std::map<std::pair<cmLocalGenerator const*, std::string>,
+                   InterfacePropertyValue>
+    InterfacePropertyValueMapType;
+  mutable InterfacePropertyValueMapType InterfacePropertyValues;
+
+public:
   struct StrictTargetComparison
   {
     bool operator()(cmGeneratorTarget const* t1,
@@ -2,13 +2,44 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmGlobalCommonGenerator.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#include "cmMakefileProfilingData.h"
+
+#include <map>
+#include <string>
+#endif
+
 class cmake;
 
 cmGlobalCommonGenerator::cmGlobalCommonGenerator(cmake* cm)
   : cmGlobalGenerator(cm)
+  , SharedObjectFlags(0)
+  , SourceObjectFlags(0)
 {
 }
 
 cmGlobalCommonGenerator::~cmGlobalCommonGenerator()
 {
 }
+
+void cmGlobalCommonGenerator::CountObjectFlags(bool shared)
+{
+  if (shared) {
+    ++this->SharedObjectFlags;
+  } else {
+    ++this->SourceObjectFlags;
+  }
+}
+
+void cmGlobalCommonGenerator::RecordGenerateStatistics(
+  cmMakefileProfilingData& profiling)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  std::map<std::string, unsigned long> counts;
+  counts["shared"] = this->SharedObjectFlags;
+  counts["source"] = this->SourceObjectFlags;
+  profiling.RecordCounters("object flags", counts);
+#else
+  static_cast<void>(profiling);
+#endif
+}
@@ -7,6 +7,7 @@
 
 #include "cmGlobalGenerator.h"
 
+class cmMakefileProfilingData;
 class cmake;
 
 /** \class cmGlobalCommonGenerator
@@ -17,6 +18,18 @@ class cmGlobalCommonGenerator : public cmGlobalGenerator
 public:
   cmGlobalCommonGenerator(cmake* cm);
   ~cmGlobalCommonGenerator() CM_OVERRIDE;
+
+  /** Count an object compiled with the flags its target shares among
+      all sources of the language, or with flags of its own source.  */
+  void CountObjectFlags(bool shared);
+
+protected:
+  void RecordGenerateStatistics(cmMakefileProfilingData& profiling)
+    CM_OVERRIDE;
+
+private:
+  unsigned long SharedObjectFlags;
+  unsigned long SourceObjectFlags;
 };
 
 #endif
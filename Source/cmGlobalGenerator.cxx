@@ -11,6 +11,7 @@
 
 #include "cmAlgorithms.h"
 #include "cmCPackPropertiesGenerator.h"
+#include "cmComputeLinkDepends.h"
 #include "cmComputeTargetDepends.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandLines.h"
@@ -44,6 +45,9 @@
 #include <string.h>
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
+#include "cmMakefileProfilingData.h"
+#include "cmTryCompileBatch.h"
+
 #include <cm_jsoncpp_value.h>
 #include <cm_jsoncpp_writer.h>
 #include <cmsys/MD5.h>
@@ -1064,6 +1068,10 @@ void cmGlobalGenerator::CreateLocalGenerators()
 
 void cmGlobalGenerator::Configure()
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmMakefileProfilingData::RAII profilingRAII(
+    this->CMakeInstance->GetProfilingOutput(), "configure");
+#endif
   this->FirstTimeProgress = 0.0f;
   this->ClearGeneratorMembers();
 
@@ -1086,6 +1094,24 @@ void cmGlobalGenerator::Configure()
   dirMf->Configure();
   dirMf->EnforceDirectoryLevelRules();
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Diagnose test projects whose deferred build was never started.
+  std::vector<cmTryCompileBatch::Job> deferred;
+  this->CMakeInstance->GetTryCompileBatch()->TakeJobs(deferred);
+  for (std::vector<cmTryCompileBatch::Job>::const_iterator ji =
+         deferred.begin();
+       ji != deferred.end(); ++ji) {
+    std::ostringstream e;
+    e << "try_compile given DEFER but the test project in\n"
+      << "  " << ji->BinaryDirectory << "\n"
+      << "was never built.  Call try_compile(BUILD_DEFERRED), or "
+      << "CHECK_BATCH_END() of the CheckBatch module, before the end of "
+      << "the configure step.";
+    this->CMakeInstance->IssueMessage(cmake::FATAL_ERROR, e.str(),
+                                      ji->Backtrace);
+  }
+#endif
+
   this->ConfigureDoneCMP0026AndCMP0024 = true;
 
   // Put a copy of each global target in every directory.
@@ -1208,6 +1234,10 @@ void cmGlobalGenerator::ComputeBuildFileGenerators()
 
 bool cmGlobalGenerator::Compute()
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmMakefileProfilingData::RAII profilingRAII(
+    this->CMakeInstance->GetProfilingOutput(), "compute");
+#endif
   // Some generators track files replaced during the Generate.
   // Start with an empty vector:
   this->FilesReplacedDuringGenerate.clear();
@@ -1287,6 +1317,10 @@ bool cmGlobalGenerator::Compute()
 
 void cmGlobalGenerator::Generate()
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmMakefileProfilingData::RAII profilingRAII(
+    this->CMakeInstance->GetProfilingOutput(), "generate");
+#endif
   // Create a map from local generator to the complete set of targets
   // it builds by default.
   this->InitializeProgressMarks();
@@ -1345,6 +1379,32 @@ void cmGlobalGenerator::Generate()
     this->GetCMakeInstance()->IssueMessage(cmake::AUTHOR_WARNING, w.str());
   }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (cmMakefileProfilingData* profiling =
+        this->CMakeInstance->GetProfilingOutput()) {
+    std::map<std::string, unsigned long> counts;
+    cmGeneratorExpression::GetCompileStatistics(
+      counts["parsed"], counts["shared"], counts["plain"]);
+    profiling->RecordCounters("generator expressions", counts);
+    counts.clear();
+    for (std::vector<cmLocalGenerator*>::const_iterator lgi =
+           this->LocalGenerators.begin();
+         lgi != this->LocalGenerators.end(); ++lgi) {
+      unsigned long computed;
+      unsigned long shared;
+      (*lgi)->GetLinkDependsCache().GetStatistics(computed, shared);
+      counts["computed"] += computed;
+      counts["shared"] += shared;
+    }
+    profiling->RecordCounters("link dependencies", counts);
+    this->RecordGenerateStatistics(*profiling);
+  }
+#endif
+
+  // Do not keep parses only needed by this run in a process that may
+  // configure and generate again.
+  cmGeneratorExpression::ReleaseUnusedParses();
+
   this->CMakeInstance->UpdateProgress("Generating done", -1);
 }
 
@@ -1655,23 +1715,7 @@ int cmGlobalGenerator::TryCompile(const std::string& srcdir,
                                   const std::string& target, bool fast,
                                   std::string& output, cmMakefile* mf)
 {
-  // if this is not set, then this is a first time configure
-  // and there is a good chance that the try compile stuff will
-  // take the bulk of the time, so try and guess some progress
-  // by getting closer and closer to 100 without actually getting there.
-  if (!this->CMakeInstance->GetState()->GetInitializedCacheValue(
-        "CMAKE_NUMBER_OF_MAKEFILES")) {
-    // If CMAKE_NUMBER_OF_MAKEFILES is not set
-    // we are in the first time progress and we have no
-    // idea how long it will be.  So, just move 1/10th of the way
-    // there each time, and don't go over 95%
-    this->FirstTimeProgress += ((1.0f - this->FirstTimeProgress) / 30.0f);
-    if (this->FirstTimeProgress > 0.95f) {
-      this->FirstTimeProgress = 0.95f;
-    }
-    this->CMakeInstance->UpdateProgress("Configuring",
-                                        this->FirstTimeProgress);
-  }
+  this->UpdateTryCompileProgress();
 
   std::string newTarget;
   if (!target.empty()) {
@@ -1694,6 +1738,27 @@ int cmGlobalGenerator::TryCompile(const std::string& srcdir,
                      config, false, fast, false, this->TryCompileTimeout);
 }
 
+void cmGlobalGenerator::UpdateTryCompileProgress()
+{
+  // if this is not set, then this is a first time configure
+  // and there is a good chance that the try compile stuff will
+  // take the bulk of the time, so try and guess some progress
+  // by getting closer and closer to 100 without actually getting there.
+  if (!this->CMakeInstance->GetState()->GetInitializedCacheValue(
+        "CMAKE_NUMBER_OF_MAKEFILES")) {
+    // If CMAKE_NUMBER_OF_MAKEFILES is not set
+    // we are in the first time progress and we have no
+    // idea how long it will be.  So, just move 1/10th of the way
+    // there each time, and don't go over 95%
+    this->FirstTimeProgress += ((1.0f - this->FirstTimeProgress) / 30.0f);
+    if (this->FirstTimeProgress > 0.95f) {
+      this->FirstTimeProgress = 0.95f;
+    }
+    this->CMakeInstance->UpdateProgress("Configuring",
+                                        this->FirstTimeProgress);
+  }
+}
+
 void cmGlobalGenerator::GenerateBuildCommand(
   std::vector<std::string>& makeCommand, const std::string& /*unused*/,
   const std::string& /*unused*/, const std::string& /*unused*/,
@@ -1719,9 +1784,6 @@ int cmGlobalGenerator::Build(const std::string& /*unused*/,
    */
   std::string cwd = cmSystemTools::GetCurrentWorkingDirectory();
   cmSystemTools::ChangeDirectory(bindir);
-  output += "Change Dir: ";
-  output += bindir;
-  output += "\n";
 
   int retVal;
   bool hideconsole = cmSystemTools::GetRunCommandHideConsole();
@@ -1730,6 +1792,41 @@ int cmGlobalGenerator::Build(const std::string& /*unused*/,
   std::string* outputPtr = &outputBuffer;
 
   std::vector<std::string> makeCommand;
+  if (!this->StartBuild(makeCommand, bindir, projectName, target, output,
+                        makeCommandCSTR, config, clean, fast, verbose,
+                        timeout, outputflag, nativeOptions)) {
+    cmSystemTools::SetRunCommandHideConsole(hideconsole);
+
+    // return to the original directory
+    cmSystemTools::ChangeDirectory(cwd);
+    return 1;
+  }
+
+  // now build
+  bool ran = cmSystemTools::RunSingleCommand(makeCommand, outputPtr,
+                                             outputPtr, &retVal, CM_NULLPTR,
+                                             outputflag, timeout);
+  cmSystemTools::SetRunCommandHideConsole(hideconsole);
+  output += *outputPtr;
+  retVal = this->FinishBuild(makeCommand, ran, retVal, output);
+
+  // return to the original directory
+  cmSystemTools::ChangeDirectory(cwd);
+  return retVal;
+}
+
+bool cmGlobalGenerator::StartBuild(
+  std::vector<std::string>& makeCommand, const std::string& bindir,
+  const std::string& projectName, const std::string& target,
+  std::string& output, const std::string& makeCommandCSTR,
+  const std::string& config, bool clean, bool fast, bool verbose,
+  double timeout, cmSystemTools::OutputOption& outputflag,
+  std::vector<std::string> const& nativeOptions)
+{
+  output += "Change Dir: ";
+  output += bindir;
+  output += "\n";
+
   this->GenerateBuildCommand(makeCommand, makeCommandCSTR, projectName, bindir,
                              target, config, fast, verbose, nativeOptions);
 
@@ -1750,44 +1847,38 @@ int cmGlobalGenerator::Build(const std::string& /*unused*/,
     output += cmSystemTools::PrintSingleCommand(cleanCommand);
     output += "\n";
 
-    if (!cmSystemTools::RunSingleCommand(cleanCommand, outputPtr, outputPtr,
-                                         &retVal, CM_NULLPTR, outputflag,
-                                         timeout)) {
-      cmSystemTools::SetRunCommandHideConsole(hideconsole);
+    int retVal;
+    std::string cleanOutput;
+    if (!cmSystemTools::RunSingleCommand(cleanCommand, &cleanOutput,
+                                         &cleanOutput, &retVal, CM_NULLPTR,
+                                         outputflag, timeout)) {
       cmSystemTools::Error("Generator: execution of make clean failed.");
-      output += *outputPtr;
+      output += cleanOutput;
       output += "\nGenerator: execution of make clean failed.\n";
-
-      // return to the original directory
-      cmSystemTools::ChangeDirectory(cwd);
-      return 1;
+      return false;
     }
-    output += *outputPtr;
+    output += cleanOutput;
   }
 
-  // now build
-  std::string makeCommandStr = cmSystemTools::PrintSingleCommand(makeCommand);
   output += "\nRun Build Command:";
-  output += makeCommandStr;
+  output += cmSystemTools::PrintSingleCommand(makeCommand);
   output += "\n";
+  return true;
+}
 
-  if (!cmSystemTools::RunSingleCommand(makeCommand, outputPtr, outputPtr,
-                                       &retVal, CM_NULLPTR, outputflag,
-                                       timeout)) {
-    cmSystemTools::SetRunCommandHideConsole(hideconsole);
+int cmGlobalGenerator::FinishBuild(std::vector<std::string> const& makeCommand,
+                                   bool ran, int retVal, std::string& output)
+{
+  if (!ran) {
+    std::string makeCommandStr =
+      cmSystemTools::PrintSingleCommand(makeCommand);
     cmSystemTools::Error(
       "Generator: execution of make failed. Make command was: ",
       makeCommandStr.c_str());
-    output += *outputPtr;
     output += "\nGenerator: execution of make failed. Make command was: " +
       makeCommandStr + "\n";
-
-    // return to the original directory
-    cmSystemTools::ChangeDirectory(cwd);
     return 1;
   }
-  output += *outputPtr;
-  cmSystemTools::SetRunCommandHideConsole(hideconsole);
 
   // The SGI MipsPro 7.3 compiler does not return an error code when
   // the source has a #error in it!  This is a work-around for such
@@ -1795,8 +1886,6 @@ int cmGlobalGenerator::Build(const std::string& /*unused*/,
   if ((retVal == 0) && (output.find("#error") != std::string::npos)) {
     retVal = 1;
   }
-
-  cmSystemTools::ChangeDirectory(cwd);
   return retVal;
 }
 
@@ -33,6 +33,7 @@ class cmGeneratorTarget;
 class cmLocalGenerator;
 class cmLinkLineComputer;
 class cmMakefile;
+class cmMakefileProfilingData;
 class cmOutputConverter;
 class cmake;
 
@@ -144,6 +145,13 @@ public:
                  const std::string& projectName, const std::string& targetName,
                  bool fast, std::string& output, cmMakefile* mf);
 
+  /**
+   * Report progress of a TryCompile while the project is configured for
+   * the first time.  Builds of test projects run without TryCompile call
+   * this before each.
+   */
+  void UpdateTryCompileProgress();
+
   /**
    * Build a file given the following information. This is a more direct call
    * that is used by both CTest and TryCompile. If target name is NULL or
@@ -159,6 +167,26 @@ public:
             std::vector<std::string> const& nativeOptions =
               std::vector<std::string>());
 
+  /**
+   * The steps of Build before and after it runs the build command, for
+   * callers that run the command themselves.  StartBuild generates the
+   * command into makeCommand and appends its header to output.  It runs
+   * a requested clean in the current directory and returns false if
+   * that failed.  FinishBuild takes whether the command ran to its exit
+   * and its exit value, with its output appended to output, and returns
+   * the result of the build.
+   */
+  bool StartBuild(std::vector<std::string>& makeCommand,
+                  const std::string& bindir, const std::string& projectName,
+                  const std::string& targetName, std::string& output,
+                  const std::string& makeProgram, const std::string& config,
+                  bool clean, bool fast, bool verbose, double timeout,
+                  cmSystemTools::OutputOption& outputflag,
+                  std::vector<std::string> const& nativeOptions =
+                    std::vector<std::string>());
+  int FinishBuild(std::vector<std::string> const& makeCommand, bool ran,
+                  int retVal, std::string& output);
+
   virtual void GenerateBuildCommand(
     std::vector<std::string>& makeCommand, const std::string& makeProgram,
     const std::string& projectName, const std::string& projectDir,
@@ -413,6 +441,11 @@ protected:
   bool IsExcluded(cmLocalGenerator* root, cmGeneratorTarget* target) const;
   virtual void InitializeProgressMarks() {}
 
+  // Add the counts kept while generating to the profile of the run.
+  virtual void RecordGenerateStatistics(cmMakefileProfilingData& /*unused*/)
+  {
+  }
+
   struct GlobalTargetInfo
   {
     std::string Name;
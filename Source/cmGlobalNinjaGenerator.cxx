@@ -33,6 +33,7 @@
 
 const char* cmGlobalNinjaGenerator::NINJA_BUILD_FILE = "build.ninja";
 const char* cmGlobalNinjaGenerator::NINJA_RULES_FILE = "rules.ninja";
+const char* cmGlobalNinjaGenerator::NINJA_DIRECTORY_FILE = "directory.ninja";
 const char* cmGlobalNinjaGenerator::INDENT = "  ";
 #ifdef _WIN32
 std::string const cmGlobalNinjaGenerator::SHELL_NOOP = "cd .";
@@ -459,6 +460,14 @@ void cmGlobalNinjaGenerator::WriteInclude(std::ostream& os,
   os << "include " << filename << "\n";
 }
 
+void cmGlobalNinjaGenerator::WriteSubninja(std::ostream& os,
+                                           const std::string& filename,
+                                           const std::string& comment)
+{
+  cmGlobalNinjaGenerator::WriteComment(os, comment);
+  os << "subninja " << filename << "\n";
+}
+
 void cmGlobalNinjaGenerator::WriteDefault(std::ostream& os,
                                           const cmNinjaDeps& targets,
                                           const std::string& comment)
@@ -475,6 +484,7 @@ void cmGlobalNinjaGenerator::WriteDefault(std::ostream& os,
 cmGlobalNinjaGenerator::cmGlobalNinjaGenerator(cmake* cm)
   : cmGlobalCommonGenerator(cm)
   , BuildFileStream(CM_NULLPTR)
+  , TopBuildFileStream(CM_NULLPTR)
   , RulesFileStream(CM_NULLPTR)
   , CompileCommandsStream(CM_NULLPTR)
   , Rules()
@@ -811,6 +821,59 @@ void cmGlobalNinjaGenerator::CloseBuildFileStream()
   }
 }
 
+void cmGlobalNinjaGenerator::OpenDirectoryBuildFileStream(
+  cmLocalGenerator* lg)
+{
+  if (!lg->GetMakefile()->IsOn("CMAKE_NINJA_SPLIT_BY_DIRECTORY")) {
+    return;
+  }
+
+  std::string dirFilePath = lg->GetCurrentBinaryDirectory();
+  dirFilePath += cmake::GetCMakeFilesDirectory();
+  dirFilePath += "/";
+  dirFilePath += cmGlobalNinjaGenerator::NINJA_DIRECTORY_FILE;
+
+  // Include the file where the statements would otherwise be.
+  std::ostream& os = *this->BuildFileStream;
+  std::string const ninjaDirFile = this->ConvertToNinjaPath(dirFilePath);
+  cmGlobalNinjaGenerator::WriteSubninja(
+    os, this->EncodeIdent(this->EncodePath(ninjaDirFile), os),
+    "Include the build statements of this directory.");
+  os << "\n";
+
+  // Replace the file only if its content changes so that regenerating
+  // the build system leaves the directories that did not change alone.
+  this->TopBuildFileStream = this->BuildFileStream;
+  this->BuildFileStream = new cmGeneratedFileStream(
+    dirFilePath.c_str(), false, this->GetMakefileEncoding());
+  this->BuildFileStream->SetCopyIfDifferent(true);
+
+  // Write the do not edit header.
+  this->WriteDisclaimer(*this->BuildFileStream);
+
+  // Write a comment about this file.
+  /* clang-format off */
+  *this->BuildFileStream
+    << "# This file contains the build statements of the directory\n"
+    << "# " << lg->GetCurrentSourceDirectory() << "\n"
+    << "# It is included in the main '" << NINJA_BUILD_FILE << "'.\n\n"
+    ;
+  /* clang-format on */
+}
+
+void cmGlobalNinjaGenerator::CloseDirectoryBuildFileStream()
+{
+  if (!this->TopBuildFileStream) {
+    return;
+  }
+  if (cmSystemTools::GetErrorOccuredFlag()) {
+    this->BuildFileStream->setstate(std::ios::failbit);
+  }
+  delete this->BuildFileStream;
+  this->BuildFileStream = this->TopBuildFileStream;
+  this->TopBuildFileStream = CM_NULLPTR;
+}
+
 void cmGlobalNinjaGenerator::OpenRulesFileStream()
 {
   // Compute Ninja's build file path.
@@ -38,7 +38,8 @@ class cmLocalGenerator;
  *   it itself.
  * - We don't care about generating a clean target since Ninja already have
  *   a clean tool.
- * - We generate one build.ninja and one rules.ninja per project.
+ * - We generate one build.ninja and one rules.ninja per project, and
+ *   optionally one directory.ninja per directory included by build.ninja.
  * - We try to minimize the number of generated rules: one per target and
  *   language.
  * - We use Ninja special variable $in and $out to produce nice output.
@@ -55,6 +56,11 @@ public:
   /// It is included in the main build.ninja file.
   static const char* NINJA_RULES_FILE;
 
+  /// The name of the build file of a directory, relative to its
+  /// CMakeFiles directory, when CMAKE_NINJA_SPLIT_BY_DIRECTORY is set.
+  /// It is included in the main build.ninja file as a subninja.
+  static const char* NINJA_DIRECTORY_FILE;
+
   /// The indentation string used when generating Ninja's build file.
   static const char* INDENT;
 
@@ -161,6 +167,13 @@ public:
   static void WriteInclude(std::ostream& os, const std::string& filename,
                            const std::string& comment = "");
 
+  /**
+   * Write a subninja statement including @a filename in its own scope
+   * with an optional @a comment to the @a os stream.
+   */
+  static void WriteSubninja(std::ostream& os, const std::string& filename,
+                            const std::string& comment = "");
+
   /**
    * Write a default target statement specifying @a targets as
    * the default targets.
@@ -243,6 +256,11 @@ public:
     return this->RulesFileStream;
   }
 
+  /// Send the build statements of the directory of @a lg to a file of
+  /// its own until CloseDirectoryBuildFileStream, if it asks for that.
+  void OpenDirectoryBuildFileStream(cmLocalGenerator* lg);
+  void CloseDirectoryBuildFileStream();
+
   std::string ConvertToNinjaPath(const std::string& path) const;
 
   struct MapToNinjaPathImpl
@@ -400,6 +418,8 @@ private:
   /// The file containing the build statement. (the relationship of the
   /// compilation DAG).
   cmGeneratedFileStream* BuildFileStream;
+  /// The main build file while BuildFileStream is that of a directory.
+  cmGeneratedFileStream* TopBuildFileStream;
   /// The file containing the rule statements. (The action attached to each
   /// edge of the compilation DAG).
   cmGeneratedFileStream* RulesFileStream;
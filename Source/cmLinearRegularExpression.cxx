@@ -0,0 +1,674 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmLinearRegularExpression.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+// The syntax is that of cmsys::RegularExpression, which also decides
+// which patterns are valid.  Parse into a tree and track the flags and
+// the program size the way its compiler does to accept the same ones.
+struct Node
+{
+  enum NodeType
+  {
+    Empty,
+    Literal,
+    AnyChar,
+    CharClass,
+    BeginLine,
+    EndLine,
+    Group,
+    Concat,
+    Alternate,
+    Star,
+    Plus,
+    Quest
+  };
+
+  NodeType Type;
+  std::string Text;
+  int Index;
+  std::vector<int> Children;
+};
+
+class Parser
+{
+public:
+  Parser(const char* pattern, std::vector<char>& classes)
+    : Groups(1)
+    , P(pattern)
+    , Classes(classes)
+    , Size(1)
+  {
+  }
+
+  std::vector<Node> Nodes;
+  int Groups;
+
+  int Parse()
+  {
+    int flags;
+    int root = this->ParseReg(false, flags);
+    // The backtracking matcher stores offsets in 16 bits.
+    if (root < 0 || this->Size >= 32767L) {
+      return -1;
+    }
+    return root;
+  }
+
+private:
+  const char* P;
+  std::vector<char>& Classes;
+  long Size;
+
+  enum
+  {
+    HasWidth = 1, // Known never to match the empty string.
+    Simple = 2    // Matched by a single character.
+  };
+
+  static bool IsMult(char c) { return c == '*' || c == '+' || c == '?'; }
+
+  int NewNode(Node::NodeType type, int index = 0)
+  {
+    Node node;
+    node.Type = type;
+    node.Index = index;
+    this->Nodes.push_back(node);
+    return static_cast<int>(this->Nodes.size() - 1);
+  }
+
+  int ParseReg(bool paren, int& flags)
+  {
+    flags = HasWidth;
+    int parno = 0;
+    if (paren) {
+      if (this->Groups >= cmLinearRegularExpression::NSUBEXP) {
+        return -1;
+      }
+      parno = this->Groups++;
+      this->Size += 3;
+    }
+
+    std::vector<int> branches;
+    for (;;) {
+      int branchFlags;
+      int branch = this->ParseBranch(branchFlags);
+      if (branch < 0) {
+        return -1;
+      }
+      if (!(branchFlags & HasWidth)) {
+        flags &= ~HasWidth;
+      }
+      branches.push_back(branch);
+      if (*this->P != '|') {
+        break;
+      }
+      ++this->P;
+    }
+    this->Size += 3;
+
+    if (paren) {
+      if (*this->P++ != ')') {
+        return -1;
+      }
+    } else if (*this->P != '\0') {
+      return -1;
+    }
+
+    int node;
+    if (branches.size() == 1) {
+      node = branches[0];
+    } else {
+      node = this->NewNode(Node::Alternate);
+      this->Nodes[node].Children = branches;
+    }
+    if (paren) {
+      int group = this->NewNode(Node::Group, parno);
+      this->Nodes[group].Children.push_back(node);
+      node = group;
+    }
+    return node;
+  }
+
+  int ParseBranch(int& flags)
+  {
+    flags = 0;
+    this->Size += 3;
+    std::vector<int> pieces;
+    while (*this->P != '\0' && *this->P != '|' && *this->P != ')') {
+      int pieceFlags;
+      int piece = this->ParsePiece(pieceFlags);
+      if (piece < 0) {
+        return -1;
+      }
+      flags |= pieceFlags & HasWidth;
+      pieces.push_back(piece);
+    }
+    if (pieces.empty()) {
+      this->Size += 3;
+      return this->NewNode(Node::Empty);
+    }
+    if (pieces.size() == 1) {
+      return pieces[0];
+    }
+    int node = this->NewNode(Node::Concat);
+    this->Nodes[node].Children = pieces;
+    return node;
+  }
+
+  int ParsePiece(int& flags)
+  {
+    int atomFlags;
+    int atom = this->ParseAtom(atomFlags);
+    if (atom < 0) {
+      return -1;
+    }
+    char op = *this->P;
+    if (!IsMult(op)) {
+      flags = atomFlags;
+      return atom;
+    }
+    if (!(atomFlags & HasWidth) && op != '?') {
+      return -1;
+    }
+    flags = (op == '+') ? HasWidth : 0;
+
+    Node::NodeType type;
+    if (op == '*') {
+      type = Node::Star;
+      this->Size += (atomFlags & Simple) ? 3 : 12;
+    } else if (op == '+') {
+      type = Node::Plus;
+      this->Size += (atomFlags & Simple) ? 3 : 12;
+    } else {
+      type = Node::Quest;
+      this->Size += 9;
+    }
+    ++this->P;
+    if (IsMult(*this->P)) {
+      return -1;
+    }
+    int node = this->NewNode(type);
+    this->Nodes[node].Children.push_back(atom);
+    return node;
+  }
+
+  int ParseAtom(int& flags)
+  {
+    flags = 0;
+    switch (*this->P++) {
+      case '^':
+        this->Size += 3;
+        return this->NewNode(Node::BeginLine);
+      case '$':
+        this->Size += 3;
+        return this->NewNode(Node::EndLine);
+      case '.':
+        this->Size += 3;
+        flags = HasWidth | Simple;
+        return this->NewNode(Node::AnyChar);
+      case '[':
+        return this->ParseClass(flags);
+      case '(': {
+        int groupFlags;
+        int node = this->ParseReg(true, groupFlags);
+        flags = groupFlags & HasWidth;
+        return node;
+      }
+      case '\0':
+      case '|':
+      case ')':
+      case '?':
+      case '+':
+      case '*':
+        return -1;
+      case '\\': {
+        if (*this->P == '\0') {
+          return -1;
+        }
+        this->Size += 5;
+        flags = HasWidth | Simple;
+        int node = this->NewNode(Node::Literal);
+        this->Nodes[node].Text = *this->P++;
+        return node;
+      }
+      default: {
+        --this->P;
+        size_t len = strcspn(this->P, "^$.[()|?+*\\");
+        if (len > 1 && IsMult(this->P[len])) {
+          // Leave the last character to the operator.
+          --len;
+        }
+        flags = HasWidth;
+        if (len == 1) {
+          flags |= Simple;
+        }
+        this->Size += 4 + static_cast<long>(len);
+        int node = this->NewNode(Node::Literal);
+        this->Nodes[node].Text.assign(this->P, len);
+        this->P += len;
+        return node;
+      }
+    }
+  }
+
+  int ParseClass(int& flags)
+  {
+    this->Size += 3;
+    bool negate = false;
+    if (*this->P == '^') {
+      negate = true;
+      ++this->P;
+    }
+    std::vector<char> members(256, 0);
+    if (*this->P == ']' || *this->P == '-') {
+      this->AddMember(members, *this->P++);
+    }
+    while (*this->P != '\0' && *this->P != ']') {
+      if (*this->P == '-') {
+        ++this->P;
+        if (*this->P == ']' || *this->P == '\0') {
+          this->AddMember(members, '-');
+        } else {
+          // The range starts after the character before the '-'.
+          int first = static_cast<unsigned char>(this->P[-2]) + 1;
+          int last = static_cast<unsigned char>(this->P[0]);
+          if (first > last + 1) {
+            return -1;
+          }
+          for (; first <= last; ++first) {
+            this->AddMember(members, static_cast<char>(first));
+          }
+          ++this->P;
+        }
+      } else {
+        this->AddMember(members, *this->P++);
+      }
+    }
+    this->Size += 1;
+    if (*this->P != ']') {
+      return -1;
+    }
+    ++this->P;
+    flags = HasWidth | Simple;
+
+    if (negate) {
+      for (std::vector<char>::iterator i = members.begin();
+           i != members.end(); ++i) {
+        *i = !*i;
+      }
+    }
+    int index = static_cast<int>(this->Classes.size() / 256);
+    this->Classes.insert(this->Classes.end(), members.begin(), members.end());
+    return this->NewNode(Node::CharClass, index);
+  }
+
+  void AddMember(std::vector<char>& members, char c)
+  {
+    members[static_cast<unsigned char>(c)] = 1;
+    this->Size += 1;
+  }
+};
+
+class Emitter
+{
+public:
+  Emitter(std::vector<Node> const& nodes,
+          std::vector<cmLinearRegularExpression::Instruction>& program)
+    : Nodes(nodes)
+    , Program(program)
+  {
+  }
+
+  void Emit(int n)
+  {
+    Node const& node = this->Nodes[n];
+    switch (node.Type) {
+      case Node::Empty:
+        break;
+      case Node::Literal:
+        for (std::string::const_iterator i = node.Text.begin();
+             i != node.Text.end(); ++i) {
+          this->Add(cmLinearRegularExpression::Char,
+                    static_cast<unsigned char>(*i));
+        }
+        break;
+      case Node::AnyChar:
+        this->Add(cmLinearRegularExpression::Any);
+        break;
+      case Node::CharClass:
+        this->Add(cmLinearRegularExpression::Class, node.Index);
+        break;
+      case Node::BeginLine:
+        this->Add(cmLinearRegularExpression::Bol);
+        break;
+      case Node::EndLine:
+        this->Add(cmLinearRegularExpression::Eol);
+        break;
+      case Node::Group:
+        this->Add(cmLinearRegularExpression::Save, 2 * node.Index);
+        this->Emit(node.Children[0]);
+        this->Add(cmLinearRegularExpression::Save, 2 * node.Index + 1);
+        break;
+      case Node::Concat:
+        for (std::vector<int>::const_iterator i = node.Children.begin();
+             i != node.Children.end(); ++i) {
+          this->Emit(*i);
+        }
+        break;
+      case Node::Alternate: {
+        // Try the alternatives in order.
+        std::vector<size_t> jumps;
+        for (size_t i = 0; i + 1 < node.Children.size(); ++i) {
+          size_t split = this->Add(cmLinearRegularExpression::Split);
+          this->Program[split].Arg = static_cast<int>(split + 1);
+          this->Emit(node.Children[i]);
+          jumps.push_back(this->Add(cmLinearRegularExpression::Jump));
+          this->Program[split].Alt = this->Here();
+        }
+        this->Emit(node.Children.back());
+        for (std::vector<size_t>::iterator i = jumps.begin();
+             i != jumps.end(); ++i) {
+          this->Program[*i].Arg = this->Here();
+        }
+      } break;
+      case Node::Star: {
+        // Repeat as often as possible.
+        size_t split = this->Add(cmLinearRegularExpression::Split);
+        this->Program[split].Arg = static_cast<int>(split + 1);
+        this->Emit(node.Children[0]);
+        this->Add(cmLinearRegularExpression::Jump, static_cast<int>(split));
+        this->Program[split].Alt = this->Here();
+      } break;
+      case Node::Plus: {
+        int loop = this->Here();
+        this->Emit(node.Children[0]);
+        size_t split = this->Add(cmLinearRegularExpression::Split, loop);
+        this->Program[split].Alt = this->Here();
+      } break;
+      case Node::Quest: {
+        size_t split = this->Add(cmLinearRegularExpression::Split);
+        this->Program[split].Arg = static_cast<int>(split + 1);
+        this->Emit(node.Children[0]);
+        this->Program[split].Alt = this->Here();
+      } break;
+    }
+  }
+
+  size_t Add(cmLinearRegularExpression::Opcode op, int arg = 0)
+  {
+    cmLinearRegularExpression::Instruction in;
+    in.Op = op;
+    in.Arg = arg;
+    in.Alt = 0;
+    this->Program.push_back(in);
+    return this->Program.size() - 1;
+  }
+
+private:
+  std::vector<Node> const& Nodes;
+  std::vector<cmLinearRegularExpression::Instruction>& Program;
+
+  int Here() const { return static_cast<int>(this->Program.size()); }
+};
+}
+
+cmLinearRegularExpression::cmLinearRegularExpression()
+  : FirstChar('\0')
+  , Anchored(false)
+  , Captures(0)
+  , SearchString(CM_NULLPTR)
+  , Generation(0)
+{
+  for (int i = 0; i < NSUBEXP; ++i) {
+    this->StartP[i] = this->EndP[i] = CM_NULLPTR;
+  }
+}
+
+cmLinearRegularExpression::cmLinearRegularExpression(const char* pattern)
+  : FirstChar('\0')
+  , Anchored(false)
+  , Captures(0)
+  , SearchString(CM_NULLPTR)
+  , Generation(0)
+{
+  for (int i = 0; i < NSUBEXP; ++i) {
+    this->StartP[i] = this->EndP[i] = CM_NULLPTR;
+  }
+  this->compile(pattern);
+}
+
+cmLinearRegularExpression::cmLinearRegularExpression(
+  std::string const& pattern)
+  : FirstChar('\0')
+  , Anchored(false)
+  , Captures(0)
+  , SearchString(CM_NULLPTR)
+  , Generation(0)
+{
+  for (int i = 0; i < NSUBEXP; ++i) {
+    this->StartP[i] = this->EndP[i] = CM_NULLPTR;
+  }
+  this->compile(pattern);
+}
+
+bool cmLinearRegularExpression::compile(const char* pattern)
+{
+  if (!pattern) {
+    return false;
+  }
+  std::vector<char> classes;
+  Parser parser(pattern, classes);
+  int root = parser.Parse();
+  if (root < 0) {
+    return false;
+  }
+
+  std::vector<Instruction> program;
+  Emitter emitter(parser.Nodes, program);
+  emitter.Add(Save, 0);
+  emitter.Emit(root);
+  emitter.Add(Save, 1);
+  emitter.Add(Match);
+
+  this->Program.swap(program);
+  this->Classes.swap(classes);
+  this->Captures = 2 * parser.Groups;
+  this->Marks.clear();
+
+  // Find what a match must start with and the longest literal string
+  // it must contain when there is only one top-level alternative.
+  this->FirstChar = '\0';
+  this->Anchored = false;
+  this->Required.clear();
+  Node const& top = parser.Nodes[root];
+  if (top.Type != Node::Alternate) {
+    std::vector<int> pieces;
+    if (top.Type == Node::Concat) {
+      pieces = top.Children;
+    } else {
+      pieces.push_back(root);
+    }
+    Node const& first = parser.Nodes[pieces.front()];
+    if (first.Type == Node::Literal) {
+      this->FirstChar = first.Text[0];
+    } else if (first.Type == Node::BeginLine) {
+      this->Anchored = true;
+    }
+    std::string literal;
+    for (std::vector<int>::const_iterator i = pieces.begin();
+         i != pieces.end(); ++i) {
+      Node const& piece = parser.Nodes[*i];
+      if (piece.Type == Node::Literal) {
+        literal += piece.Text;
+        if (literal.size() >= this->Required.size()) {
+          this->Required = literal;
+        }
+      } else {
+        literal.clear();
+      }
+    }
+  }
+  return true;
+}
+
+std::string cmLinearRegularExpression::match(int n) const
+{
+  if (!this->StartP[n]) {
+    return std::string();
+  }
+  return std::string(this->StartP[n], static_cast<std::string::size_type>(
+                                         this->EndP[n] - this->StartP[n]));
+}
+
+void cmLinearRegularExpression::AddThread(ThreadList& list, int pc,
+                                          const char* sp, const char** caps)
+{
+  // Each instruction gets one thread per position, the one with the
+  // highest priority since that is added first.
+  if (this->Marks[pc] == this->Generation) {
+    return;
+  }
+  this->Marks[pc] = this->Generation;
+
+  Instruction const& in = this->Program[pc];
+  switch (in.Op) {
+    case Jump:
+      this->AddThread(list, in.Arg, sp, caps);
+      return;
+    case Split:
+      this->AddThread(list, in.Arg, sp, caps);
+      this->AddThread(list, in.Alt, sp, caps);
+      return;
+    case Save: {
+      const char* old = caps[in.Arg];
+      caps[in.Arg] = sp;
+      this->AddThread(list, pc + 1, sp, caps);
+      caps[in.Arg] = old;
+    }
+      return;
+    case Bol:
+      if (sp == this->SearchString) {
+        this->AddThread(list, pc + 1, sp, caps);
+      }
+      return;
+    case Eol:
+      if (*sp == '\0') {
+        this->AddThread(list, pc + 1, sp, caps);
+      }
+      return;
+    default:
+      break;
+  }
+  list.Pcs[list.Size] = pc;
+  std::copy(caps, caps + this->Captures,
+            list.Caps.begin() + list.Size * this->Captures);
+  ++list.Size;
+}
+
+bool cmLinearRegularExpression::find(const char* string)
+{
+  this->SearchString = string;
+  for (int i = 0; i < NSUBEXP; ++i) {
+    this->StartP[i] = this->EndP[i] = CM_NULLPTR;
+  }
+  if (this->Program.empty()) {
+    return false;
+  }
+  if (!this->Required.empty() && !strstr(string, this->Required.c_str())) {
+    return false;
+  }
+
+  size_t const size = this->Program.size();
+  if (this->Marks.size() != size) {
+    this->Marks.assign(size, 0);
+    this->Generation = 0;
+    this->Current.Pcs.resize(size);
+    this->Current.Caps.resize(size * this->Captures);
+    this->Next.Pcs.resize(size);
+    this->Next.Caps.resize(size * this->Captures);
+  }
+  ThreadList* current = &this->Current;
+  ThreadList* next = &this->Next;
+  current->Size = 0;
+  next->Size = 0;
+
+  const char* caps[2 * NSUBEXP];
+  for (int i = 0; i < 2 * NSUBEXP; ++i) {
+    caps[i] = CM_NULLPTR;
+  }
+
+  // Start a thread at each position, with less priority than those
+  // started before, until one of them matches.
+  bool matched = false;
+  const char* sp = string;
+  for (;;) {
+    if (!matched) {
+      if (current->Size == 0) {
+        if (this->Anchored && sp != string) {
+          break;
+        }
+        if (this->FirstChar != '\0') {
+          sp = strchr(sp, this->FirstChar);
+          if (!sp) {
+            break;
+          }
+        }
+        ++this->Generation;
+      }
+      this->AddThread(*current, 0, sp, caps);
+    }
+    if (matched && current->Size == 0) {
+      break;
+    }
+
+    char const c = *sp;
+    ++this->Generation;
+    for (size_t i = 0; i < current->Size; ++i) {
+      int const pc = current->Pcs[i];
+      Instruction const& in = this->Program[pc];
+      const char** threadCaps = &current->Caps[i * this->Captures];
+      switch (in.Op) {
+        case Char:
+          if (c != '\0' && static_cast<unsigned char>(c) == in.Arg) {
+            this->AddThread(*next, pc + 1, sp + 1, threadCaps);
+          }
+          break;
+        case Any:
+          if (c != '\0') {
+            this->AddThread(*next, pc + 1, sp + 1, threadCaps);
+          }
+          break;
+        case Class:
+          if (c != '\0' &&
+              this->InClass(in.Arg, static_cast<unsigned char>(c))) {
+            this->AddThread(*next, pc + 1, sp + 1, threadCaps);
+          }
+          break;
+        case Match:
+          // Threads after this one have less priority.
+          matched = true;
+          for (int g = 0; g < this->Captures / 2; ++g) {
+            this->StartP[g] = threadCaps[2 * g];
+            this->EndP[g] = threadCaps[2 * g + 1];
+          }
+          i = current->Size;
+          break;
+        default:
+          break;
+      }
+    }
+
+    std::swap(current, next);
+    next->Size = 0;
+    if (c == '\0') {
+      break;
+    }
+    ++sp;
+  }
+  return matched;
+}
@@ -0,0 +1,124 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmLinearRegularExpression_h
+#define cmLinearRegularExpression_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <cmsys/RegularExpression.hxx>
+#include <string>
+#include <vector>
+
+/** \class cmLinearRegularExpression
+ * \brief Regular expression matching in time linear in the input.
+ *
+ * cmLinearRegularExpression accepts the same patterns as
+ * cmsys::RegularExpression and finds the same matches and
+ * subexpressions, but it runs all alternatives of the pattern side by
+ * side over the input (a Pike VM over a Thompson NFA) instead of
+ * backtracking.  A find takes time proportional to the length of the
+ * input times the size of the pattern, so patterns like "(a|aa)*b" do
+ * not take exponential time on long inputs.  The backtracking matcher
+ * is usually faster for simple patterns, so callers choose the one
+ * that fits the patterns and input they expect.
+ */
+class cmLinearRegularExpression
+{
+public:
+  enum
+  {
+    NSUBEXP = cmsys::RegularExpression::NSUBEXP
+  };
+
+  cmLinearRegularExpression();
+  cmLinearRegularExpression(const char* pattern);
+  cmLinearRegularExpression(std::string const& pattern);
+
+  /** Compile a pattern.  Returns false and keeps the previous pattern
+      if it is not valid.  */
+  bool compile(const char* pattern);
+  bool compile(std::string const& pattern)
+  {
+    return this->compile(pattern.c_str());
+  }
+
+  /** Find the first match in a string, preferring alternatives and
+      repetitions the way the backtracking matcher tries them.  */
+  bool find(const char* string);
+  bool find(std::string const& string) { return this->find(string.c_str()); }
+
+  std::string::size_type start() const { return this->start(0); }
+  std::string::size_type end() const { return this->end(0); }
+  std::string::size_type start(int n) const
+  {
+    return static_cast<std::string::size_type>(this->StartP[n] -
+                                               this->SearchString);
+  }
+  std::string::size_type end(int n) const
+  {
+    return static_cast<std::string::size_type>(this->EndP[n] -
+                                               this->SearchString);
+  }
+  std::string match(int n) const;
+
+  bool is_valid() const { return !this->Program.empty(); }
+  void set_invalid() { this->Program.clear(); }
+
+  /** Instructions of a compiled pattern.  */
+  enum Opcode
+  {
+    Char,  // Match the character Arg.
+    Any,   // Match any character.
+    Class, // Match a character of the class Arg.
+    Split, // Continue at Arg, or else at Alt.
+    Jump,  // Continue at Arg.
+    Save,  // Record the position in capture slot Arg.
+    Bol,   // Match the beginning of the input.
+    Eol,   // Match the end of the input.
+    Match  // The pattern matched.
+  };
+  struct Instruction
+  {
+    Opcode Op;
+    int Arg;
+    int Alt;
+  };
+
+  /** The program compiled from the pattern, which can be run by other
+      kinds of automata.  Character classes are indexed by Arg.  */
+  std::vector<Instruction> const& GetProgram() const { return this->Program; }
+  bool InClass(int cls, unsigned char c) const
+  {
+    return this->Classes[cls * 256 + c] != 0;
+  }
+  /** A string every match contains, possibly empty.  */
+  std::string const& GetRequiredString() const { return this->Required; }
+
+private:
+  std::vector<Instruction> Program;
+  std::vector<char> Classes;
+  std::string Required;
+  char FirstChar;
+  bool Anchored;
+  int Captures;
+
+  const char* StartP[NSUBEXP];
+  const char* EndP[NSUBEXP];
+  const char* SearchString;
+
+  // Threads of the matcher for the current and next input position.
+  struct ThreadList
+  {
+    std::vector<int> Pcs;
+    std::vector<const char*> Caps;
+    size_t Size;
+  };
+  ThreadList Current;
+  ThreadList Next;
+  std::vector<size_t> Marks;
+  size_t Generation;
+
+  void AddThread(ThreadList& list, int pc, const char* sp, const char** caps);
+};
+
+#endif
@@ -0,0 +1,292 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmLinearRegularExpressionSet.h"
+
+#include <algorithm>
+#include <utility>
+
+// The number of DFA states to keep before starting over.  Each takes
+// a table of transitions for all characters.
+static const size_t cmLinearRegularExpressionSetMaxStates = 4096;
+
+cmLinearRegularExpressionSet::cmLinearRegularExpressionSet()
+  : StartState(-1)
+  , Generation(0)
+{
+}
+
+bool cmLinearRegularExpressionSet::Add(const char* pattern)
+{
+  int const index = static_cast<int>(this->Starts.size());
+  this->Matches.push_back(0);
+
+  cmLinearRegularExpression regex;
+  if (!regex.compile(pattern)) {
+    this->Starts.push_back(-1);
+    return false;
+  }
+
+  // Append the program of the pattern, numbering its jumps and classes
+  // after those already there.
+  std::vector<cmLinearRegularExpression::Instruction> const& program =
+    regex.GetProgram();
+  int const offset = static_cast<int>(this->Program.size());
+  int const classOffset = static_cast<int>(this->Classes.size() / 256);
+  int classes = 0;
+  for (std::vector<cmLinearRegularExpression::Instruction>::const_iterator i =
+         program.begin();
+       i != program.end(); ++i) {
+    cmLinearRegularExpression::Instruction in = *i;
+    switch (in.Op) {
+      case cmLinearRegularExpression::Split:
+        in.Alt += offset;
+        in.Arg += offset;
+        break;
+      case cmLinearRegularExpression::Jump:
+        in.Arg += offset;
+        break;
+      case cmLinearRegularExpression::Class:
+        classes = std::max(classes, in.Arg + 1);
+        in.Arg += classOffset;
+        break;
+      case cmLinearRegularExpression::Match:
+        in.Arg = index;
+        break;
+      default:
+        break;
+    }
+    this->Program.push_back(in);
+  }
+  for (int cls = 0; cls < classes; ++cls) {
+    for (int c = 0; c < 256; ++c) {
+      this->Classes.push_back(
+        regex.InClass(cls, static_cast<unsigned char>(c)) ? 1 : 0);
+    }
+  }
+  this->Starts.push_back(offset);
+  this->Marks.assign(this->Program.size(), 0);
+  this->Generation = 0;
+  this->Reset();
+  return true;
+}
+
+void cmLinearRegularExpressionSet::Clear()
+{
+  this->Program.clear();
+  this->Classes.clear();
+  this->Starts.clear();
+  this->Matches.clear();
+  this->MatchedPatterns.clear();
+  this->Marks.clear();
+  this->Generation = 0;
+  this->Reset();
+}
+
+void cmLinearRegularExpressionSet::Reset()
+{
+  this->States.clear();
+  this->Transitions.clear();
+  this->StateIndex.clear();
+  this->StartState = -1;
+}
+
+size_t cmLinearRegularExpressionSet::FirstMatch(size_t begin,
+                                                size_t end) const
+{
+  for (; begin != end; ++begin) {
+    if (this->Matches[begin]) {
+      break;
+    }
+  }
+  return begin;
+}
+
+void cmLinearRegularExpressionSet::AddClosure(int pc, bool atStart,
+                                              bool atEnd,
+                                              std::vector<int>& pcs,
+                                              std::vector<int>& matches)
+{
+  if (this->Marks[pc] == this->Generation) {
+    return;
+  }
+  this->Marks[pc] = this->Generation;
+
+  cmLinearRegularExpression::Instruction const& in = this->Program[pc];
+  switch (in.Op) {
+    case cmLinearRegularExpression::Jump:
+      this->AddClosure(in.Arg, atStart, atEnd, pcs, matches);
+      break;
+    case cmLinearRegularExpression::Split:
+      this->AddClosure(in.Arg, atStart, atEnd, pcs, matches);
+      this->AddClosure(in.Alt, atStart, atEnd, pcs, matches);
+      break;
+    case cmLinearRegularExpression::Save:
+      this->AddClosure(pc + 1, atStart, atEnd, pcs, matches);
+      break;
+    case cmLinearRegularExpression::Bol:
+      if (atStart) {
+        this->AddClosure(pc + 1, atStart, atEnd, pcs, matches);
+      }
+      break;
+    case cmLinearRegularExpression::Eol:
+      // Wait for the end unless it is here.
+      if (atEnd) {
+        this->AddClosure(pc + 1, atStart, atEnd, pcs, matches);
+      } else {
+        pcs.push_back(pc);
+      }
+      break;
+    case cmLinearRegularExpression::Match:
+      matches.push_back(in.Arg);
+      break;
+    default:
+      pcs.push_back(pc);
+      break;
+  }
+}
+
+int cmLinearRegularExpressionSet::GetState(std::vector<int>& pcs,
+                                           std::vector<int>& matches)
+{
+  std::sort(pcs.begin(), pcs.end());
+  std::sort(matches.begin(), matches.end());
+  matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+  std::vector<int> key = pcs;
+  key.push_back(-1);
+  key.insert(key.end(), matches.begin(), matches.end());
+  std::map<std::vector<int>, int>::iterator i = this->StateIndex.find(key);
+  if (i != this->StateIndex.end()) {
+    return i->second;
+  }
+
+  int const index = static_cast<int>(this->States.size());
+  this->States.push_back(State());
+  State& state = this->States.back();
+  state.Pcs.swap(pcs);
+  state.Matches.swap(matches);
+  state.AtEnd = false;
+  for (std::vector<int>::const_iterator pi = state.Pcs.begin();
+       pi != state.Pcs.end(); ++pi) {
+    if (this->Program[*pi].Op == cmLinearRegularExpression::Eol) {
+      state.AtEnd = true;
+    }
+  }
+  this->Transitions.resize(this->Transitions.size() + 256, -1);
+  this->StateIndex.insert(std::make_pair(key, index));
+  return index;
+}
+
+int cmLinearRegularExpressionSet::Step(int state, unsigned char c)
+{
+  // Advance the instructions that match the character and start all
+  // patterns again at the next position.
+  std::vector<int> pcs;
+  std::vector<int> matches;
+  ++this->Generation;
+  std::vector<int> const& from = this->States[state].Pcs;
+  for (std::vector<int>::const_iterator i = from.begin(); i != from.end();
+       ++i) {
+    cmLinearRegularExpression::Instruction const& in = this->Program[*i];
+    bool next;
+    switch (in.Op) {
+      case cmLinearRegularExpression::Char:
+        next = in.Arg == c;
+        break;
+      case cmLinearRegularExpression::Any:
+        next = true;
+        break;
+      case cmLinearRegularExpression::Class:
+        next = this->Classes[in.Arg * 256 + c] != 0;
+        break;
+      default:
+        next = false;
+        break;
+    }
+    if (next) {
+      this->AddClosure(*i + 1, false, false, pcs, matches);
+    }
+  }
+  for (std::vector<int>::const_iterator i = this->Starts.begin();
+       i != this->Starts.end(); ++i) {
+    if (*i >= 0) {
+      this->AddClosure(*i, false, false, pcs, matches);
+    }
+  }
+
+  if (this->States.size() >= cmLinearRegularExpressionSetMaxStates) {
+    // Forget all states and build again those still needed.
+    this->Reset();
+    return this->GetState(pcs, matches);
+  }
+  int const next = this->GetState(pcs, matches);
+  this->Transitions[static_cast<size_t>(state) * 256 + c] = next;
+  return next;
+}
+
+void cmLinearRegularExpressionSet::Record(std::vector<int> const& matches)
+{
+  for (std::vector<int>::const_iterator i = matches.begin();
+       i != matches.end(); ++i) {
+    if (!this->Matches[*i]) {
+      this->Matches[*i] = 1;
+      this->MatchedPatterns.push_back(*i);
+    }
+  }
+}
+
+bool cmLinearRegularExpressionSet::Find(const char* string)
+{
+  for (std::vector<int>::const_iterator i = this->MatchedPatterns.begin();
+       i != this->MatchedPatterns.end(); ++i) {
+    this->Matches[*i] = 0;
+  }
+  this->MatchedPatterns.clear();
+  if (this->Program.empty()) {
+    return false;
+  }
+
+  if (this->StartState < 0) {
+    std::vector<int> pcs;
+    std::vector<int> matches;
+    ++this->Generation;
+    for (std::vector<int>::const_iterator i = this->Starts.begin();
+         i != this->Starts.end(); ++i) {
+      if (*i >= 0) {
+        this->AddClosure(*i, true, false, pcs, matches);
+      }
+    }
+    this->StartState = this->GetState(pcs, matches);
+  }
+
+  int state = this->StartState;
+  this->Record(this->States[state].Matches);
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(string);
+  for (; *p; ++p) {
+    int next = this->Transitions[static_cast<size_t>(state) * 256 + *p];
+    if (next < 0) {
+      next = this->Step(state, *p);
+    }
+    state = next;
+    if (!this->States[state].Matches.empty()) {
+      this->Record(this->States[state].Matches);
+    }
+  }
+
+  // Patterns waiting for the end of the string match now.
+  if (this->States[state].AtEnd) {
+    std::vector<int> pcs;
+    std::vector<int> matches;
+    bool const atStart = p == reinterpret_cast<const unsigned char*>(string);
+    ++this->Generation;
+    std::vector<int> const& at = this->States[state].Pcs;
+    for (std::vector<int>::const_iterator i = at.begin(); i != at.end();
+         ++i) {
+      if (this->Program[*i].Op == cmLinearRegularExpression::Eol) {
+        this->AddClosure(*i + 1, atStart, true, pcs, matches);
+      }
+    }
+    this->Record(matches);
+  }
+  return !this->MatchedPatterns.empty();
+}
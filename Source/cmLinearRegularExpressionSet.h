@@ -0,0 +1,85 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmLinearRegularExpressionSet_h
+#define cmLinearRegularExpressionSet_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include "cmLinearRegularExpression.h"
+
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** \class cmLinearRegularExpressionSet
+ * \brief Find which of many regular expressions match a string.
+ *
+ * cmLinearRegularExpressionSet combines the programs of the patterns
+ * added to it into one automaton that tells in a single pass over a
+ * string which of them match somewhere in it.  The automaton is a DFA
+ * whose states are built from the NFA as the input first needs them,
+ * so a set used for many similar strings soon runs one table lookup
+ * per character.
+ */
+class cmLinearRegularExpressionSet
+{
+public:
+  cmLinearRegularExpressionSet();
+
+  /** Add a pattern as the next index.  Returns false if it is not
+      valid, in which case it never matches.  */
+  bool Add(const char* pattern);
+  bool Add(std::string const& pattern) { return this->Add(pattern.c_str()); }
+
+  void Clear();
+  size_t GetNumberOfPatterns() const { return this->Starts.size(); }
+
+  /** Find the patterns that match somewhere in a string.  Returns true
+      if any of them does.  */
+  bool Find(const char* string);
+  bool Find(std::string const& string) { return this->Find(string.c_str()); }
+
+  /** Whether a pattern matched in the last find.  */
+  bool Matched(size_t index) const { return this->Matches[index] != 0; }
+
+  /** The first pattern from begin to end that matched in the last find,
+      or end if none did.  */
+  size_t FirstMatch(size_t begin, size_t end) const;
+
+private:
+  // The programs of all patterns, Match instructions giving the index
+  // of their pattern as Arg.  Start of each pattern, or -1 if invalid.
+  std::vector<cmLinearRegularExpression::Instruction> Program;
+  std::vector<char> Classes;
+  std::vector<int> Starts;
+
+  // Results of the last find.
+  std::vector<char> Matches;
+  std::vector<int> MatchedPatterns;
+
+  // A DFA state is the set of instructions the NFA is at when it needs
+  // the next character, and the patterns it matched in getting there.
+  struct State
+  {
+    std::vector<int> Pcs;
+    std::vector<int> Matches;
+    bool AtEnd; // Whether some instruction tests for the end.
+  };
+  std::vector<State> States;
+  std::vector<int> Transitions;
+  std::map<std::vector<int>, int> StateIndex;
+  int StartState;
+
+  std::vector<size_t> Marks;
+  size_t Generation;
+
+  void Reset();
+  void AddClosure(int pc, bool atStart, bool atEnd, std::vector<int>& pcs,
+                  std::vector<int>& matches);
+  int GetState(std::vector<int>& pcs, std::vector<int>& matches);
+  int Step(int state, unsigned char c);
+  void Record(std::vector<int> const& matches);
+};
+
+#endif
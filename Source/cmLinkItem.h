@@ -74,6 +74,14 @@ struct cmLinkInterfaceLibraries
 {
   // Libraries listed in the interface.
   std::vector<cmLinkItem> Libraries;
+
+  // Whether the libraries depend on the target linking to this one.
+  bool HadHeadSensitiveCondition;
+
+  cmLinkInterfaceLibraries()
+    : HadHeadSensitiveCondition(false)
+  {
+  }
 };
 
 struct cmLinkInterface : public cmLinkInterfaceLibraries
@@ -107,14 +115,12 @@ struct cmOptionalLinkInterface : public cmLinkInterface
     : LibrariesDone(false)
     , AllDone(false)
     , Exists(false)
-    , HadHeadSensitiveCondition(false)
     , ExplicitLibraries(CM_NULLPTR)
   {
   }
   bool LibrariesDone;
   bool AllDone;
   bool Exists;
-  bool HadHeadSensitiveCondition;
   const char* ExplicitLibraries;
 };
 
@@ -13,6 +13,7 @@
 #include "cmAlgorithms.h"
 #include "cmMakefile.h"
 #include "cmPolicies.h"
+#include "cmRegularExpressionCache.h"
 #include "cmSystemTools.h"
 #include "cmake.h"
 
@@ -66,68 +67,74 @@ bool cmListCommand::InitialPass(std::vector<std::string> const& args,
   return false;
 }
 
-bool cmListCommand::GetListString(std::string& listString,
-                                  const std::string& var)
+static std::vector<std::string> const* RemoveEmptyElements(
+  std::vector<std::string>& storage, std::vector<std::string> const& elements)
 {
-  // get the old value
-  const char* cacheValue = this->Makefile->GetDefinition(var);
-  if (!cacheValue) {
-    return false;
-  }
-  listString = cacheValue;
-  return true;
+  std::vector<std::string> nonEmpty;
+  std::remove_copy(elements.begin(), elements.end(),
+                   std::back_inserter(nonEmpty), std::string());
+  storage.swap(nonEmpty);
+  return &storage;
 }
 
 bool cmListCommand::GetList(std::vector<std::string>& list,
                             const std::string& var)
 {
-  std::string listString;
-  if (!this->GetListString(listString, var)) {
+  std::vector<std::string> const* elements =
+    this->GetListElements(list, var);
+  if (!elements) {
     return false;
   }
+  if (elements != &list) {
+    list = *elements;
+  }
+  return true;
+}
+
+std::vector<std::string> const* cmListCommand::GetListElements(
+  std::vector<std::string>& storage, const std::string& var)
+{
+  // get the elements kept with the value
+  size_t emptyElements = 0;
+  std::vector<std::string> const* elements =
+    this->Makefile->GetDefinitionList(var, storage, emptyElements);
+  if (!elements) {
+    return CM_NULLPTR;
+  }
   // if the size of the list
-  if (listString.empty()) {
-    return true;
+  if (elements->size() == 1 && emptyElements == 1) {
+    storage.clear();
+    return &storage;
   }
-  // expand the variable into a list
-  cmSystemTools::ExpandListArgument(listString, list, true);
   // if no empty elements then just return
-  if (std::find(list.begin(), list.end(), std::string()) == list.end()) {
-    return true;
+  if (emptyElements == 0) {
+    return elements;
   }
   // if we have empty elements we need to check policy CMP0007
   switch (this->Makefile->GetPolicyStatus(cmPolicies::CMP0007)) {
     case cmPolicies::WARN: {
       // Default is to warn and use old behavior
-      // OLD behavior is to allow compatibility, so recall
-      // ExpandListArgument without the true which will remove
-      // empty values
-      list.clear();
-      cmSystemTools::ExpandListArgument(listString, list);
+      // OLD behavior is to allow compatibility, so remove the empty values
       std::string warn = cmPolicies::GetPolicyWarning(cmPolicies::CMP0007);
       warn += " List has value = [";
-      warn += listString;
+      warn += this->Makefile->GetSafeDefinition(var);
       warn += "].";
       this->Makefile->IssueMessage(cmake::AUTHOR_WARNING, warn);
-      return true;
+      return RemoveEmptyElements(storage, *elements);
     }
     case cmPolicies::OLD:
-      // OLD behavior is to allow compatibility, so recall
-      // ExpandListArgument without the true which will remove
-      // empty values
-      list.clear();
-      cmSystemTools::ExpandListArgument(listString, list);
-      return true;
+      // OLD behavior is to allow compatibility, so remove the empty values
+      return RemoveEmptyElements(storage, *elements);
     case cmPolicies::NEW:
-      return true;
+      return elements;
     case cmPolicies::REQUIRED_IF_USED:
     case cmPolicies::REQUIRED_ALWAYS:
       this->Makefile->IssueMessage(
         cmake::FATAL_ERROR,
         cmPolicies::GetRequiredPolicyError(cmPolicies::CMP0007));
-      return false;
+      return CM_NULLPTR;
   }
-  return true;
+  return elements;
 }
 
 bool cmListCommand::HandleLengthCommand(std::vector<std::string> const& args)
@@ -139,12 +146,11 @@ bool cmListCommand::HandleLengthCommand(std::vector<std::string> const& args)
 
   const std::string& listName = args[1];
   const std::string& variableName = args[args.size() - 1];
-  std::vector<std::string> varArgsExpanded;
-  // do not check the return value here
-  // if the list var is not found varArgsExpanded will have size 0
-  // and we will return 0
-  this->GetList(varArgsExpanded, listName);
-  size_t length = varArgsExpanded.size();
+  std::vector<std::string> storage;
+  // if the list var is not found the length is 0
+  std::vector<std::string> const* elements =
+    this->GetListElements(storage, listName);
+  size_t length = elements ? elements->size() : 0;
   char buffer[1024];
   sprintf(buffer, "%d", static_cast<int>(length));
 
@@ -162,11 +168,14 @@ bool cmListCommand::HandleGetCommand(std::vector<std::string> const& args)
   const std::string& listName = args[1];
   const std::string& variableName = args[args.size() - 1];
   // expand the variable
-  std::vector<std::string> varArgsExpanded;
-  if (!this->GetList(varArgsExpanded, listName)) {
+  std::vector<std::string> storage;
+  std::vector<std::string> const* elements =
+    this->GetListElements(storage, listName);
+  if (!elements) {
     this->Makefile->AddDefinition(variableName, "NOTFOUND");
     return true;
   }
+  std::vector<std::string> const& varArgsExpanded = *elements;
   // FIXME: Add policy to make non-existing lists an error like empty lists.
   if (varArgsExpanded.empty()) {
     this->SetError("GET given empty list");
@@ -208,16 +217,15 @@ bool cmListCommand::HandleAppendCommand(std::vector<std::string> const& args)
   }
 
   const std::string& listName = args[1];
-  // expand the variable
-  std::string listString;
-  this->GetListString(listString, listName);
-
-  if (!listString.empty() && !args.empty()) {
-    listString += ";";
+  // append to the value in place so that growing a list is linear
+  const char* listString = this->Makefile->GetDefinition(listName);
+  std::string value;
+  if (listString && *listString) {
+    value = ";";
   }
-  listString += cmJoin(cmMakeRange(args).advance(2), ";");
+  value += cmJoin(cmMakeRange(args).advance(2), ";");
 
-  this->Makefile->AddDefinition(listName, listString.c_str());
+  this->Makefile->AppendDefinition(listName, value);
   return true;
 }
 
@@ -231,13 +239,16 @@ bool cmListCommand::HandleFindCommand(std::vector<std::string> const& args)
   const std::string& listName = args[1];
   const std::string& variableName = args[args.size() - 1];
   // expand the variable
-  std::vector<std::string> varArgsExpanded;
-  if (!this->GetList(varArgsExpanded, listName)) {
+  std::vector<std::string> storage;
+  std::vector<std::string> const* elements =
+    this->GetListElements(storage, listName);
+  if (!elements) {
     this->Makefile->AddDefinition(variableName, "-1");
     return true;
   }
+  std::vector<std::string> const& varArgsExpanded = *elements;
 
-  std::vector<std::string>::iterator it =
+  std::vector<std::string>::const_iterator it =
     std::find(varArgsExpanded.begin(), varArgsExpanded.end(), args[2]);
   if (it != varArgsExpanded.end()) {
     std::ostringstream indexStream;
@@ -524,8 +535,8 @@ bool cmListCommand::FilterRegex(std::vector<std::string> const& args,
                                 std::vector<std::string>& varArgsExpanded)
 {
   const std::string& pattern = args[4];
-  cmsys::RegularExpression regex(pattern);
-  if (!regex.is_valid()) {
+  cmsys::RegularExpression* regex = cmRegularExpressionCache::Get(pattern);
+  if (!regex) {
     std::string error = "sub-command FILTER, mode REGEX ";
     error += "failed to compile regex \"";
     error += pattern;
@@ -537,7 +548,7 @@ bool cmListCommand::FilterRegex(std::vector<std::string> const& args,
   std::vector<std::string>::iterator argsBegin = varArgsExpanded.begin();
   std::vector<std::string>::iterator argsEnd = varArgsExpanded.end();
   std::vector<std::string>::iterator newArgsEnd =
-    std::remove_if(argsBegin, argsEnd, MatchesRegex(regex, includeMatches));
+    std::remove_if(argsBegin, argsEnd, MatchesRegex(*regex, includeMatches));
 
   std::string value = cmJoin(cmMakeRange(argsBegin, newArgsEnd), ";");
   this->Makefile->AddDefinition(listName, value.c_str());
@@ -57,7 +57,8 @@ protected:
                    std::vector<std::string>& varArgsExpanded);
 
   bool GetList(std::vector<std::string>& list, const std::string& var);
-  bool GetListString(std::string& listString, const std::string& var);
+  std::vector<std::string> const* GetListElements(
+    std::vector<std::string>& storage, const std::string& var);
 };
 
 #endif
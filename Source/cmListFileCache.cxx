@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmListFileCache.h"
 
+#include "cmAlgorithms.h"
 #include "cmListFileLexer.h"
 #include "cmMessenger.h"
 #include "cmOutputConverter.h"
@@ -12,8 +13,13 @@
 #include <algorithm>
 #include <assert.h>
 #include <cmConfigure.h>
+#include <ctype.h>
 #include <sstream>
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#include "cmListFileParseCache.h"
+#endif
+
 struct cmListFileParser
 {
   cmListFileParser(cmListFile* lf, cmListFileBacktrace lfbt,
@@ -31,6 +37,7 @@ struct cmListFileParser
   const char* FileName;
   cmListFileLexer* Lexer;
   cmListFileFunction Function;
+  bool HaveWarnings;
   enum
   {
     SeparationOkay,
@@ -47,6 +54,7 @@ cmListFileParser::cmListFileParser(cmListFile* lf, cmListFileBacktrace lfbt,
   , Messenger(messenger)
   , FileName(filename)
   , Lexer(cmListFileLexer_New())
+  , HaveWarnings(false)
 {
 }
 
@@ -126,19 +134,40 @@ bool cmListFileParser::ParseFile()
 }
 
 bool cmListFile::ParseFile(const char* filename, cmMessenger* messenger,
-                           cmListFileBacktrace const& lfbt)
+                           cmListFileBacktrace const& lfbt,
+                           cmListFileParseCache* cache)
 {
   if (!cmSystemTools::FileExists(filename) ||
       cmSystemTools::FileIsDirectory(filename)) {
     return false;
   }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (cache && cache->Lookup(filename, this->Functions)) {
+    return true;
+  }
+#else
+  static_cast<void>(cache);
+#endif
+
   bool parseError = false;
+  bool haveWarnings = false;
 
   {
     cmListFileParser parser(this, lfbt, messenger, filename);
     parseError = !parser.ParseFile();
+    haveWarnings = parser.HaveWarnings;
+  }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Files that produced diagnostics are not cached so that later
+  // runs parse them again and repeat the messages.
+  if (cache && !parseError && !haveWarnings) {
+    cache->Store(filename, this->Functions);
   }
+#else
+  static_cast<void>(haveWarnings);
+#endif
 
   return !parseError;
 }
@@ -268,6 +297,125 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     return false;
   }
   this->Messenger->IssueMessage(cmake::AUTHOR_WARNING, m.str(), lfbt);
+  this->HaveWarnings = true;
+  return true;
+}
+
+static bool cmListFileIsNameChar(char c)
+{
+  return isalnum(c) || c == '_' || c == '/' || c == '.' || c == '+' ||
+    c == '-';
+}
+
+bool cmListFileArgument::Tokenize() const
+{
+  // This follows cmMakefile::ExpandVariablesInStringNew for arguments of
+  // commands, which have escapes but no @VAR@ references.  Anything it
+  // would report an error for is left to it.
+  this->Segments.clear();
+  std::string literal;
+  std::string name;
+  cmListFileArgumentSegment::SegmentKind kind =
+    cmListFileArgumentSegment::Literal;
+  for (const char* in = this->Value.c_str(); *in; ++in) {
+    char const c = *in;
+    if (kind != cmListFileArgumentSegment::Literal) {
+      // Inside of a variable reference.
+      if (c == '}') {
+        if (name == "CMAKE_CURRENT_LIST_LINE") {
+          return false;
+        }
+        if (!literal.empty()) {
+          this->Segments.push_back(
+            cmListFileArgumentSegment(cmListFileArgumentSegment::Literal,
+                                      literal));
+          literal.clear();
+        }
+        this->Segments.push_back(cmListFileArgumentSegment(kind, name));
+        name.clear();
+        kind = cmListFileArgumentSegment::Literal;
+      } else if (c == '$') {
+        // Nested references are not represented.
+        const char* next = in + 1;
+        if (*next == '{' || cmHasLiteralPrefix(next, "ENV{") ||
+            cmHasLiteralPrefix(next, "CACHE{")) {
+          return false;
+        }
+        const char* end = next;
+        while (cmListFileIsNameChar(*end)) {
+          ++end;
+        }
+        if (end != next && *end == '{') {
+          return false;
+        }
+        name += c;
+      } else if (c == '\\') {
+        return false;
+      } else if (c == '\n' || cmListFileIsNameChar(c)) {
+        name += c;
+      } else {
+        return false;
+      }
+      continue;
+    }
+
+    if (c == '$') {
+      const char* next = in + 1;
+      if (*next == '{') {
+        kind = cmListFileArgumentSegment::Variable;
+        ++in;
+        continue;
+      }
+      if (cmHasLiteralPrefix(next, "ENV{")) {
+        kind = cmListFileArgumentSegment::Environment;
+        in += 4;
+        continue;
+      }
+      if (cmHasLiteralPrefix(next, "CACHE{")) {
+        kind = cmListFileArgumentSegment::Cache;
+        in += 6;
+        continue;
+      }
+      if (*next != '<') {
+        // The expansion reports the unsupported $NAME{} syntax.
+        const char* end = next;
+        while (cmListFileIsNameChar(*end)) {
+          ++end;
+        }
+        if (end != next && *end == '{') {
+          return false;
+        }
+      }
+      literal += c;
+    } else if (c == '\\') {
+      char const nextc = in[1];
+      if (nextc == 't') {
+        literal += '\t';
+      } else if (nextc == 'n') {
+        literal += '\n';
+      } else if (nextc == 'r') {
+        literal += '\r';
+      } else if (nextc == ';') {
+        // Handled in ExpandListArgument; pass the backslash literally.
+        literal += "\\;";
+      } else if (isalnum(nextc) || nextc == '\0') {
+        return false;
+      } else {
+        literal += nextc;
+      }
+      ++in;
+    } else {
+      literal += c;
+    }
+  }
+  if (kind != cmListFileArgumentSegment::Literal) {
+    // An unterminated variable reference is an error.
+    return false;
+  }
+  if (!literal.empty()) {
+    this->Segments.push_back(
+      cmListFileArgumentSegment(cmListFileArgumentSegment::Literal, literal));
+  }
   return true;
 }
 
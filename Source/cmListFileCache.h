@@ -18,6 +18,8 @@
  * cmake list files.
  */
 
+class cmCommand;
+class cmListFileParseCache;
 class cmMessenger;
 
 struct cmCommandContext
@@ -31,6 +33,25 @@ struct cmCommandContext
   }
 };
 
+/** A piece of a command argument as seen by variable expansion.  */
+struct cmListFileArgumentSegment
+{
+  enum SegmentKind
+  {
+    Literal,     // text with escape sequences already replaced
+    Variable,    // ${Text}
+    Environment, // $ENV{Text}
+    Cache        // $CACHE{Text}
+  };
+  cmListFileArgumentSegment(SegmentKind kind, std::string const& text)
+    : Kind(kind)
+    , Text(text)
+  {
+  }
+  SegmentKind Kind;
+  std::string Text;
+};
+
 struct cmListFileArgument
 {
   enum Delimiter
@@ -39,22 +60,33 @@ struct cmListFileArgument
     Quoted,
     Bracket
   };
+  enum TokenState
+  {
+    NotTokenized, // not expanded yet
+    ExpandedOnce, // expanded once without tokens
+    Tokenized,    // Segments hold the tokens
+    Untokenizable // expansion must parse the value
+  };
   cmListFileArgument()
     : Value()
     , Delim(Unquoted)
     , Line(0)
+    , State(NotTokenized)
   {
   }
   cmListFileArgument(const cmListFileArgument& r)
     : Value(r.Value)
     , Delim(r.Delim)
     , Line(r.Line)
+    , Segments(r.Segments)
+    , State(r.State)
   {
   }
   cmListFileArgument(const std::string& v, Delimiter d, long line)
     : Value(v)
     , Delim(d)
     , Line(line)
+    , State(NotTokenized)
   {
   }
   bool operator==(const cmListFileArgument& r) const
@@ -62,9 +94,23 @@ struct cmListFileArgument
     return (this->Value == r.Value) && (this->Delim == r.Delim);
   }
   bool operator!=(const cmListFileArgument& r) const { return !(*this == r); }
+
+  /**
+   * Split the value into literal text and variable references the way
+   * the CMP0053 NEW variable expansion does.  Returns false if the value
+   * uses syntax the segments cannot represent, such as nested or
+   * malformed references, or ${CMAKE_CURRENT_LIST_LINE}.
+   */
+  bool Tokenize() const;
+
   std::string Value;
   Delimiter Delim;
   long Line;
+
+  // The tokens of the value, filled in once the argument is expanded
+  // repeatedly.  See cmMakefile::ExpandArguments.
+  mutable std::vector<cmListFileArgumentSegment> Segments;
+  mutable TokenState State;
 };
 
 class cmListFileContext
@@ -98,7 +144,17 @@ bool operator!=(cmListFileContext const& lhs, cmListFileContext const& rhs);
 
 struct cmListFileFunction : public cmCommandContext
 {
+  cmListFileFunction()
+    : Command(CM_NULLPTR)
+    , CommandGeneration(0)
+  {
+  }
   std::vector<cmListFileArgument> Arguments;
+
+  // The command last found for the name by cmState::GetCommand and the
+  // generation of the commands it was found in.
+  mutable cmCommand* Command;
+  mutable unsigned long CommandGeneration;
 };
 
 // Represent a backtrace (call stack).  Provide value semantics
@@ -156,8 +212,14 @@ private:
 
 struct cmListFile
 {
+  /**
+   * Parse the given file.  If a parse cache is given, the functions are
+   * taken from it when it holds an up-to-date entry for the file, and
+   * files parsed without any diagnostic are recorded in it.
+   */
   bool ParseFile(const char* path, cmMessenger* messenger,
-                 cmListFileBacktrace const& lfbt);
+                 cmListFileBacktrace const& lfbt,
+                 cmListFileParseCache* cache = CM_NULLPTR);
 
   std::vector<cmListFileFunction> Functions;
 };
@@ -0,0 +1,321 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmListFileParseCache.h"
+
+#include "cmCryptoHash.h"
+#include "cmListFileCache.h"
+#include "cmSystemTools.h"
+
+#include <cm_kwiml.h>
+#include <cmsys/FStream.hxx>
+#include <iterator>
+#include <sstream>
+#include <time.h>
+
+// The cache file starts with this signature.  Bump the trailing
+// version number whenever the layout written by Save changes.
+static const char cmListFileParseCacheSignature[] = "CMLFPC1\n";
+
+namespace {
+
+// Integers are stored as 8 little-endian bytes so the file does not
+// depend on the host word size or byte order.
+void WriteInt(std::string& out, KWIML_INT_int64_t value)
+{
+  KWIML_INT_uint64_t v = static_cast<KWIML_INT_uint64_t>(value);
+  for (int i = 0; i < 8; ++i) {
+    out += static_cast<char>(v & 0xff);
+    v >>= 8;
+  }
+}
+
+void WriteString(std::string& out, std::string const& value)
+{
+  WriteInt(out, static_cast<KWIML_INT_int64_t>(value.size()));
+  out += value;
+}
+
+// Decode values from a buffer, failing on truncated input.
+class Reader
+{
+public:
+  Reader(std::string const& data)
+    : Data(data)
+    , Pos(0)
+  {
+  }
+
+  bool ReadInt(KWIML_INT_int64_t& value)
+  {
+    if (this->Data.size() - this->Pos < 8) {
+      return false;
+    }
+    KWIML_INT_uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+      v = (v << 8) |
+        static_cast<unsigned char>(this->Data[this->Pos + i]);
+    }
+    this->Pos += 8;
+    value = static_cast<KWIML_INT_int64_t>(v);
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    KWIML_INT_int64_t size;
+    if (!this->ReadInt(size) || size < 0 ||
+        static_cast<KWIML_INT_uint64_t>(size) >
+          this->Data.size() - this->Pos) {
+      return false;
+    }
+    value.assign(this->Data, this->Pos, static_cast<size_t>(size));
+    this->Pos += static_cast<size_t>(size);
+    return true;
+  }
+
+  bool ReadSignature()
+  {
+    std::string::size_type n = sizeof(cmListFileParseCacheSignature) - 1;
+    if (this->Data.compare(0, n, cmListFileParseCacheSignature) != 0) {
+      return false;
+    }
+    this->Pos = n;
+    return true;
+  }
+
+  bool AtEnd() const { return this->Pos == this->Data.size(); }
+
+private:
+  std::string const& Data;
+  std::string::size_type Pos;
+};
+
+// A file changed again within the second its time was taken may keep
+// that time, so only an older time shows that the content is unchanged.
+// A time that cannot be trusted yet is recorded as -1, which no file
+// has, so that the content hash decides.
+long TrustedTime(long mtime)
+{
+  return mtime < static_cast<long>(time(CM_NULLPTR)) ? mtime : -1;
+}
+
+void EncodeFunctions(std::string& out,
+                     std::vector<cmListFileFunction> const& functions)
+{
+  WriteInt(out, static_cast<KWIML_INT_int64_t>(functions.size()));
+  for (std::vector<cmListFileFunction>::const_iterator fi = functions.begin();
+       fi != functions.end(); ++fi) {
+    WriteString(out, fi->Name);
+    WriteInt(out, fi->Line);
+    WriteInt(out, static_cast<KWIML_INT_int64_t>(fi->Arguments.size()));
+    for (std::vector<cmListFileArgument>::const_iterator ai =
+           fi->Arguments.begin();
+         ai != fi->Arguments.end(); ++ai) {
+      WriteString(out, ai->Value);
+      WriteInt(out, ai->Delim);
+      WriteInt(out, ai->Line);
+    }
+  }
+}
+
+bool DecodeFunctions(std::string const& data,
+                     std::vector<cmListFileFunction>& functions)
+{
+  Reader reader(data);
+  KWIML_INT_int64_t numFunctions;
+  if (!reader.ReadInt(numFunctions) || numFunctions < 0) {
+    return false;
+  }
+  functions.resize(static_cast<size_t>(numFunctions));
+  for (std::vector<cmListFileFunction>::iterator fi = functions.begin();
+       fi != functions.end(); ++fi) {
+    KWIML_INT_int64_t line;
+    KWIML_INT_int64_t numArguments;
+    if (!reader.ReadString(fi->Name) || !reader.ReadInt(line) ||
+        !reader.ReadInt(numArguments) || numArguments < 0) {
+      return false;
+    }
+    fi->Line = static_cast<long>(line);
+    fi->Arguments.resize(static_cast<size_t>(numArguments));
+    for (std::vector<cmListFileArgument>::iterator ai =
+           fi->Arguments.begin();
+         ai != fi->Arguments.end(); ++ai) {
+      KWIML_INT_int64_t delim;
+      if (!reader.ReadString(ai->Value) || !reader.ReadInt(delim) ||
+          !reader.ReadInt(line) || delim < cmListFileArgument::Unquoted ||
+          delim > cmListFileArgument::Bracket) {
+        return false;
+      }
+      ai->Delim = static_cast<cmListFileArgument::Delimiter>(delim);
+      ai->Line = static_cast<long>(line);
+    }
+  }
+  return reader.AtEnd();
+}
+}
+
+cmListFileParseCache::cmListFileParseCache()
+  : Modified(false)
+  , Hits(0)
+  , Misses(0)
+{
+}
+
+void cmListFileParseCache::Load(std::string const& file)
+{
+  this->File = file;
+  this->Entries.clear();
+  this->Modified = false;
+
+  // Read the whole file with a single read and decode the function
+  // streams of individual entries lazily in Lookup.
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return;
+  }
+  std::string data((std::istreambuf_iterator<char>(fin)),
+                   std::istreambuf_iterator<char>());
+
+  Reader reader(data);
+  KWIML_INT_int64_t numEntries;
+  if (!reader.ReadSignature() || !reader.ReadInt(numEntries)) {
+    return;
+  }
+  EntryMap entries;
+  for (KWIML_INT_int64_t i = 0; i < numEntries; ++i) {
+    std::string path;
+    Entry entry;
+    KWIML_INT_int64_t size;
+    KWIML_INT_int64_t mtime;
+    if (!reader.ReadString(path) || !reader.ReadInt(size) ||
+        !reader.ReadInt(mtime) || !reader.ReadString(entry.Hash) ||
+        !reader.ReadString(entry.Data)) {
+      // Ignore a truncated or corrupt cache file entirely.
+      return;
+    }
+    entry.Size = static_cast<unsigned long>(size);
+    entry.MTime = static_cast<long>(mtime);
+    entry.Used = false;
+    entries[path] = entry;
+  }
+  if (reader.AtEnd()) {
+    this->Entries.swap(entries);
+  }
+}
+
+bool cmListFileParseCache::Save()
+{
+  if (this->File.empty()) {
+    return true;
+  }
+
+  // Keep only the entries of files read by this run so that those of
+  // removed or renamed files do not pile up.
+  KWIML_INT_int64_t numUsed = 0;
+  for (EntryMap::const_iterator i = this->Entries.begin();
+       i != this->Entries.end(); ++i) {
+    if (i->second.Used) {
+      ++numUsed;
+    }
+  }
+  if (!this->Modified &&
+      numUsed == static_cast<KWIML_INT_int64_t>(this->Entries.size())) {
+    return true;
+  }
+
+  std::string data = cmListFileParseCacheSignature;
+  WriteInt(data, numUsed);
+  for (EntryMap::const_iterator i = this->Entries.begin();
+       i != this->Entries.end(); ++i) {
+    if (!i->second.Used) {
+      continue;
+    }
+    WriteString(data, i->first);
+    WriteInt(data, static_cast<KWIML_INT_int64_t>(i->second.Size));
+    WriteInt(data, i->second.MTime);
+    WriteString(data, i->second.Hash);
+    WriteString(data, i->second.Data);
+  }
+
+  // Concurrent configure runs may share the cache file, so write it to a
+  // file of our own first and move that into place.  Readers then never
+  // see a partially written file.
+  std::ostringstream tempFile;
+  tempFile << this->File << "." << std::hex << cmSystemTools::RandomSeed()
+           << ".tmp";
+  {
+    cmsys::ofstream fout(tempFile.str().c_str(),
+                         std::ios::out | std::ios::binary);
+    if (!fout) {
+      return false;
+    }
+    fout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    fout.close();
+    if (!fout) {
+      cmSystemTools::RemoveFile(tempFile.str());
+      return false;
+    }
+  }
+  if (!cmSystemTools::RenameFile(tempFile.str().c_str(),
+                                 this->File.c_str())) {
+    cmSystemTools::RemoveFile(tempFile.str());
+    return false;
+  }
+  this->Modified = false;
+  return true;
+}
+
+bool cmListFileParseCache::Lookup(std::string const& path,
+                                  std::vector<cmListFileFunction>& functions)
+{
+  EntryMap::iterator i = this->Entries.find(path);
+  if (i != this->Entries.end()) {
+    // Hash the content only if the file was touched without changing
+    // its size.  Remember the new time to not hash it again next run.
+    Entry current;
+    if (Stat(path, current) && current.Size == i->second.Size &&
+        (current.MTime == i->second.MTime ||
+         (Hash(path, current) && current.Hash == i->second.Hash)) &&
+        DecodeFunctions(i->second.Data, functions)) {
+      long const mtime = TrustedTime(current.MTime);
+      if (mtime != i->second.MTime) {
+        i->second.MTime = mtime;
+        this->Modified = true;
+      }
+      i->second.Used = true;
+      ++this->Hits;
+      return true;
+    }
+    functions.clear();
+  }
+  ++this->Misses;
+  return false;
+}
+
+void cmListFileParseCache::Store(
+  std::string const& path, std::vector<cmListFileFunction> const& functions)
+{
+  Entry entry;
+  if (!Stat(path, entry) || !Hash(path, entry)) {
+    return;
+  }
+  EncodeFunctions(entry.Data, functions);
+  entry.MTime = TrustedTime(entry.MTime);
+  entry.Used = true;
+  this->Entries[path] = entry;
+  this->Modified = true;
+}
+
+bool cmListFileParseCache::Stat(std::string const& path, Entry& entry)
+{
+  entry.Size = cmSystemTools::FileLength(path);
+  entry.MTime = cmSystemTools::ModifiedTime(path);
+  return entry.MTime != 0;
+}
+
+bool cmListFileParseCache::Hash(std::string const& path, Entry& entry)
+{
+  cmCryptoHashMD5 md5;
+  entry.Hash = md5.HashFile(path);
+  return !entry.Hash.empty();
+}
@@ -0,0 +1,72 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmListFileParseCache_h
+#define cmListFileParseCache_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct cmListFileFunction;
+
+/** \class cmListFileParseCache
+ * \brief Persistent cache of parsed list files.
+ *
+ * cmListFileParseCache stores the functions parsed from each list file
+ * in a binary file on disk so that later configure runs can skip the
+ * lexer and parser for files that did not change.  An entry is used
+ * when the size and modification time of the file still match the values
+ * recorded when it was stored.  If only the modification time changed,
+ * the content hash decides.  Entries of files not read by a run are
+ * dropped when it saves the cache.
+ */
+class cmListFileParseCache
+{
+public:
+  cmListFileParseCache();
+
+  /** Load the entries recorded in the given cache file, if it exists.
+      The same file is written by Save.  */
+  void Load(std::string const& file);
+
+  /** Write the entries used since Load back to the cache file if any
+      were added or not used.  Returns false if the file could not be
+      written.  */
+  bool Save();
+
+  /** Get the functions of a list file parsed by a previous run.
+      Returns false if there is no valid entry for the file.  */
+  bool Lookup(std::string const& path,
+              std::vector<cmListFileFunction>& functions);
+
+  /** Record the functions parsed from a list file.  */
+  void Store(std::string const& path,
+             std::vector<cmListFileFunction> const& functions);
+
+  /** Number of list files served from / missing in the cache.  */
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    unsigned long Size;
+    long MTime;
+    std::string Hash;
+    std::string Data;
+    bool Used;
+  };
+  typedef std::map<std::string, Entry> EntryMap;
+  EntryMap Entries;
+  std::string File;
+  bool Modified;
+  unsigned long Hits;
+  unsigned long Misses;
+
+  static bool Stat(std::string const& path, Entry& entry);
+  static bool Hash(std::string const& path, Entry& entry);
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "cmLocalGenerator.h"
 
 #include "cmAlgorithms.h"
+#include "cmComputeLinkDepends.h"
 #include "cmComputeLinkInformation.h"
 #include "cmCustomCommandGenerator.h"
 #include "cmGeneratedFileStream.h"
@@ -80,6 +81,8 @@ cmLocalGenerator::cmLocalGenerator(cmGlobalGenerator* gg, cmMakefile* makefile)
   this->BackwardsCompatibility = 0;
   this->BackwardsCompatibilityFinal = false;
 
+  this->LinkDependsCache = new cmComputeLinkDependsCache;
+
   this->ComputeObjectMaxPath();
 
   std::vector<std::string> enabledLanguages =
@@ -146,6 +149,7 @@ cmLocalGenerator::~cmLocalGenerator()
 {
   cmDeleteAll(this->GeneratorTargets);
   cmDeleteAll(this->OwnedImportedGeneratorTargets);
+  delete this->LinkDependsCache;
 }
 
 void cmLocalGenerator::IssueMessage(cmake::MessageType t,
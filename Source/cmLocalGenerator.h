@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+class cmComputeLinkDependsCache;
 class cmComputeLinkInformation;
 class cmCustomCommandGenerator;
 class cmGeneratorTarget;
@@ -142,6 +143,12 @@ public:
     const std::string& name) const;
   cmGeneratorTarget* FindGeneratorTargetToUse(const std::string& name) const;
 
+  /** Link dependencies computed for the targets of this directory.  */
+  cmComputeLinkDependsCache& GetLinkDependsCache() const
+  {
+    return *this->LinkDependsCache;
+  }
+
   /**
    * Encode a list of preprocessor definitions for the compiler
    * command line.
@@ -360,6 +367,8 @@ protected:
   bool BackwardsCompatibilityFinal;
 
 private:
+  cmComputeLinkDependsCache* LinkDependsCache;
+
   void AddSharedFlags(std::string& flags, const std::string& lang,
                       bool shared);
   bool GetShouldUseOldFlags(bool shared, const std::string& lang) const;
@@ -79,6 +79,8 @@ void cmLocalNinjaGenerator::Generate()
     }
   }
 
+  this->GetGlobalNinjaGenerator()->OpenDirectoryBuildFileStream(this);
+
   std::vector<cmGeneratorTarget*> targets = this->GetGeneratorTargets();
   for (std::vector<cmGeneratorTarget*>::iterator t = targets.begin();
        t != targets.end(); ++t) {
@@ -98,6 +100,8 @@ void cmLocalNinjaGenerator::Generate()
   }
 
   this->WriteCustomCommandBuildStatements();
+
+  this->GetGlobalNinjaGenerator()->CloseDirectoryBuildFileStream();
 }
 
 // TODO: Picked up from cmLocalUnixMakefileGenerator3.  Refactor it.
@@ -26,6 +26,7 @@
 // Include dependency scanners for supported languages.  Only the
 // C/C++ scanner is needed for bootstrapping CMake.
 #include "cmDependsC.h"
+#include "cmDependsCompiler.h"
 #ifdef CMAKE_BUILD_WITH_CMAKE
 #include "cmDependsFortran.h"
 #include "cmDependsJava.h"
@@ -1360,7 +1361,13 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(const char* tgtInfo,
       dependFile.c_str(), internalDependFile.c_str(), validDependencies);
   }
 
-  if (needRescanDependInfo || needRescanDirInfo || needRescanDependencies) {
+  // The compiler rewrites the dependency file of every object it
+  // compiles, so read those again whenever one has changed.
+  bool needRescanCompilerDepends =
+    this->CheckCompilerDepends(internalDependFile, verbose, validDependencies);
+
+  if (needRescanDependInfo || needRescanDirInfo || needRescanDependencies ||
+      needRescanCompilerDepends) {
     // The dependencies must be regenerated.
     std::string targetName = cmSystemTools::GetFilenameName(dir);
     targetName = targetName.substr(0, targetName.length() - 4);
@@ -1482,6 +1489,71 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
     }
   }
 
+  // Collect the dependencies the compiler wrote while compiling.
+  if (mf->GetDefinition("CMAKE_DEPENDS_CHECK_COMPILER")) {
+    cmDependsCompiler scanner(this, &validDeps);
+    scanner.SetFileComparison(
+      this->GlobalGenerator->GetCMakeInstance()->GetFileComparison());
+    scanner.SetLanguage("COMPILER");
+    scanner.SetTargetDirectory(dir.c_str());
+    scanner.Write(ruleFileStream, internalRuleFileStream);
+  }
+
+  return true;
+}
+
+bool cmLocalUnixMakefileGenerator3::CheckCompilerDepends(
+  std::string const& internalDependFile, bool verbose,
+  std::map<std::string, cmDepends::DependencyVector>& validDeps)
+{
+  const char* pairsStr =
+    this->Makefile->GetDefinition("CMAKE_DEPENDS_CHECK_COMPILER");
+  if (!pairsStr) {
+    return false;
+  }
+  std::vector<std::string> pairs;
+  cmSystemTools::ExpandListArgument(pairsStr, pairs);
+
+  cmFileTimeComparison* ftc =
+    this->GlobalGenerator->GetCMakeInstance()->GetFileComparison();
+  std::set<std::string> changedObjects;
+  for (std::vector<std::string>::const_iterator pi = pairs.begin();
+       pi != pairs.end() && pi + 1 != pairs.end(); pi += 2) {
+    // A dependency file exists only once its object was compiled.
+    std::string const& depfile = *pi;
+    if (!cmSystemTools::FileExists(depfile.c_str())) {
+      continue;
+    }
+    int result;
+    if (!ftc->FileTimeCompare(internalDependFile.c_str(), depfile.c_str(),
+                              &result) ||
+        result < 0) {
+      if (verbose) {
+        std::ostringstream msg;
+        msg << "Dependee \"" << depfile << "\" is newer than depender \""
+            << internalDependFile << "\"." << std::endl;
+        cmSystemTools::Stdout(msg.str().c_str());
+      }
+      changedObjects.insert(*(pi + 1));
+    }
+  }
+  if (changedObjects.empty()) {
+    return false;
+  }
+
+  // The dependencies of the other objects are still valid.  Those read
+  // back from depend.internal name objects relative to the top.
+  std::string const binDir = this->GetBinaryDirectory();
+  for (std::map<std::string, cmDepends::DependencyVector>::iterator vi =
+         validDeps.begin();
+       vi != validDeps.end();) {
+    if (changedObjects.count(
+          cmSystemTools::CollapseFullPath(vi->first, binDir))) {
+      validDeps.erase(vi++);
+    } else {
+      ++vi;
+    }
+  }
   return true;
 }
 
@@ -1876,6 +1948,25 @@ void cmLocalUnixMakefileGenerator3::WriteDependLanguageInfo(
     cmakefileStream << "  )\n";
   }
 
+  // list the dependency files written by the compiler
+  ImplicitDependFileMap const& compilerPairs =
+    this->GetCompilerDepends(target);
+  if (!compilerPairs.empty()) {
+    cmakefileStream
+      << "\n"
+      << "# The set of dependency files written by the compiler:\n";
+    cmakefileStream << "set(CMAKE_DEPENDS_CHECK_COMPILER\n";
+    for (ImplicitDependFileMap::const_iterator pi = compilerPairs.begin();
+         pi != compilerPairs.end(); ++pi) {
+      for (cmDepends::DependencyVector::const_iterator di = pi->second.begin();
+           di != pi->second.end(); ++di) {
+        cmakefileStream << "  \"" << *di << "\" ";
+        cmakefileStream << "\"" << pi->first << "\"\n";
+      }
+    }
+    cmakefileStream << "  )\n";
+  }
+
   // Store include transform rule properties.  Write the directory
   // rules first because they may be overridden by later target rules.
   std::vector<std::string> transformRules;
@@ -2068,6 +2159,34 @@ void cmLocalUnixMakefileGenerator3::AddImplicitDepends(
   this->ImplicitDepends[tgt->GetName()][lang][obj].push_back(src);
 }
 
+cmLocalUnixMakefileGenerator3::ImplicitDependFileMap const&
+cmLocalUnixMakefileGenerator3::GetCompilerDepends(const cmGeneratorTarget* tgt)
+{
+  return this->CompilerDepends[tgt->GetName()];
+}
+
+void cmLocalUnixMakefileGenerator3::AddCompilerDepends(
+  const cmGeneratorTarget* tgt, const char* obj, const char* depfile)
+{
+  this->CompilerDepends[tgt->GetName()][obj].push_back(depfile);
+}
+
+bool cmLocalUnixMakefileGenerator3::GetUseCompilerDepends(
+  const std::string& lang)
+{
+  // Only the languages scanned by cmDependsC may be handed over to the
+  // compiler.  Fortran needs its scanner to order module dependencies.
+  if (lang != "C" && lang != "CXX" && lang != "ASM") {
+    return false;
+  }
+  if (!this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER")) {
+    return false;
+  }
+  std::string const flagsVar = "CMAKE_DEPFILE_FLAGS_" + lang;
+  const char* flags = this->Makefile->GetDefinition(flagsVar);
+  return flags && *flags;
+}
+
 void cmLocalUnixMakefileGenerator3::CreateCDCommand(
   std::vector<std::string>& commands, const char* tgtDir,
   std::string const& relDir)
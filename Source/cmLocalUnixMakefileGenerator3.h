@@ -162,6 +162,18 @@ public:
                           const std::string& lang, const char* obj,
                           const char* src);
 
+  // Dependency files written by the compiler.  The key of the map is
+  // the object file and the value is its dependency file.
+  ImplicitDependFileMap const& GetCompilerDepends(
+    cmGeneratorTarget const* tgt);
+
+  void AddCompilerDepends(cmGeneratorTarget const* tgt, const char* obj,
+                          const char* depfile);
+
+  /** Get whether the compiler writes the dependencies of objects of
+      the given language instead of scanning them.  */
+  bool GetUseCompilerDepends(const std::string& lang);
+
   // write the target rules for the local Makefile into the stream
   void WriteLocalAllRules(std::ostream& ruleFileStream);
 
@@ -249,6 +261,9 @@ protected:
     const char* targetDir,
     std::map<std::string, cmDepends::DependencyVector>& validDeps);
   void CheckMultipleOutputs(bool verbose);
+  bool CheckCompilerDepends(
+    std::string const& internalDependFile, bool verbose,
+    std::map<std::string, cmDepends::DependencyVector>& validDeps);
 
 private:
   std::string MaybeConvertWatcomShellCommand(std::string const& cmd);
@@ -264,6 +279,7 @@ private:
   friend class cmGlobalUnixMakefileGenerator3;
 
   ImplicitDependTargetMap ImplicitDepends;
+  std::map<std::string, ImplicitDependFileMap> CompilerDepends;
 
   std::string HomeRelativeOutputPath;
 
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <sstream>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "cmAlgorithms.h"
 #include "cmExecutionStatus.h"
@@ -13,14 +14,90 @@
 #include "cmState.h"
 #include "cmSystemTools.h"
 
+// The definition of a macro shared by all copies of its command.  The
+// command is copied for every call, so the body must not be.
+class cmMacroDefinition
+{
+public:
+  cmMacroDefinition()
+    : RefCount(1)
+    , Spliceable(false)
+  {
+  }
+
+  void Register() { ++this->RefCount; }
+  void Unregister()
+  {
+    if (--this->RefCount == 0) {
+      delete this;
+    }
+  }
+
+  /**
+   * Cut the arguments of the commands in the macro body at the
+   * references to the macro arguments once so that each call only
+   * needs to splice in the values.
+   */
+  void CompileTemplates();
+
+  // A reference to a macro argument in the macro body.
+  struct Slot
+  {
+    enum SlotKind
+    {
+      Formal, // ${<name>} of the formal argument Index
+      Argc,   // ${ARGC}
+      Argn,   // ${ARGN}
+      Argv,   // ${ARGV}
+      ArgvN   // ${ARGV<Index>}
+    };
+    SlotKind Kind;
+    size_t Index;
+  };
+
+  // An argument of a command in the macro body.  The references
+  // separate the literal pieces, so there is one more piece than slots.
+  // A reference inside of an unterminated variable reference, such as
+  // ${${name}}, may form a new reference once replaced, so such
+  // arguments replace one kind of reference after the other as the
+  // values are spliced in.
+  struct ArgumentTemplate
+  {
+    std::vector<std::string> Pieces;
+    std::vector<Slot> Slots;
+    bool Sequential;
+  };
+
+  unsigned int RefCount;
+  std::vector<std::string> Args;
+  std::vector<cmListFileFunction> Functions;
+  cmPolicies::PolicyMap Policies;
+  std::string FilePath;
+
+  // Templates for the arguments of each function in the macro body.
+  std::vector<std::vector<ArgumentTemplate> > Templates;
+  // Whether the formal argument names allow to use the templates.
+  bool Spliceable;
+
+private:
+  ~cmMacroDefinition() {}
+
+  bool ClassifyReference(std::string const& name, Slot& slot) const;
+  void CompileTemplate(cmListFileArgument const& arg,
+                       ArgumentTemplate& tmpl) const;
+};
+
 // define the class for macro commands
 class cmMacroHelperCommand : public cmCommand
 {
 public:
-  cmMacroHelperCommand() {}
+  cmMacroHelperCommand(cmMacroDefinition* def)
+    : Definition(def)
+  {
+  }
 
   ///! clean up any memory allocated by the macro
-  ~cmMacroHelperCommand() CM_OVERRIDE {}
+  ~cmMacroHelperCommand() CM_OVERRIDE { this->Definition->Unregister(); }
 
   /**
    * This determines if the command is defined in a cmake script.
@@ -32,13 +109,9 @@ public:
    */
   cmCommand* Clone() CM_OVERRIDE
   {
-    cmMacroHelperCommand* newC = new cmMacroHelperCommand;
-    // we must copy when we clone
-    newC->Args = this->Args;
-    newC->Functions = this->Functions;
-    newC->FilePath = this->FilePath;
-    newC->Policies = this->Policies;
-    return newC;
+    // the definition never changes so the copies share it
+    this->Definition->Register();
+    return new cmMacroHelperCommand(this->Definition);
   }
 
   /**
@@ -62,33 +135,129 @@ public:
   /**
    * The name of the command as specified in CMakeList.txt.
    */
-  std::string GetName() const CM_OVERRIDE { return this->Args[0]; }
+  std::string GetName() const CM_OVERRIDE
+  {
+    return this->Definition->Args[0];
+  }
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  std::string FilePath;
+private:
+  cmMacroDefinition* Definition;
 };
 
+bool cmMacroDefinition::ClassifyReference(std::string const& name,
+                                          Slot& slot) const
+{
+  // The formal arguments are replaced first so they win over ARGC and
+  // friends, and the first of duplicate names wins.
+  for (size_t j = 1; j < this->Args.size(); ++j) {
+    if (this->Args[j] == name) {
+      slot.Kind = Slot::Formal;
+      slot.Index = j - 1;
+      return true;
+    }
+  }
+  if (name == "ARGC") {
+    slot.Kind = Slot::Argc;
+    return true;
+  }
+  if (name == "ARGN") {
+    slot.Kind = Slot::Argn;
+    return true;
+  }
+  if (name == "ARGV") {
+    slot.Kind = Slot::Argv;
+    return true;
+  }
+
+  // Only the ${ARGV%i} spelling of an argument index is replaced.
+  if (name.size() > 4 && name.size() < 14 && name.compare(0, 4, "ARGV") == 0 &&
+      (name[4] != '0' || name.size() == 5) &&
+      name.find_first_not_of("0123456789", 4) == std::string::npos) {
+    slot.Kind = Slot::ArgvN;
+    slot.Index = static_cast<size_t>(atol(name.c_str() + 4));
+    return true;
+  }
+  return false;
+}
+
+void cmMacroDefinition::CompileTemplate(cmListFileArgument const& arg,
+                                        ArgumentTemplate& tmpl) const
+{
+  tmpl.Sequential = false;
+  std::string const& value = arg.Value;
+  std::string piece;
+  std::string::size_type pos = 0;
+  while (arg.Delim != cmListFileArgument::Bracket && pos < value.size()) {
+    std::string::size_type const open = value.find("${", pos);
+    std::string::size_type const close =
+      open == std::string::npos ? open : value.find('}', open + 2);
+    if (close == std::string::npos) {
+      break;
+    }
+    std::string const name = value.substr(open + 2, close - open - 2);
+    Slot slot;
+    if (this->ClassifyReference(name, slot)) {
+      piece.append(value, pos, open - pos);
+      tmpl.Pieces.push_back(piece);
+      tmpl.Slots.push_back(slot);
+      piece.clear();
+    } else {
+      if (name.find("${") != std::string::npos) {
+        tmpl.Sequential = true;
+      }
+      piece.append(value, pos, close + 1 - pos);
+    }
+    pos = close + 1;
+  }
+  if (pos < value.size()) {
+    piece.append(value, pos, std::string::npos);
+  }
+  tmpl.Pieces.push_back(piece);
+}
+
+void cmMacroDefinition::CompileTemplates()
+{
+  // Values may only be spliced in if no replaced reference can combine
+  // with the surrounding text to a new one.
+  this->Spliceable = true;
+  for (size_t j = 1; j < this->Args.size(); ++j) {
+    if (this->Args[j].find_first_of("${}") != std::string::npos) {
+      this->Spliceable = false;
+    }
+  }
+
+  this->Templates.resize(this->Functions.size());
+  for (size_t c = 0; c < this->Functions.size(); ++c) {
+    std::vector<cmListFileArgument> const& fargs =
+      this->Functions[c].Arguments;
+    this->Templates[c].resize(fargs.size());
+    for (size_t k = 0; k < fargs.size(); ++k) {
+      this->CompileTemplate(fargs[k], this->Templates[c][k]);
+    }
+  }
+}
+
 bool cmMacroHelperCommand::InvokeInitialPass(
   const std::vector<cmListFileArgument>& args, cmExecutionStatus& inStatus)
 {
+  cmMacroDefinition const* def = this->Definition;
+
   // Expand the argument list to the macro.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def->Args.size() - 1) {
     std::string errorMsg =
       "Macro invoked with incorrect arguments for macro named: ";
-    errorMsg += this->Args[0];
+    errorMsg += def->Args[0];
     this->SetError(errorMsg);
     return false;
   }
 
-  cmMakefile::MacroPushPop macroScope(this->Makefile, this->FilePath,
-                                      this->Policies);
+  cmMakefile::MacroPushPop macroScope(this->Makefile, def->FilePath,
+                                      def->Policies);
 
   // set the value of argc
   std::ostringstream argcDefStream;
@@ -96,38 +265,85 @@ bool cmMacroHelperCommand::InvokeInitialPass(
   std::string argcDef = argcDefStream.str();
 
   std::vector<std::string>::const_iterator eit =
-    expandedArgs.begin() + (this->Args.size() - 1);
+    expandedArgs.begin() + (def->Args.size() - 1);
   std::string expandedArgn = cmJoin(cmMakeRange(eit, expandedArgs.end()), ";");
   std::string expandedArgv = cmJoin(expandedArgs, ";");
-  std::vector<std::string> variables;
-  variables.reserve(this->Args.size() - 1);
-  for (unsigned int j = 1; j < this->Args.size(); ++j) {
-    variables.push_back("${" + this->Args[j] + "}");
+
+  // A value may form a new reference with the text around it unless it
+  // has no '$' or '{'.
+  bool splice = def->Spliceable;
+  for (std::vector<std::string>::const_iterator ai = expandedArgs.begin();
+       splice && ai != expandedArgs.end(); ++ai) {
+    splice = ai->find_first_of("${") == std::string::npos;
   }
+
+  std::vector<std::string> variables;
   std::vector<std::string> argVs;
-  argVs.reserve(expandedArgs.size());
-  char argvName[60];
-  for (unsigned int j = 0; j < expandedArgs.size(); ++j) {
-    sprintf(argvName, "${ARGV%i}", j);
-    argVs.push_back(argvName);
-  }
   // Invoke all the functions that were collected in the block.
   cmListFileFunction newLFF;
   // for each function
-  for (unsigned int c = 0; c < this->Functions.size(); ++c) {
+  for (unsigned int c = 0; c < def->Functions.size(); ++c) {
     // Replace the formal arguments and then invoke the command.
     newLFF.Arguments.clear();
-    newLFF.Arguments.reserve(this->Functions[c].Arguments.size());
-    newLFF.Name = this->Functions[c].Name;
-    newLFF.Line = this->Functions[c].Line;
+    newLFF.Arguments.reserve(def->Functions[c].Arguments.size());
+    newLFF.Name = def->Functions[c].Name;
+    newLFF.Line = def->Functions[c].Line;
+    newLFF.Command = def->Functions[c].Command;
+    newLFF.CommandGeneration = def->Functions[c].CommandGeneration;
 
     // for each argument of the current function
-    for (std::vector<cmListFileArgument>::iterator k =
-           this->Functions[c].Arguments.begin();
-         k != this->Functions[c].Arguments.end(); ++k) {
+    std::vector<cmMacroDefinition::ArgumentTemplate>::const_iterator tmpl =
+      def->Templates[c].begin();
+    for (std::vector<cmListFileArgument>::const_iterator k =
+           def->Functions[c].Arguments.begin();
+         k != def->Functions[c].Arguments.end(); ++k, ++tmpl) {
       cmListFileArgument arg;
-      arg.Value = k->Value;
-      if (k->Delim != cmListFileArgument::Bracket) {
+      if (k->Delim == cmListFileArgument::Bracket) {
+        arg.Value = k->Value;
+      } else if (splice && !tmpl->Sequential) {
+        // splice the values into the literal pieces
+        arg.Value = tmpl->Pieces[0];
+        for (size_t s = 0; s < tmpl->Slots.size(); ++s) {
+          cmMacroDefinition::Slot const& slot = tmpl->Slots[s];
+          switch (slot.Kind) {
+            case cmMacroDefinition::Slot::Formal:
+              arg.Value += expandedArgs[slot.Index];
+              break;
+            case cmMacroDefinition::Slot::Argc:
+              arg.Value += argcDef;
+              break;
+            case cmMacroDefinition::Slot::Argn:
+              arg.Value += expandedArgn;
+              break;
+            case cmMacroDefinition::Slot::Argv:
+              arg.Value += expandedArgv;
+              break;
+            case cmMacroDefinition::Slot::ArgvN:
+              if (slot.Index < expandedArgs.size()) {
+                arg.Value += expandedArgs[slot.Index];
+              } else {
+                std::ostringstream argvName;
+                argvName << "${ARGV" << slot.Index << "}";
+                arg.Value += argvName.str();
+              }
+              break;
+          }
+          arg.Value += tmpl->Pieces[s + 1];
+        }
+      } else {
+        if (variables.empty()) {
+          variables.reserve(def->Args.size() - 1);
+          for (unsigned int j = 1; j < def->Args.size(); ++j) {
+            variables.push_back("${" + def->Args[j] + "}");
+          }
+          argVs.reserve(expandedArgs.size());
+          char argvName[60];
+          for (unsigned int j = 0; j < expandedArgs.size(); ++j) {
+            sprintf(argvName, "${ARGV%i}", j);
+            argVs.push_back(argvName);
+          }
+        }
+        arg.Value = k->Value;
         // replace formal arguments
         for (unsigned int j = 0; j < variables.size(); ++j) {
           cmSystemTools::ReplaceString(arg.Value, variables[j],
@@ -152,8 +368,11 @@ bool cmMacroHelperCommand::InvokeInitialPass(
       newLFF.Arguments.push_back(arg);
     }
     cmExecutionStatus status;
-    if (!this->Makefile->ExecuteCommand(newLFF, status) ||
-        status.GetNestedError()) {
+    bool const executed = this->Makefile->ExecuteCommand(newLFF, status);
+    // keep the command found for the next call
+    def->Functions[c].Command = newLFF.Command;
+    def->Functions[c].CommandGeneration = newLFF.CommandGeneration;
+    if (!executed || status.GetNestedError()) {
       // The error message should have already included the call stack
       // so we do not need to report an error here.
       macroScope.Quiet();
@@ -185,11 +404,13 @@ bool cmMacroFunctionBlocker::IsFunctionBlocked(const cmListFileFunction& lff,
     if (!this->Depth) {
       mf.AppendProperty("MACROS", this->Args[0].c_str());
       // create a new command and add it to cmake
-      cmMacroHelperCommand* f = new cmMacroHelperCommand();
-      f->Args = this->Args;
-      f->Functions = this->Functions;
-      f->FilePath = this->GetStartingContext().FilePath;
-      mf.RecordPolicies(f->Policies);
+      cmMacroDefinition* def = new cmMacroDefinition;
+      def->Args = this->Args;
+      def->Functions = this->Functions;
+      def->FilePath = this->GetStartingContext().FilePath;
+      def->CompileTemplates();
+      mf.RecordPolicies(def->Policies);
+      cmMacroHelperCommand* f = new cmMacroHelperCommand(def);
       std::string newName = "_" + this->Args[0];
       mf.GetState()->RenameCommand(this->Args[0], newName);
       mf.GetState()->AddCommand(f);
@@ -29,6 +29,7 @@
 #include "cmTestGenerator.h"    // IWYU pragma: keep
 
 #ifdef CMAKE_BUILD_WITH_CMAKE
+#include "cmMakefileProfilingData.h"
 #include "cmVariableWatch.h"
 #endif
 
@@ -253,14 +254,12 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
     return result;
   }
 
-  std::string name = lff.Name;
-
   // Place this call on the call stack.
   cmMakefileCall stack_manager(this, lff, status);
   static_cast<void>(stack_manager);
 
   // Lookup the command prototype.
-  if (cmCommand* proto = this->GetState()->GetCommand(name)) {
+  if (cmCommand* proto = this->GetState()->GetCommand(lff)) {
     // Clone the prototype.
     CM_AUTO_PTR<cmCommand> pcmd(proto->Clone());
     pcmd->SetMakefile(this);
@@ -275,6 +274,12 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
       if (this->GetCMakeInstance()->GetTrace()) {
         this->PrintCommandTrace(lff);
       }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+      // Record the command in the profile, if enabled.
+      cmMakefileProfilingData::RAII profilingRAII(
+        this->GetCMakeInstance()->GetProfilingOutput(), lff,
+        this->GetExecutionFilePath(), pcmd->IsUserDefined());
+#endif
       // Try invoking the command.
       bool invokeSucceeded = pcmd->InvokeInitialPass(lff.Arguments, status);
       bool hadNestedError = status.GetNestedError();
@@ -449,8 +454,9 @@ bool cmMakefile::ReadDependentFile(const char* filename, bool noPolicyScope)
   IncludeScope incScope(this, filenametoread, noPolicyScope);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!listFile.ParseFile(
+        filenametoread.c_str(), this->GetMessenger(), this->Backtrace,
+        this->GetCMakeInstance()->GetListFileParseCache())) {
     return false;
   }
 
@@ -499,8 +505,9 @@ bool cmMakefile::ReadListFile(const char* filename)
   ListFileScope scope(this, filenametoread);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!listFile.ParseFile(
+        filenametoread.c_str(), this->GetMessenger(), this->Backtrace,
+        this->GetCMakeInstance()->GetListFileParseCache())) {
     return false;
   }
 
@@ -897,6 +904,13 @@ void cmMakefile::UpdateOutputToSourceMap(
 void cmMakefile::UpdateOutputToSourceMap(std::string const& output,
                                          cmSourceFile* source)
 {
+  std::string::size_type slash = output.rfind('/');
+  std::vector<cmSourceFile*>& sources = this->OutputNameToSources[(
+    slash == std::string::npos ? output : output.substr(slash + 1))];
+  if (sources.empty() || sources.back() != source) {
+    sources.push_back(source);
+  }
+
   OutputToSourceMap::iterator i = this->OutputToSource.find(output);
   if (i != this->OutputToSource.end()) {
     // Multiple custom commands produce the same output but may
@@ -1384,8 +1398,9 @@ void cmMakefile::Configure()
   this->AddDefinition("CMAKE_PARENT_LIST_FILE", currentStart.c_str());
 
   cmListFile listFile;
-  if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!listFile.ParseFile(
+        currentStart.c_str(), this->GetMessenger(), this->Backtrace,
+        this->GetCMakeInstance()->GetListFileParseCache())) {
     return;
   }
   if (this->IsRootMakefile()) {
@@ -1643,6 +1658,32 @@ void cmMakefile::AddDefinition(const std::string& name, const char* value)
 #endif
 }
 
+void cmMakefile::AppendDefinition(const std::string& name,
+                                  const std::string& value)
+{
+  if (this->VariableInitialized(name)) {
+    this->LogUnused("changing definition", name);
+  }
+  if (!this->StateSnapshot.AppendDefinition(name, value)) {
+    // Start from the cache entry, if any, as GetDefinition does.
+    std::string newValue;
+    const char* cached = this->GetState()->GetInitializedCacheValue(name);
+    if (cached) {
+      newValue = cached;
+    }
+    newValue += value;
+    this->StateSnapshot.SetDefinition(name, newValue);
+  }
+
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  cmVariableWatch* vv = this->GetVariableWatch();
+  if (vv) {
+    vv->VariableAccessed(name, cmVariableWatch::VARIABLE_MODIFIED_ACCESS,
+                         this->StateSnapshot.GetDefinition(name), this);
+  }
+#endif
+}
+
 void cmMakefile::AddCacheDefinition(const std::string& name, const char* value,
                                     const char* doc,
                                     cmStateEnums::CacheEntryType type,
@@ -1880,31 +1921,62 @@ cmTarget* cmMakefile::AddNewTarget(cmStateEnums::TargetType type,
   return &it->second;
 }
 
+static bool cmSourceHasOutputWithSuffix(cmSourceFile* sf,
+                                        const std::string& name)
+{
+  // does this source file have a custom command?
+  if (cmCustomCommand* cc = sf->GetCustomCommand()) {
+    // Does the output of the custom command match the source file name?
+    const std::vector<std::string>& outputs = cc->GetOutputs();
+    for (std::vector<std::string>::const_iterator o = outputs.begin();
+         o != outputs.end(); ++o) {
+      std::string const& out = *o;
+      std::string::size_type pos = out.rfind(name);
+      // If the output matches exactly
+      if (pos != out.npos && pos == out.size() - name.size() &&
+          (pos == 0 || out[pos - 1] == '/')) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 cmSourceFile* cmMakefile::LinearGetSourceFileWithOutput(
   const std::string& name) const
 {
-  std::string out;
+  // An output can match only if its file name is the last component of
+  // the queried name.  Look at the sources with such outputs first.
+  std::string::size_type slash = name.rfind('/');
+  if (slash == std::string::npos || slash + 1 < name.size()) {
+    SourceFileMap::const_iterator i = this->OutputNameToSources.find(
+      slash == std::string::npos ? name : name.substr(slash + 1));
+    if (i == this->OutputNameToSources.end()) {
+      return CM_NULLPTR;
+    }
+    cmSourceFile* found = CM_NULLPTR;
+    bool ambiguous = false;
+    for (std::vector<cmSourceFile*>::const_iterator sfi = i->second.begin();
+         sfi != i->second.end() && !ambiguous; ++sfi) {
+      if (cmSourceHasOutputWithSuffix(*sfi, name)) {
+        ambiguous = found && found != *sfi;
+        found = *sfi;
+      }
+    }
+    // If more than one source matches fall back to the linear search
+    // below to return the first one in source order.
+    if (!ambiguous) {
+      return found;
+    }
+  }
 
   // look through all the source files that have custom commands
   // and see if the custom command has the passed source file as an output
   for (std::vector<cmSourceFile*>::const_iterator i =
          this->SourceFiles.begin();
        i != this->SourceFiles.end(); ++i) {
-    // does this source file have a custom command?
-    if ((*i)->GetCustomCommand()) {
-      // Does the output of the custom command match the source file name?
-      const std::vector<std::string>& outputs =
-        (*i)->GetCustomCommand()->GetOutputs();
-      for (std::vector<std::string>::const_iterator o = outputs.begin();
-           o != outputs.end(); ++o) {
-        out = *o;
-        std::string::size_type pos = out.rfind(name);
-        // If the output matches exactly
-        if (pos != out.npos && pos == out.size() - name.size() &&
-            (pos == 0 || out[pos - 1] == '/')) {
-          return *i;
-        }
-      }
+    if (cmSourceHasOutputWithSuffix(*i, name)) {
+      return *i;
     }
   }
 
@@ -2267,6 +2339,23 @@ const char* cmMakefile::GetDefinition(const std::string& name) const
   return def;
 }
 
+std::vector<std::string> const* cmMakefile::GetDefinitionList(
+  const std::string& name, std::vector<std::string>& storage,
+  size_t& emptyElements) const
+{
+  const char* def = this->GetDefinition(name);
+  if (!def) {
+    return CM_NULLPTR;
+  }
+  if (def == this->StateSnapshot.GetDefinition(name)) {
+    return this->StateSnapshot.GetDefinitionList(name, emptyElements);
+  }
+  storage.clear();
+  cmSystemTools::ExpandListArgument(def, storage, true);
+  emptyElements = std::count(storage.begin(), storage.end(), std::string());
+  return &storage;
+}
+
 const char* cmMakefile::GetSafeDefinition(const std::string& def) const
 {
   const char* ret = this->GetDefinition(def);
@@ -2759,6 +2848,71 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
   return mtype;
 }
 
+bool cmMakefile::ExpandTokenizedArgument(cmListFileArgument const& arg,
+                                         std::string& value) const
+{
+  // The tokens follow the NEW behavior of CMP0053 and the full expansion
+  // warns about uninitialized variables.
+  switch (this->GetPolicyStatus(cmPolicies::CMP0053)) {
+    case cmPolicies::OLD:
+    case cmPolicies::WARN:
+      return false;
+    case cmPolicies::NEW:
+    case cmPolicies::REQUIRED_IF_USED:
+    case cmPolicies::REQUIRED_ALWAYS:
+      break;
+  }
+  if (this->GetCMakeInstance()->GetWarnUninitialized()) {
+    return false;
+  }
+
+  // Most arguments are expanded only once, so tokenize only those that
+  // are expanded again, such as the ones in loops and function bodies.
+  switch (arg.State) {
+    case cmListFileArgument::NotTokenized:
+      arg.State = cmListFileArgument::ExpandedOnce;
+      return false;
+    case cmListFileArgument::ExpandedOnce:
+      arg.State = arg.Tokenize() ? cmListFileArgument::Tokenized
+                                 : cmListFileArgument::Untokenizable;
+      break;
+    case cmListFileArgument::Tokenized:
+    case cmListFileArgument::Untokenizable:
+      break;
+  }
+  if (arg.State != cmListFileArgument::Tokenized) {
+    return false;
+  }
+
+  value.clear();
+  std::string env;
+  for (std::vector<cmListFileArgumentSegment>::const_iterator si =
+         arg.Segments.begin();
+       si != arg.Segments.end(); ++si) {
+    const char* def = CM_NULLPTR;
+    switch (si->Kind) {
+      case cmListFileArgumentSegment::Literal:
+        value += si->Text;
+        break;
+      case cmListFileArgumentSegment::Variable:
+        def = this->GetDefinition(si->Text);
+        break;
+      case cmListFileArgumentSegment::Environment:
+        if (cmSystemTools::GetEnv(si->Text, env)) {
+          def = env.c_str();
+        }
+        break;
+      case cmListFileArgumentSegment::Cache:
+        def = this->GetState()->GetCacheEntryValue(si->Text);
+        break;
+    }
+    if (def) {
+      value += def;
+    }
+  }
+  return true;
+}
+
 void cmMakefile::RemoveVariablesInString(std::string& source,
                                          bool atOnly) const
 {
@@ -2939,9 +3093,11 @@ bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
       continue;
     }
     // Expand the variables in the argument.
-    value = i->Value;
-    this->ExpandVariablesInString(value, false, false, false, filename,
-                                  i->Line, false, false);
+    if (!this->ExpandTokenizedArgument(*i, value)) {
+      value = i->Value;
+      this->ExpandVariablesInString(value, false, false, false, filename,
+                                    i->Line, false, false);
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -2972,9 +3128,11 @@ bool cmMakefile::ExpandArguments(
       continue;
     }
     // Expand the variables in the argument.
-    value = i->Value;
-    this->ExpandVariablesInString(value, false, false, false, filename,
-                                  i->Line, false, false);
+    if (!this->ExpandTokenizedArgument(*i, value)) {
+      value = i->Value;
+      this->ExpandVariablesInString(value, false, false, false, filename,
+                                    i->Line, false, false);
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -3071,15 +3229,29 @@ void cmMakefile::SetArgcArgv(const std::vector<std::string>& args)
   }
 }
 
+std::string cmMakefile::GetSourceFileSearchKey(
+  cmSourceFileLocation const& sfl) const
+{
+  std::string name = sfl.GetName();
+#if defined(_WIN32) || defined(__APPLE__)
+  name = cmSystemTools::LowerCase(name);
+#endif
+  return this->GetCMakeInstance()->StripExtension(name);
+}
+
 cmSourceFile* cmMakefile::GetSource(const std::string& sourceName) const
 {
   cmSourceFileLocation sfl(this, sourceName);
-  for (std::vector<cmSourceFile*>::const_iterator sfi =
-         this->SourceFiles.begin();
-       sfi != this->SourceFiles.end(); ++sfi) {
-    cmSourceFile* sf = *sfi;
-    if (sf->Matches(sfl)) {
-      return sf;
+  SourceFileMap::const_iterator sfsi =
+    this->SourceFileSearchIndex.find(this->GetSourceFileSearchKey(sfl));
+  if (sfsi != this->SourceFileSearchIndex.end()) {
+    for (std::vector<cmSourceFile*>::const_iterator sfi =
+           sfsi->second.begin();
+         sfi != sfsi->second.end(); ++sfi) {
+      cmSourceFile* sf = *sfi;
+      if (sf->Matches(sfl)) {
+        return sf;
+      }
     }
   }
   return CM_NULLPTR;
@@ -3093,6 +3265,8 @@ cmSourceFile* cmMakefile::CreateSource(const std::string& sourceName,
     sf->SetProperty("GENERATED", "1");
   }
   this->SourceFiles.push_back(sf);
+  this->SourceFileSearchIndex[this->GetSourceFileSearchKey(sf->GetLocation())]
+    .push_back(sf);
   return sf;
 }
 
@@ -3138,6 +3312,27 @@ int cmMakefile::TryCompile(const std::string& srcdir,
                            const std::string& targetName, bool fast,
                            const std::vector<std::string>* cmakeArgs,
                            std::string& output)
+{
+  if (this->GenerateTryCompile(srcdir, bindir, fast, cmakeArgs) != 0) {
+    return 1;
+  }
+
+  this->IsSourceFileTryCompile = fast;
+  std::string cwd = cmSystemTools::GetCurrentWorkingDirectory();
+  cmSystemTools::ChangeDirectory(bindir);
+
+  // finally call the generator to actually build the resulting project
+  int ret = this->GetGlobalGenerator()->TryCompile(
+    srcdir, bindir, projectName, targetName, fast, output, this);
+
+  cmSystemTools::ChangeDirectory(cwd);
+  this->IsSourceFileTryCompile = false;
+  return ret;
+}
+
+int cmMakefile::GenerateTryCompile(const std::string& srcdir,
+                                   const std::string& bindir, bool fast,
+                                   const std::vector<std::string>* cmakeArgs)
 {
   this->IsSourceFileTryCompile = fast;
   // does the binary directory exist ? If not create it...
@@ -3239,13 +3434,9 @@ int cmMakefile::TryCompile(const std::string& srcdir,
     return 1;
   }
 
-  // finally call the generator to actually build the resulting project
-  int ret = this->GetGlobalGenerator()->TryCompile(
-    srcdir, bindir, projectName, targetName, fast, output, this);
-
   cmSystemTools::ChangeDirectory(cwd);
   this->IsSourceFileTryCompile = false;
-  return ret;
+  return 0;
 }
 
 bool cmMakefile::GetIsSourceFileTryCompile() const
@@ -40,6 +40,7 @@ class cmGlobalGenerator;
 class cmInstallGenerator;
 class cmMessenger;
 class cmSourceFile;
+class cmSourceFileLocation;
 class cmTest;
 class cmTestGenerator;
 class cmVariableWatch;
@@ -100,6 +101,13 @@ public:
                  bool fast, const std::vector<std::string>* cmakeArgs,
                  std::string& output);
 
+  /**
+   * Configure and generate a try_compile project without building it.
+   * Returns 0 on success.
+   */
+  int GenerateTryCompile(const std::string& srcdir, const std::string& bindir,
+                         bool fast, const std::vector<std::string>* cmakeArgs);
+
   bool GetIsSourceFileTryCompile() const;
 
   /**
@@ -215,6 +223,12 @@ public:
    * can be used in CMake to refer to lists, directories, etc.
    */
   void AddDefinition(const std::string& name, const char* value);
+  /**
+   * Append to the value of a variable.  This sets the variable like
+   * AddDefinition with the old value followed by the given one, but
+   * does not copy the old value.
+   */
+  void AppendDefinition(const std::string& name, const std::string& value);
   ///! Add a definition to this makefile and the global cmake cache.
   void AddCacheDefinition(const std::string& name, const char* value,
                           const char* doc, cmStateEnums::CacheEntryType type,
@@ -399,6 +413,15 @@ public:
    * cache is then queried.
    */
   const char* GetDefinition(const std::string&) const;
+  /**
+   * Get the value of a variable split into list elements, empty ones
+   * included, or null if the variable is not defined.  Variables keep
+   * their elements until they change; the elements of cache entries
+   * are split into the storage given.
+   */
+  std::vector<std::string> const* GetDefinitionList(
+    const std::string& name, std::vector<std::string>& storage,
+    size_t& emptyElements) const;
   const char* GetSafeDefinition(const std::string&) const;
   const char* GetRequiredDefinition(const std::string& name) const;
   bool IsDefinitionSet(const std::string&) const;
@@ -779,6 +802,16 @@ protected:
   std::map<std::string, std::string> AliasTargets;
   std::vector<cmSourceFile*> SourceFiles;
 
+  // Because cmSourceFile names are compared case-insensitively on Windows
+  // and macOS and their extension may be ambiguous, this index is keyed by
+  // the name without a known source or header extension (lower-cased on
+  // those platforms).  Candidates must still be checked with Matches().
+  typedef CM_UNORDERED_MAP<std::string, std::vector<cmSourceFile*> >
+    SourceFileMap;
+  SourceFileMap SourceFileSearchIndex;
+
+  std::string GetSourceFileSearchKey(cmSourceFileLocation const& sfl) const;
+
   // Tests
   std::map<std::string, cmTest*> Tests;
 
@@ -876,6 +909,9 @@ private:
     std::string& errorstr, std::string& source, bool escapeQuotes,
     bool noEscapes, bool atOnly, const char* filename, long line,
     bool removeEmpty, bool replaceAt) const;
+  // Expand a command argument from its tokens, if it has them.
+  bool ExpandTokenizedArgument(cmListFileArgument const& arg,
+                               std::string& value) const;
   /**
    * Old version of GetSourceFileWithOutput(const std::string&) kept for
    * backward-compatibility. It implements a linear search and support
@@ -888,6 +924,10 @@ private:
   typedef CM_UNORDERED_MAP<std::string, cmSourceFile*> OutputToSourceMap;
   OutputToSourceMap OutputToSource;
 
+  // Sources with a custom command indexed by the file name of each output,
+  // used to speed up LinearGetSourceFileWithOutput.
+  SourceFileMap OutputNameToSources;
+
   void UpdateOutputToSourceMap(std::vector<std::string> const& outputs,
                                cmSourceFile* source);
   void UpdateOutputToSourceMap(std::string const& output,
@@ -0,0 +1,147 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmMakefileProfilingData.h"
+
+#include "cmListFileCache.h"
+#include "cmSystemTools.h"
+
+#include <sstream>
+#include <vector>
+
+cmMakefileProfilingData::cmMakefileProfilingData(
+  std::string const& profileStream)
+  : ProfileStream(profileStream.c_str())
+  , StartTime(cmSystemTools::GetTime())
+  , FirstEvent(true)
+{
+  this->JsonWriter.omitEndingLineFeed();
+  if (this->ProfileStream) {
+    this->ProfileStream << "[";
+  }
+}
+
+cmMakefileProfilingData::~cmMakefileProfilingData()
+{
+  if (this->ProfileStream) {
+    this->ProfileStream << "\n]\n";
+  }
+}
+
+bool cmMakefileProfilingData::IsValid() const
+{
+  return this->ProfileStream ? true : false;
+}
+
+void cmMakefileProfilingData::StartEntry(cmListFileFunction const& lff,
+                                         std::string const& filePath,
+                                         bool userDefined)
+{
+  // Group the scopes users most often look for into their own categories.
+  std::string const name = cmSystemTools::LowerCase(lff.Name);
+  const char* category = "command";
+  if (userDefined) {
+    category = "function";
+  } else if (name == "include" || name == "find_package" ||
+             name == "try_compile" || name == "try_run") {
+    category = name.c_str();
+  }
+
+  Json::Value event(Json::objectValue);
+  event["name"] = lff.Name;
+  event["cat"] = category;
+  event["ph"] = "B";
+
+  cmListFileContext lfc =
+    cmListFileContext::FromCommandContext(lff, filePath);
+  std::ostringstream location;
+  location << lfc.FilePath << ":" << lfc.Line;
+  std::string functionArgs;
+  const char* sep = "";
+  for (std::vector<cmListFileArgument>::const_iterator a =
+         lff.Arguments.begin();
+       a != lff.Arguments.end(); ++a) {
+    functionArgs += sep;
+    functionArgs += a->Value;
+    sep = " ";
+  }
+  event["args"]["location"] = location.str();
+  event["args"]["functionArgs"] = functionArgs;
+
+  this->WriteEvent(event);
+}
+
+void cmMakefileProfilingData::StartPhase(std::string const& name)
+{
+  Json::Value event(Json::objectValue);
+  event["name"] = name;
+  event["cat"] = "phase";
+  event["ph"] = "B";
+  this->WriteEvent(event);
+}
+
+void cmMakefileProfilingData::StopEntry()
+{
+  Json::Value event(Json::objectValue);
+  event["ph"] = "E";
+  this->WriteEvent(event);
+}
+
+void cmMakefileProfilingData::RecordCounters(
+  std::string const& name, std::map<std::string, unsigned long> const& values)
+{
+  Json::Value event(Json::objectValue);
+  event["name"] = name;
+  event["cat"] = "counter";
+  event["ph"] = "C";
+  event["args"] = Json::Value(Json::objectValue);
+  for (std::map<std::string, unsigned long>::const_iterator i =
+         values.begin();
+       i != values.end(); ++i) {
+    event["args"][i->first] = static_cast<Json::Value::UInt64>(i->second);
+  }
+  this->WriteEvent(event);
+}
+
+void cmMakefileProfilingData::WriteEvent(Json::Value& event)
+{
+  if (!this->ProfileStream) {
+    return;
+  }
+  // Timestamps are in microseconds since the profile was started.
+  event["pid"] = 0;
+  event["tid"] = 0;
+  event["ts"] = static_cast<Json::Value::UInt64>(
+    (cmSystemTools::GetTime() - this->StartTime) * 1000000.0);
+
+  // Write one event per line.
+  this->ProfileStream << (this->FirstEvent ? "\n" : ",\n")
+                      << this->JsonWriter.write(event);
+  this->FirstEvent = false;
+}
+
+cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData* data,
+                                    cmListFileFunction const& lff,
+                                    std::string const& filePath,
+                                    bool userDefined)
+  : Data(data)
+{
+  if (this->Data) {
+    this->Data->StartEntry(lff, filePath, userDefined);
+  }
+}
+
+cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData* data,
+                                    std::string const& phase)
+  : Data(data)
+{
+  if (this->Data) {
+    this->Data->StartPhase(phase);
+  }
+}
+
+cmMakefileProfilingData::RAII::~RAII()
+{
+  if (this->Data) {
+    this->Data->StopEntry();
+  }
+}
@@ -0,0 +1,75 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmMakefileProfilingData_h
+#define cmMakefileProfilingData_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <map>
+#include <string>
+
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+#include <cmsys/FStream.hxx>
+
+struct cmListFileFunction;
+
+/** \class cmMakefileProfilingData
+ * \brief Record a profile of a cmake run in the Chrome trace-event format.
+ *
+ * A begin event is written when a command starts executing or a
+ * generator phase starts, and the matching end event when it finishes.
+ * The resulting file may be loaded into chrome://tracing or a compatible
+ * viewer.
+ */
+class cmMakefileProfilingData
+{
+public:
+  cmMakefileProfilingData(std::string const& profileStream);
+  ~cmMakefileProfilingData();
+
+  /** Whether the output file could be opened.  */
+  bool IsValid() const;
+
+  /** Record the start of a command invocation from the given file.  */
+  void StartEntry(cmListFileFunction const& lff, std::string const& filePath,
+                  bool userDefined);
+
+  /** Record the start of a phase of the cmake run such as configure.  */
+  void StartPhase(std::string const& name);
+
+  /** Record the end of the most recently started entry.  */
+  void StopEntry();
+
+  /** Record the current values of a group of counters, such as how
+      often a cache was used.  */
+  void RecordCounters(std::string const& name,
+                      std::map<std::string, unsigned long> const& values);
+
+  /** Start an entry on construction and stop it on destruction.
+      Nothing is recorded when constructed with a null data pointer.  */
+  class RAII
+  {
+  public:
+    RAII(cmMakefileProfilingData* data, cmListFileFunction const& lff,
+         std::string const& filePath, bool userDefined);
+    RAII(cmMakefileProfilingData* data, std::string const& phase);
+    ~RAII();
+
+  private:
+    RAII(RAII const&);           // Not implemented.
+    void operator=(RAII const&); // Not implemented.
+    cmMakefileProfilingData* Data;
+  };
+
+private:
+  cmsys::ofstream ProfileStream;
+  Json::FastWriter JsonWriter;
+  double StartTime;
+  bool FirstEvent;
+
+  void WriteEvent(Json::Value& event);
+};
+
+#endif
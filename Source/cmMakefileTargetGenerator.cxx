@@ -44,6 +44,7 @@ cmMakefileTargetGenerator::cmMakefileTargetGenerator(cmGeneratorTarget* target)
   this->BuildFileStream = CM_NULLPTR;
   this->InfoFileStream = CM_NULLPTR;
   this->FlagFileStream = CM_NULLPTR;
+  this->ObjectRulePathsComputed = false;
   this->CustomCommandDriver = OnBuild;
   this->LocalGenerator =
     static_cast<cmLocalUnixMakefileGenerator3*>(target->GetLocalGenerator());
@@ -388,6 +389,9 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   // Save this in the target's list of object files.
   this->Objects.push_back(obj);
   this->CleanFiles.push_back(obj);
+  if (this->LocalGenerator->GetUseCompilerDepends(lang)) {
+    this->CleanFiles.push_back(obj + ".d");
+  }
 
   // TODO: Remove
   // std::string relativeObj
@@ -406,12 +410,75 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   objFullPath += "/";
   objFullPath += obj;
   objFullPath = cmSystemTools::CollapseFullPath(objFullPath);
+  if (this->LocalGenerator->GetUseCompilerDepends(lang)) {
+    std::string depFullPath = objFullPath + ".d";
+    this->LocalGenerator->AddCompilerDepends(
+      this->GeneratorTarget, objFullPath.c_str(), depFullPath.c_str());
+    return;
+  }
   std::string srcFullPath =
     cmSystemTools::CollapseFullPath(source.GetFullPath());
   this->LocalGenerator->AddImplicitDepends(
     this->GeneratorTarget, lang, objFullPath.c_str(), srcFullPath.c_str());
 }
 
+void cmMakefileTargetGenerator::ComputeObjectRulePaths()
+{
+  if (this->ObjectRulePathsComputed) {
+    return;
+  }
+  this->ObjectRulePathsComputed = true;
+
+  std::string targetFullPathReal;
+  std::string targetFullPathPDB;
+  std::string targetFullPathCompilePDB;
+  if (this->GeneratorTarget->GetType() == cmStateEnums::EXECUTABLE ||
+      this->GeneratorTarget->GetType() == cmStateEnums::STATIC_LIBRARY ||
+      this->GeneratorTarget->GetType() == cmStateEnums::SHARED_LIBRARY ||
+      this->GeneratorTarget->GetType() == cmStateEnums::MODULE_LIBRARY) {
+    targetFullPathReal =
+      this->GeneratorTarget->GetFullPath(this->ConfigName, false, true);
+    targetFullPathPDB =
+      this->GeneratorTarget->GetPDBDirectory(this->ConfigName);
+    targetFullPathPDB += "/";
+    targetFullPathPDB += this->GeneratorTarget->GetPDBName(this->ConfigName);
+  }
+  if (this->GeneratorTarget->GetType() <= cmStateEnums::OBJECT_LIBRARY) {
+    targetFullPathCompilePDB =
+      this->GeneratorTarget->GetCompilePDBPath(this->ConfigName);
+    if (targetFullPathCompilePDB.empty()) {
+      targetFullPathCompilePDB =
+        this->GeneratorTarget->GetSupportDirectory() + "/";
+    }
+  }
+
+  this->TargetOutPathReal = this->LocalGenerator->ConvertToOutputFormat(
+    this->LocalGenerator->MaybeConvertToRelativePath(
+      this->LocalGenerator->GetCurrentBinaryDirectory(), targetFullPathReal),
+    cmOutputConverter::SHELL);
+  this->TargetOutPathPDB = this->LocalGenerator->ConvertToOutputFormat(
+    targetFullPathPDB, cmOutputConverter::SHELL);
+  this->TargetOutPathCompilePDB = this->LocalGenerator->ConvertToOutputFormat(
+    this->LocalGenerator->MaybeConvertToRelativePath(
+      this->LocalGenerator->GetCurrentBinaryDirectory(),
+      targetFullPathCompilePDB),
+    cmOutputConverter::SHELL);
+
+  if (this->LocalGenerator->IsMinGWMake() &&
+      cmHasLiteralSuffix(this->TargetOutPathCompilePDB, "\\")) {
+    // mingw32-make incorrectly interprets 'a\ b c' as 'a b' and 'c'
+    // (but 'a\ b "c"' as 'a\', 'b', and 'c'!).  Workaround this by
+    // avoiding a trailing backslash in the argument.
+    *this->TargetOutPathCompilePDB.rbegin() = '/';
+  }
+
+  this->ObjectDirOutPath = this->LocalGenerator->ConvertToOutputFormat(
+    this->LocalGenerator->MaybeConvertToRelativePath(
+      this->LocalGenerator->GetCurrentBinaryDirectory(),
+      this->GeneratorTarget->GetSupportDirectory()),
+    cmOutputConverter::SHELL);
+}
+
 void cmMakefileTargetGenerator::WriteObjectBuildFile(
   std::string& obj, const std::string& lang, cmSourceFile const& source,
   std::vector<std::string>& depends)
@@ -437,44 +504,45 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
   langFlags += "_FLAGS)";
   this->LocalGenerator->AppendFlags(flags, langFlags);
 
-  std::string config = this->LocalGenerator->GetConfigName();
-  std::string configUpper = cmSystemTools::UpperCase(config);
+  // Add language-specific defines.
+  std::set<std::string> defines;
 
-  // Add Fortran format flags.
-  if (lang == "Fortran") {
-    this->AppendFortranFormatFlags(flags, source);
-  }
+  if (this->HasSourceSpecificFlags(source, lang)) {
+    std::string config = this->LocalGenerator->GetConfigName();
+    std::string configUpper = cmSystemTools::UpperCase(config);
 
-  // Add flags from source file properties.
-  if (const char* cflags = source.GetProperty("COMPILE_FLAGS")) {
-    cmGeneratorExpression ge;
-    CM_AUTO_PTR<cmCompiledGeneratorExpression> cge = ge.Parse(cflags);
-    const char* evaluatedFlags = cge->Evaluate(this->LocalGenerator, config,
-                                               false, this->GeneratorTarget);
-    this->LocalGenerator->AppendFlags(flags, evaluatedFlags);
-    *this->FlagFileStream << "# Custom flags: " << relativeObj
-                          << "_FLAGS = " << evaluatedFlags << "\n"
-                          << "\n";
-  }
+    // Add Fortran format flags.
+    if (lang == "Fortran") {
+      this->AppendFortranFormatFlags(flags, source);
+    }
 
-  // Add language-specific defines.
-  std::set<std::string> defines;
+    // Add flags from source file properties.
+    if (const char* cflags = source.GetProperty("COMPILE_FLAGS")) {
+      cmGeneratorExpression ge;
+      CM_AUTO_PTR<cmCompiledGeneratorExpression> cge = ge.Parse(cflags);
+      const char* evaluatedFlags = cge->Evaluate(
+        this->LocalGenerator, config, false, this->GeneratorTarget);
+      this->LocalGenerator->AppendFlags(flags, evaluatedFlags);
+      *this->FlagFileStream << "# Custom flags: " << relativeObj
+                            << "_FLAGS = " << evaluatedFlags << "\n"
+                            << "\n";
+    }
 
-  // Add source-sepcific preprocessor definitions.
-  if (const char* compile_defs = source.GetProperty("COMPILE_DEFINITIONS")) {
-    this->LocalGenerator->AppendDefines(defines, compile_defs);
-    *this->FlagFileStream << "# Custom defines: " << relativeObj
-                          << "_DEFINES = " << compile_defs << "\n"
-                          << "\n";
-  }
-  std::string defPropName = "COMPILE_DEFINITIONS_";
-  defPropName += configUpper;
-  if (const char* config_compile_defs = source.GetProperty(defPropName)) {
-    this->LocalGenerator->AppendDefines(defines, config_compile_defs);
-    *this->FlagFileStream << "# Custom defines: " << relativeObj << "_DEFINES_"
-                          << configUpper << " = " << config_compile_defs
-                          << "\n"
-                          << "\n";
+    // Add source-sepcific preprocessor definitions.
+    if (const char* compile_defs = source.GetProperty("COMPILE_DEFINITIONS")) {
+      this->LocalGenerator->AppendDefines(defines, compile_defs);
+      *this->FlagFileStream << "# Custom defines: " << relativeObj
+                            << "_DEFINES = " << compile_defs << "\n"
+                            << "\n";
+    }
+    if (const char* config_compile_defs =
+          source.GetProperty(this->ConfigDefinitionsProperty)) {
+      this->LocalGenerator->AppendDefines(defines, config_compile_defs);
+      *this->FlagFileStream << "# Custom defines: " << relativeObj
+                            << "_DEFINES_" << configUpper << " = "
+                            << config_compile_defs << "\n"
+                            << "\n";
+    }
   }
 
   // Get the output paths for source and object files.
@@ -500,72 +568,21 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
                                      &progress);
   }
 
-  std::string targetOutPathReal;
-  std::string targetOutPathPDB;
-  std::string targetOutPathCompilePDB;
-  {
-    std::string targetFullPathReal;
-    std::string targetFullPathPDB;
-    std::string targetFullPathCompilePDB;
-    if (this->GeneratorTarget->GetType() == cmStateEnums::EXECUTABLE ||
-        this->GeneratorTarget->GetType() == cmStateEnums::STATIC_LIBRARY ||
-        this->GeneratorTarget->GetType() == cmStateEnums::SHARED_LIBRARY ||
-        this->GeneratorTarget->GetType() == cmStateEnums::MODULE_LIBRARY) {
-      targetFullPathReal =
-        this->GeneratorTarget->GetFullPath(this->ConfigName, false, true);
-      targetFullPathPDB =
-        this->GeneratorTarget->GetPDBDirectory(this->ConfigName);
-      targetFullPathPDB += "/";
-      targetFullPathPDB += this->GeneratorTarget->GetPDBName(this->ConfigName);
-    }
-    if (this->GeneratorTarget->GetType() <= cmStateEnums::OBJECT_LIBRARY) {
-      targetFullPathCompilePDB =
-        this->GeneratorTarget->GetCompilePDBPath(this->ConfigName);
-      if (targetFullPathCompilePDB.empty()) {
-        targetFullPathCompilePDB =
-          this->GeneratorTarget->GetSupportDirectory() + "/";
-      }
-    }
-
-    targetOutPathReal = this->LocalGenerator->ConvertToOutputFormat(
-      this->LocalGenerator->MaybeConvertToRelativePath(
-        this->LocalGenerator->GetCurrentBinaryDirectory(), targetFullPathReal),
-      cmOutputConverter::SHELL);
-    targetOutPathPDB = this->LocalGenerator->ConvertToOutputFormat(
-      targetFullPathPDB, cmOutputConverter::SHELL);
-    targetOutPathCompilePDB = this->LocalGenerator->ConvertToOutputFormat(
-      this->LocalGenerator->MaybeConvertToRelativePath(
-        this->LocalGenerator->GetCurrentBinaryDirectory(),
-        targetFullPathCompilePDB),
-      cmOutputConverter::SHELL);
-
-    if (this->LocalGenerator->IsMinGWMake() &&
-        cmHasLiteralSuffix(targetOutPathCompilePDB, "\\")) {
-      // mingw32-make incorrectly interprets 'a\ b c' as 'a b' and 'c'
-      // (but 'a\ b "c"' as 'a\', 'b', and 'c'!).  Workaround this by
-      // avoiding a trailing backslash in the argument.
-      targetOutPathCompilePDB[targetOutPathCompilePDB.size() - 1] = '/';
-    }
-  }
+  this->ComputeObjectRulePaths();
   cmRulePlaceholderExpander::RuleVariables vars;
   vars.RuleLauncher = "RULE_LAUNCH_COMPILE";
   vars.CMTargetName = this->GeneratorTarget->GetName().c_str();
   vars.CMTargetType =
     cmState::GetTargetTypeName(this->GeneratorTarget->GetType());
   vars.Language = lang.c_str();
-  vars.Target = targetOutPathReal.c_str();
-  vars.TargetPDB = targetOutPathPDB.c_str();
-  vars.TargetCompilePDB = targetOutPathCompilePDB.c_str();
+  vars.Target = this->TargetOutPathReal.c_str();
+  vars.TargetPDB = this->TargetOutPathPDB.c_str();
+  vars.TargetCompilePDB = this->TargetOutPathCompilePDB.c_str();
   vars.Source = sourceFile.c_str();
   std::string shellObj =
     this->LocalGenerator->ConvertToOutputFormat(obj, cmOutputConverter::SHELL);
   vars.Object = shellObj.c_str();
-  std::string objectDir = this->GeneratorTarget->GetSupportDirectory();
-  objectDir = this->LocalGenerator->ConvertToOutputFormat(
-    this->LocalGenerator->MaybeConvertToRelativePath(
-      this->LocalGenerator->GetCurrentBinaryDirectory(), objectDir),
-    cmOutputConverter::SHELL);
-  vars.ObjectDir = objectDir.c_str();
+  vars.ObjectDir = this->ObjectDirOutPath.c_str();
   std::string objectFileDir = cmSystemTools::GetFilenamePath(obj);
   objectFileDir = this->LocalGenerator->ConvertToOutputFormat(
     this->LocalGenerator->MaybeConvertToRelativePath(
@@ -598,6 +615,24 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
 
   // Construct the compile rules.
   {
+    // Have the compiler write the dependencies of the object file.
+    std::string compileFlags = flags;
+    if (this->LocalGenerator->GetUseCompilerDepends(lang)) {
+      std::string depfileFlags =
+        this->Makefile->GetSafeDefinition("CMAKE_DEPFILE_FLAGS_" + lang);
+      std::string const shellDepfile =
+        this->LocalGenerator->ConvertToOutputFormat(obj + ".d",
+                                                    cmOutputConverter::SHELL);
+      cmSystemTools::ReplaceString(depfileFlags, "<DEPFILE>",
+                                   shellDepfile.c_str());
+      cmSystemTools::ReplaceString(depfileFlags, "<OBJECT>", shellObj.c_str());
+      cmSystemTools::ReplaceString(
+        depfileFlags, "<CMAKE_C_COMPILER>",
+        this->Makefile->GetSafeDefinition("CMAKE_C_COMPILER"));
+      this->LocalGenerator->AppendFlags(compileFlags, depfileFlags);
+      vars.Flags = compileFlags.c_str();
+    }
+
     std::string compileRuleVar = "CMAKE_";
     compileRuleVar += lang;
     compileRuleVar += "_COMPILE_OBJECT";
@@ -680,6 +715,7 @@ void cmMakefileTargetGenerator::WriteObjectBuildFile(
       this->LocalGenerator->GetBinaryDirectory());
     commands.insert(commands.end(), compileCommands.begin(),
                     compileCommands.end());
+    vars.Flags = flags.c_str();
   }
 
   // Check for extra outputs created by the compilation.
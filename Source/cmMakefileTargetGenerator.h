@@ -206,6 +206,14 @@ protected:
   };
   std::map<std::string, StringList> FlagFileDepends;
 
+  // the shell paths used by the build rule of every object
+  void ComputeObjectRulePaths();
+  bool ObjectRulePathsComputed;
+  std::string TargetOutPathReal;
+  std::string TargetOutPathPDB;
+  std::string TargetOutPathCompilePDB;
+  std::string ObjectDirOutPath;
+
   // the stream for the info file
   std::string InfoFileNameFull;
   cmGeneratedFileStream* InfoFileStream;
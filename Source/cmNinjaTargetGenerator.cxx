@@ -177,12 +177,8 @@ std::string cmNinjaTargetGenerator::ComputeDefines(cmSourceFile const* source,
   std::set<std::string> defines;
   this->LocalGenerator->AppendDefines(
     defines, source->GetProperty("COMPILE_DEFINITIONS"));
-  {
-    std::string defPropName = "COMPILE_DEFINITIONS_";
-    defPropName += cmSystemTools::UpperCase(this->GetConfigName());
-    this->LocalGenerator->AppendDefines(defines,
-                                        source->GetProperty(defPropName));
-  }
+  this->LocalGenerator->AppendDefines(
+    defines, source->GetProperty(this->ConfigDefinitionsProperty));
 
   std::string definesString = this->GetDefines(language);
   this->LocalGenerator->JoinDefines(defines, definesString, language);
@@ -766,8 +762,13 @@ void cmNinjaTargetGenerator::WriteObjectBuildStatement(
   cmNinjaVars vars;
   vars["IN_ABS"] = this->GetLocalGenerator()->ConvertToOutputFormat(
     source->GetFullPath(), cmOutputConverter::SHELL);
-  vars["FLAGS"] = this->ComputeFlagsForObject(source, language);
-  vars["DEFINES"] = this->ComputeDefines(source, language);
+  if (this->HasSourceSpecificFlags(*source, language)) {
+    vars["FLAGS"] = this->ComputeFlagsForObject(source, language);
+    vars["DEFINES"] = this->ComputeDefines(source, language);
+  } else {
+    vars["FLAGS"] = this->GetFlags(language);
+    vars["DEFINES"] = this->GetDefines(language);
+  }
   vars["INCLUDES"] = this->GetIncludes(language);
   if (!this->NeedDepTypeMSVC(language)) {
     vars["DEP_FILE"] =
@@ -19,8 +19,68 @@ Directory ordering computation.
   - Need runtime path for supporting INSTALL_RPATH_USE_LINK_PATH
   - Need runtime path at link time to pickup transitive link dependencies
     for shared libraries.
+
+Conflict detection.
+  - A constraint conflicts with a directory other than its own if a file
+    the linker or loader may take for it is there.
+  - Checking every constraint against every directory costs a number of
+    file system checks growing with their product, so the names each
+    constraint may conflict with are indexed first.  The cached content
+    of each directory is then looked up in the index to find the few
+    constraints worth checking there.
 */
 
+/** Index of the file names constraints may conflict with.  */
+class cmOrderDirectoriesNameIndex
+{
+public:
+  // A file of this name may conflict with the entry.
+  void AddName(std::string const& name, unsigned int entry)
+  {
+#if defined(_WIN32) || defined(__APPLE__)
+    // The file system may find the file in another case.
+    this->Names[cmSystemTools::LowerCase(name)].push_back(entry);
+#else
+    this->Names[name].push_back(entry);
+#endif
+  }
+
+  // A file whose name starts with the prefix may conflict with the entry.
+  void AddPrefix(std::string const& prefix, unsigned int entry)
+  {
+    this->Prefixes[prefix].push_back(entry);
+    this->PrefixLengths.insert(prefix.size());
+  }
+
+  // Append the entries a file of the given name may conflict with.
+  void Find(std::string const& file, std::vector<unsigned int>& entries) const
+  {
+#if defined(_WIN32) || defined(__APPLE__)
+    EntryMap::const_iterator ni =
+      this->Names.find(cmSystemTools::LowerCase(file));
+#else
+    EntryMap::const_iterator ni = this->Names.find(file);
+#endif
+    if (ni != this->Names.end()) {
+      entries.insert(entries.end(), ni->second.begin(), ni->second.end());
+    }
+    for (std::set<std::string::size_type>::const_iterator li =
+           this->PrefixLengths.begin();
+         li != this->PrefixLengths.end() && *li <= file.size(); ++li) {
+      EntryMap::const_iterator pi = this->Prefixes.find(file.substr(0, *li));
+      if (pi != this->Prefixes.end()) {
+        entries.insert(entries.end(), pi->second.begin(), pi->second.end());
+      }
+    }
+  }
+
+private:
+  typedef std::map<std::string, std::vector<unsigned int> > EntryMap;
+  EntryMap Names;
+  EntryMap Prefixes;
+  std::set<std::string::size_type> PrefixLengths;
+};
+
 class cmOrderDirectoriesConstraint
 {
 public:
@@ -56,28 +116,32 @@ public:
 
   virtual void Report(std::ostream& e) = 0;
 
-  void FindConflicts(unsigned int index)
+  // Add the names of files that may conflict with the entry.
+  virtual void IndexNames(cmOrderDirectoriesNameIndex& index,
+                          unsigned int entry) = 0;
+
+  void FindConflicts(unsigned int index, unsigned int i)
   {
-    for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
-      // Check if this directory conflicts with the entry.
-      std::string const& dir = this->OD->OriginalDirectories[i];
-      if (!this->OD->IsSameDirectory(dir, this->Directory) &&
-          this->FindConflict(dir)) {
-        // The library will be found in this directory but this is not
-        // the directory named for it.  Add an entry to make sure the
-        // desired directory comes before this one.
-        cmOrderDirectories::ConflictPair p(this->DirectoryIndex, index);
-        this->OD->ConflictGraph[i].push_back(p);
-      }
+    // Check if this directory conflicts with the entry.
+    std::string const& dir = this->OD->OriginalDirectories[i];
+    if (!this->OD->IsSameDirectory(dir, this->Directory) &&
+        this->FindConflict(dir)) {
+      // The library will be found in this directory but this is not
+      // the directory named for it.  Add an entry to make sure the
+      // desired directory comes before this one.
+      cmOrderDirectories::ConflictPair p(this->DirectoryIndex, index);
+      this->OD->ConflictGraph[i].push_back(p);
     }
   }
 
-  void FindImplicitConflicts(std::ostringstream& w)
+  void FindImplicitConflicts(std::ostringstream& w,
+                             std::vector<unsigned int> const& dirs)
   {
     bool first = true;
-    for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
+    for (std::vector<unsigned int>::const_iterator di = dirs.begin();
+         di != dirs.end(); ++di) {
       // Check if this directory conflicts with the entry.
-      std::string const& dir = this->OD->OriginalDirectories[i];
+      std::string const& dir = this->OD->OriginalDirectories[*di];
       if (dir != this->Directory &&
           cmSystemTools::GetRealPath(dir) !=
             cmSystemTools::GetRealPath(this->Directory) &&
@@ -161,6 +225,16 @@ public:
     e << "]";
   }
 
+  void IndexNames(cmOrderDirectoriesNameIndex& index,
+                  unsigned int entry) CM_OVERRIDE
+  {
+    if (!this->SOName.empty()) {
+      index.AddName(this->SOName, entry);
+    } else {
+      index.AddPrefix(this->FileName, entry);
+    }
+  }
+
   bool FindConflict(std::string const& dir) CM_OVERRIDE;
 
 private:
@@ -210,9 +284,32 @@ public:
     e << "link library [" << this->FileName << "]";
   }
 
+  void IndexNames(cmOrderDirectoriesNameIndex& index,
+                  unsigned int entry) CM_OVERRIDE;
+
   bool FindConflict(std::string const& dir) CM_OVERRIDE;
 };
 
+void cmOrderDirectoriesConstraintLibrary::IndexNames(
+  cmOrderDirectoriesNameIndex& index, unsigned int entry)
+{
+  index.AddName(this->FileName, entry);
+
+  // The file may also be found with other extensions.
+  if (!this->OD->LinkExtensions.empty() &&
+      this->OD->RemoveLibraryExtension.find(this->FileName)) {
+    std::string lib = this->OD->RemoveLibraryExtension.match(1);
+    std::string ext = this->OD->RemoveLibraryExtension.match(2);
+    for (std::vector<std::string>::iterator i =
+           this->OD->LinkExtensions.begin();
+         i != this->OD->LinkExtensions.end(); ++i) {
+      if (*i != ext) {
+        index.AddName(lib + *i, entry);
+      }
+    }
+  }
+}
+
 bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
 {
   // We have the library file name.  Check if it will be found.
@@ -429,8 +526,19 @@ void cmOrderDirectories::FindConflicts()
   this->DirectoryVisited.resize(this->OriginalDirectories.size(), 0);
 
   // Find directories conflicting with each entry.
+  cmOrderDirectoriesNameIndex index;
   for (unsigned int i = 0; i < this->ConstraintEntries.size(); ++i) {
-    this->ConstraintEntries[i]->FindConflicts(i);
+    this->ConstraintEntries[i]->IndexNames(index, i);
+  }
+  std::vector<unsigned int> entries;
+  for (unsigned int d = 0; d < this->OriginalDirectories.size(); ++d) {
+    this->FindConflictCandidates(
+      index, d, static_cast<unsigned int>(this->ConstraintEntries.size()),
+      entries);
+    for (std::vector<unsigned int>::const_iterator ei = entries.begin();
+         ei != entries.end(); ++ei) {
+      this->ConstraintEntries[*ei]->FindConflicts(*ei, d);
+    }
   }
 
   // Clean up the conflict graph representation.
@@ -454,9 +562,26 @@ void cmOrderDirectories::FindImplicitConflicts()
 {
   // Check for items in implicit link directories that have conflicts
   // in the explicit directories.
+  cmOrderDirectoriesNameIndex index;
+  for (unsigned int i = 0; i < this->ImplicitDirEntries.size(); ++i) {
+    this->ImplicitDirEntries[i]->IndexNames(index, i);
+  }
+  std::vector<std::vector<unsigned int> > entryDirs(
+    this->ImplicitDirEntries.size());
+  std::vector<unsigned int> entries;
+  for (unsigned int d = 0; d < this->OriginalDirectories.size(); ++d) {
+    this->FindConflictCandidates(
+      index, d, static_cast<unsigned int>(this->ImplicitDirEntries.size()),
+      entries);
+    for (std::vector<unsigned int>::const_iterator ei = entries.begin();
+         ei != entries.end(); ++ei) {
+      entryDirs[*ei].push_back(d);
+    }
+  }
   std::ostringstream conflicts;
   for (unsigned int i = 0; i < this->ImplicitDirEntries.size(); ++i) {
-    this->ImplicitDirEntries[i]->FindImplicitConflicts(conflicts);
+    this->ImplicitDirEntries[i]->FindImplicitConflicts(conflicts,
+                                                       entryDirs[i]);
   }
 
   // Skip warning if there were no conflicts.
@@ -476,6 +601,31 @@ void cmOrderDirectories::FindImplicitConflicts()
     cmake::WARNING, w.str(), this->Target->GetBacktrace());
 }
 
+void cmOrderDirectories::FindConflictCandidates(
+  cmOrderDirectoriesNameIndex const& index, unsigned int dirIndex,
+  unsigned int count, std::vector<unsigned int>& entries)
+{
+  entries.clear();
+
+  // Look up the files of the directory in the index unless there are
+  // more of them than entries to check.
+  std::set<std::string> const& files =
+    this->GlobalGenerator->GetDirectoryContent(
+      this->OriginalDirectories[dirIndex], true);
+  if (files.size() >= count) {
+    for (unsigned int i = 0; i < count; ++i) {
+      entries.push_back(i);
+    }
+    return;
+  }
+  for (std::set<std::string>::const_iterator fi = files.begin();
+       fi != files.end(); ++fi) {
+    index.Find(*fi, entries);
+  }
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+}
+
 void cmOrderDirectories::OrderDirectories()
 {
   // Allow a cycle to be diagnosed once.
@@ -15,6 +15,7 @@
 class cmGeneratorTarget;
 class cmGlobalGenerator;
 class cmOrderDirectoriesConstraint;
+class cmOrderDirectoriesNameIndex;
 
 /** \class cmOrderDirectories
  * \brief Compute a safe runtime path order for a set of shared libraries.
@@ -60,6 +61,9 @@ private:
   void AddOriginalDirectories(std::vector<std::string> const& dirs);
   void FindConflicts();
   void FindImplicitConflicts();
+  void FindConflictCandidates(cmOrderDirectoriesNameIndex const& index,
+                              unsigned int dirIndex, unsigned int count,
+                              std::vector<unsigned int>& entries);
   void OrderDirectories();
   void VisitDirectory(unsigned int i);
   void DiagnoseCycle();
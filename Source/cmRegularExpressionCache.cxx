@@ -0,0 +1,70 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmRegularExpressionCache.h"
+
+#include "cm_unordered_map.hxx"
+
+#include <cmsys/RegularExpression.hxx>
+#include <list>
+#include <utility>
+
+namespace {
+
+// Enough for the patterns used by the loops of a project at a time.
+size_t const MaxEntries = 128;
+
+struct Entry
+{
+  std::string Pattern;
+  cmsys::RegularExpression Regex;
+};
+
+// The entries from most to least recently used.
+typedef std::list<Entry> EntryList;
+EntryList Entries;
+typedef CM_UNORDERED_MAP<std::string, EntryList::iterator> EntryMap;
+EntryMap Lookup;
+
+unsigned long Hits = 0;
+unsigned long Misses = 0;
+}
+
+cmsys::RegularExpression* cmRegularExpressionCache::Get(
+  std::string const& pattern)
+{
+  EntryMap::iterator i = Lookup.find(pattern);
+  if (i != Lookup.end()) {
+    ++Hits;
+    Entries.splice(Entries.begin(), Entries, i->second);
+    return &i->second->Regex;
+  }
+  ++Misses;
+
+  cmsys::RegularExpression regex;
+  if (!regex.compile(pattern.c_str())) {
+    return CM_NULLPTR;
+  }
+
+  // Reuse the least recently used entry once the cache is full.
+  if (Lookup.size() < MaxEntries) {
+    Entries.push_front(Entry());
+  } else {
+    Lookup.erase(Entries.back().Pattern);
+    Entries.splice(Entries.begin(), Entries, --Entries.end());
+  }
+  Entry& entry = Entries.front();
+  entry.Pattern = pattern;
+  entry.Regex = regex;
+  Lookup.insert(EntryMap::value_type(pattern, Entries.begin()));
+  return &entry.Regex;
+}
+
+unsigned long cmRegularExpressionCache::GetHits()
+{
+  return Hits;
+}
+
+unsigned long cmRegularExpressionCache::GetMisses()
+{
+  return Misses;
+}
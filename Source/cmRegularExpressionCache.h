@@ -0,0 +1,33 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmRegularExpressionCache_h
+#define cmRegularExpressionCache_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <string>
+
+namespace cmsys {
+class RegularExpression;
+}
+
+/** \class cmRegularExpressionCache
+ * \brief Process-wide cache of compiled regular expressions.
+ *
+ * Commands taking a regular expression get the compiled program for
+ * the pattern from here instead of compiling it on every call.  The
+ * cache keeps the most recently used patterns up to a fixed number.
+ */
+class cmRegularExpressionCache
+{
+public:
+  /** Get the expression compiled from a pattern, or null if the pattern
+      does not compile.  The expression stays valid until the next call
+      and its match state is that of the last caller.  */
+  static cmsys::RegularExpression* Get(std::string const& pattern);
+
+  static unsigned long GetHits();
+  static unsigned long GetMisses();
+};
+
+#endif
@@ -21,7 +21,9 @@
 #include <utility>
 
 cmState::cmState()
-  : IsInTryCompile(false)
+  : CommandLookups(0)
+  , CommandLookupsSaved(0)
+  , IsInTryCompile(false)
   , WindowsShell(false)
   , WindowsVSIDE(false)
   , WatcomWMake(false)
@@ -30,6 +32,7 @@ cmState::cmState()
   , MSYSShell(false)
 {
   this->CacheManager = new cmCacheManager;
+  this->NewCommandGeneration();
 }
 
 cmState::~cmState()
@@ -378,6 +381,7 @@ void cmState::RenameCommand(std::string const& oldName,
     return;
   }
   cmCommand* cmd = pos->second;
+  this->NewCommandGeneration();
 
   pos = this->Commands.find(sNewName);
   if (pos != this->Commands.end()) {
@@ -392,6 +396,7 @@ void cmState::RenameCommand(std::string const& oldName,
 void cmState::AddCommand(cmCommand* command)
 {
   std::string name = cmSystemTools::LowerCase(command->GetName());
+  this->NewCommandGeneration();
   // if the command already exists, free the old one
   std::map<std::string, cmCommand*>::iterator pos = this->Commands.find(name);
   if (pos != this->Commands.end()) {
@@ -403,6 +408,7 @@ void cmState::AddCommand(cmCommand* command)
 
 void cmState::RemoveUnscriptableCommands()
 {
+  this->NewCommandGeneration();
   std::vector<std::string> unscriptableCommands;
   for (std::map<std::string, cmCommand*>::iterator pos =
          this->Commands.begin();
@@ -428,6 +434,26 @@ cmCommand* cmState::GetCommand(std::string const& name) const
   return command;
 }
 
+cmCommand* cmState::GetCommand(cmListFileFunction const& lff) const
+{
+  if (lff.CommandGeneration == this->CommandGeneration) {
+    ++this->CommandLookupsSaved;
+    return lff.Command;
+  }
+  ++this->CommandLookups;
+  lff.Command = this->GetCommand(lff.Name);
+  lff.CommandGeneration = this->CommandGeneration;
+  return lff.Command;
+}
+
+void cmState::NewCommandGeneration()
+{
+  // Generations are unique across all instances so that a function run
+  // in another instance never reuses a command found here.
+  static unsigned long nextCommandGeneration = 0;
+  this->CommandGeneration = ++nextCommandGeneration;
+}
+
 std::vector<std::string> cmState::GetCommandNames() const
 {
   std::vector<std::string> commandNames;
@@ -442,6 +468,7 @@ std::vector<std::string> cmState::GetCommandNames() const
 
 void cmState::RemoveUserDefinedCommands()
 {
+  this->NewCommandGeneration();
   std::vector<cmCommand*> renamedCommands;
   for (std::map<std::string, cmCommand*>::iterator j = this->Commands.begin();
        j != this->Commands.end();) {
@@ -21,6 +21,7 @@
 class cmCacheManager;
 class cmCommand;
 class cmListFileBacktrace;
+struct cmListFileFunction;
 class cmPropertyDefinition;
 
 class cmStateDirectory;
@@ -120,6 +121,17 @@ public:
   void SetIsInTryCompile(bool b);
 
   cmCommand* GetCommand(std::string const& name) const;
+  /**
+   * Get the command invoked by a list file function.  The command found
+   * is cached in the function and reused until the set of commands
+   * changes, so a function run over and over is looked up only once.
+   */
+  cmCommand* GetCommand(cmListFileFunction const& lff) const;
+  unsigned long GetCommandLookups() const { return this->CommandLookups; }
+  unsigned long GetCommandLookupsSaved() const
+  {
+    return this->CommandLookupsSaved;
+  }
   void AddCommand(cmCommand* command);
   void RemoveUnscriptableCommands();
   void RenameCommand(std::string const& oldName, std::string const& newName);
@@ -162,6 +174,13 @@ private:
   std::map<cmProperty::ScopeType, cmPropertyDefinitionMap> PropertyDefinitions;
   std::vector<std::string> EnabledLanguages;
   std::map<std::string, cmCommand*> Commands;
+  // Identifies the current set of Commands.  It changes whenever a
+  // command is added, renamed or removed, and no other cmState instance
+  // ever uses the same value.
+  unsigned long CommandGeneration;
+  mutable unsigned long CommandLookups;
+  mutable unsigned long CommandLookupsSaved;
+  void NewCommandGeneration();
   cmPropertyMap GlobalProperties;
   cmCacheManager* CacheManager;
 
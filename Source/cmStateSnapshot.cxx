@@ -190,6 +190,14 @@ const char* cmStateSnapshot::GetDefinition(std::string const& name) const
   return cmDefinitions::Get(name, this->Position->Vars, this->Position->Root);
 }
 
+std::vector<std::string> const* cmStateSnapshot::GetDefinitionList(
+  std::string const& name, size_t& emptyElements) const
+{
+  assert(this->Position->Vars.IsValid());
+  return cmDefinitions::GetList(name, this->Position->Vars,
+                                this->Position->Root, emptyElements);
+}
+
 bool cmStateSnapshot::IsInitialized(std::string const& name) const
 {
   return cmDefinitions::HasKey(name, this->Position->Vars,
@@ -202,6 +210,13 @@ void cmStateSnapshot::SetDefinition(std::string const& name,
   this->Position->Vars->Set(name, value.c_str());
 }
 
+bool cmStateSnapshot::AppendDefinition(std::string const& name,
+                                       std::string const& value)
+{
+  return cmDefinitions::Append(name, value.c_str(), this->Position->Vars,
+                               this->Position->Root);
+}
+
 void cmStateSnapshot::RemoveDefinition(std::string const& name)
 {
   this->Position->Vars->Set(name, CM_NULLPTR);
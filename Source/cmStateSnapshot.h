@@ -23,8 +23,11 @@ public:
   cmStateSnapshot(cmState* state, cmStateDetail::PositionType position);
 
   const char* GetDefinition(std::string const& name) const;
+  std::vector<std::string> const* GetDefinitionList(
+    std::string const& name, size_t& emptyElements) const;
   bool IsInitialized(std::string const& name) const;
   void SetDefinition(std::string const& name, std::string const& value);
+  bool AppendDefinition(std::string const& name, std::string const& value);
   void RemoveDefinition(std::string const& name);
   std::vector<std::string> UnusedKeys() const;
   std::vector<std::string> ClosureKeys() const;
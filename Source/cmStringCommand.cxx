@@ -13,6 +13,7 @@
 #include "cmCryptoHash.h"
 #include "cmGeneratorExpression.h"
 #include "cmMakefile.h"
+#include "cmRegularExpressionCache.h"
 #include "cmSystemTools.h"
 #include "cmTimestamp.h"
 #include "cmUuid.h"
@@ -251,14 +252,15 @@ bool cmStringCommand::RegexMatch(std::vector<std::string> const& args)
 
   this->Makefile->ClearMatches();
   // Compile the regular expression.
-  cmsys::RegularExpression re;
-  if (!re.compile(regex.c_str())) {
+  cmsys::RegularExpression* compiled = cmRegularExpressionCache::Get(regex);
+  if (!compiled) {
     std::string e =
       "sub-command REGEX, mode MATCH failed to compile regex \"" + regex +
       "\".";
     this->SetError(e);
     return false;
   }
+  cmsys::RegularExpression& re = *compiled;
 
   // Concatenate all the last arguments together.
   std::string input = cmJoin(cmMakeRange(args).advance(4), std::string());
@@ -292,14 +294,15 @@ bool cmStringCommand::RegexMatchAll(std::vector<std::string> const& args)
 
   this->Makefile->ClearMatches();
   // Compile the regular expression.
-  cmsys::RegularExpression re;
-  if (!re.compile(regex.c_str())) {
+  cmsys::RegularExpression* compiled = cmRegularExpressionCache::Get(regex);
+  if (!compiled) {
     std::string e =
       "sub-command REGEX, mode MATCHALL failed to compile regex \"" + regex +
       "\".";
     this->SetError(e);
     return false;
   }
+  cmsys::RegularExpression& re = *compiled;
 
   // Concatenate all the last arguments together.
   std::string input = cmJoin(cmMakeRange(args).advance(4), std::string());
@@ -374,14 +377,15 @@ bool cmStringCommand::RegexReplace(std::vector<std::string> const& args)
 
   this->Makefile->ClearMatches();
   // Compile the regular expression.
-  cmsys::RegularExpression re;
-  if (!re.compile(regex.c_str())) {
+  cmsys::RegularExpression* compiled = cmRegularExpressionCache::Get(regex);
+  if (!compiled) {
     std::string e =
       "sub-command REGEX, mode REPLACE failed to compile regex \"" + regex +
       "\".";
     this->SetError(e);
     return false;
   }
+  cmsys::RegularExpression& re = *compiled;
 
   // Concatenate all the last arguments together.
   std::string input = cmJoin(cmMakeRange(args).advance(5), std::string());
@@ -630,13 +634,10 @@ bool cmStringCommand::HandleAppendCommand(std::vector<std::string> const& args)
 
   const std::string& variable = args[1];
 
-  std::string value;
-  const char* oldValue = this->Makefile->GetDefinition(variable);
-  if (oldValue) {
-    value = oldValue;
-  }
-  value += cmJoin(cmMakeRange(args).advance(2), std::string());
-  this->Makefile->AddDefinition(variable, value.c_str());
+  // Read the old value as watches expect, but append to it in place.
+  this->Makefile->GetDefinition(variable);
+  this->Makefile->AppendDefinition(
+    variable, cmJoin(cmMakeRange(args).advance(2), std::string()));
   return true;
 }
 
@@ -1016,10 +1016,24 @@ void cmSystemTools::ExpandListArgument(const std::string& arg,
     newargs.push_back(arg);
     return;
   }
-  std::string newArg;
-  const char* last = arg.c_str();
-  // Break the string at non-escaped semicolons not nested in [].
+  std::vector<std::string>::size_type const first = newargs.size();
+  newargs.push_back(std::string());
   int squareNesting = 0;
+  cmSystemTools::SplitListArgument(arg.c_str(), newargs, squareNesting);
+  if (!emptyArgs) {
+    // Drop the empty elements.
+    newargs.erase(std::remove(newargs.begin() + first, newargs.end(),
+                              std::string()),
+                  newargs.end());
+  }
+}
+
+void cmSystemTools::SplitListArgument(const char* arg,
+                                      std::vector<std::string>& elements,
+                                      int& nesting)
+{
+  const char* last = arg;
+  // Break the string at non-escaped semicolons not nested in [].
   for (const char* c = last; *c; ++c) {
     switch (*c) {
       case '\\': {
@@ -1027,29 +1041,25 @@ void cmSystemTools::ExpandListArgument(const std::string& arg,
         // escapes should not be processed here.
         const char* next = c + 1;
         if (*next == ';') {
-          newArg.append(last, c - last);
+          elements.back().append(last, c - last);
           // Skip over the escape character
           last = c = next;
         }
       } break;
       case '[': {
-        ++squareNesting;
+        ++nesting;
       } break;
       case ']': {
-        --squareNesting;
+        --nesting;
       } break;
       case ';': {
         // Break the string here if we are not nested inside square
         // brackets.
-        if (squareNesting == 0) {
-          newArg.append(last, c - last);
+        if (nesting == 0) {
+          elements.back().append(last, c - last);
           // Skip over the semicolon
           last = c + 1;
-          if (!newArg.empty() || emptyArgs) {
-            // Add the last argument if the string is not empty.
-            newargs.push_back(newArg);
-            newArg = "";
-          }
+          elements.push_back(std::string());
         }
       } break;
       default: {
@@ -1057,11 +1067,7 @@ void cmSystemTools::ExpandListArgument(const std::string& arg,
       } break;
     }
   }
-  newArg.append(last);
-  if (!newArg.empty() || emptyArgs) {
-    // Add the last argument if the string is not empty.
-    newargs.push_back(newArg);
-  }
+  elements.back().append(last);
 }
 
 bool cmSystemTools::SimpleGlob(const std::string& glob,
@@ -34,6 +34,17 @@ public:
                                  std::vector<std::string>& argsOut,
                                  bool emptyArgs = false);
 
+  /**
+   * Split a list into elements as ExpandListArgument does with empty
+   * elements kept, continuing where a previous split ended.  The last
+   * of the elements is the one still being read and nesting the depth
+   * of square brackets at the end of the previous part.  Start with one
+   * empty element and a depth of zero.
+   */
+  static void SplitListArgument(const char* arg,
+                                std::vector<std::string>& elements,
+                                int& nesting);
+
   /**
    * Look for and replace registry values in a string
    */
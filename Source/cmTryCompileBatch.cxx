@@ -0,0 +1,283 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTryCompileBatch.h"
+
+#include "cmGlobalGenerator.h"
+#include "cmSystemTools.h"
+
+#ifdef CMAKE_USE_LIBUV
+#include "cmUVProcessGroup.h"
+#include "cm_uv.h"
+
+#include <string.h>
+
+namespace {
+
+// The queued test projects being built by one call to Build.
+struct BuildQueue
+{
+  cmGlobalGenerator* GlobalGenerator;
+  std::string Config;
+  unsigned int Parallel;
+  unsigned int Running;
+  std::vector<cmTryCompileBatch::Job>::iterator Next;
+  std::vector<cmTryCompileBatch::Job>::iterator End;
+  uv_loop_t Loop;
+};
+
+// A native build of one queued test project.  Its handles are closed
+// once it finished and it deletes itself when the last one is.
+struct RunningBuild
+{
+  BuildQueue* Queue;
+  cmTryCompileBatch::Job* Job;
+  std::vector<std::string> Command;
+  uv_process_t Process;
+  uv_pipe_t Pipes[2];
+  bool Reading[2];
+  uv_timer_t Timer;
+  cmUVProcessGroup Group;
+  std::vector<char> ReadBuffer;
+  std::vector<char> Output;
+  int OpenHandles;
+  bool Exited;
+  bool Ran;
+  bool Expired;
+  int ExitValue;
+};
+
+void StartNextBuilds(BuildQueue& queue);
+
+void OnClose(uv_handle_t* handle)
+{
+  RunningBuild* build = static_cast<RunningBuild*>(handle->data);
+  if (--build->OpenHandles == 0) {
+    delete build;
+  }
+}
+
+void CloseBuildHandle(RunningBuild* build, uv_handle_t* handle)
+{
+  handle->data = build;
+  uv_close(handle, &OnClose);
+}
+
+void FinishBuild(RunningBuild* build)
+{
+  // Wait for the build to exit and all its output to be read.
+  if (!build->Exited || build->Reading[0] || build->Reading[1]) {
+    return;
+  }
+  cmTryCompileBatch::Job& job = *build->Job;
+  job.Output.append(build->Output.begin(), build->Output.end());
+  if (build->Expired) {
+    job.Output += "Process terminated due to timeout\n";
+  }
+  BuildQueue& queue = *build->Queue;
+  job.Result = queue.GlobalGenerator->FinishBuild(build->Command, build->Ran,
+                                                  build->ExitValue,
+                                                  job.Output);
+
+  build->OpenHandles = 4;
+  CloseBuildHandle(build, reinterpret_cast<uv_handle_t*>(&build->Process));
+  CloseBuildHandle(build, reinterpret_cast<uv_handle_t*>(&build->Pipes[0]));
+  CloseBuildHandle(build, reinterpret_cast<uv_handle_t*>(&build->Pipes[1]));
+  CloseBuildHandle(build, reinterpret_cast<uv_handle_t*>(&build->Timer));
+
+  --queue.Running;
+  StartNextBuilds(queue);
+}
+
+void StopReading(RunningBuild* build, int i)
+{
+  if (build->Reading[i]) {
+    uv_read_stop(reinterpret_cast<uv_stream_t*>(&build->Pipes[i]));
+    build->Reading[i] = false;
+  }
+}
+
+void OnAllocate(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf)
+{
+  RunningBuild* build = static_cast<RunningBuild*>(handle->data);
+  build->ReadBuffer.resize(suggested_size);
+  *buf = uv_buf_init(&build->ReadBuffer[0],
+                     static_cast<unsigned int>(suggested_size));
+}
+
+void OnRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
+{
+  RunningBuild* build = static_cast<RunningBuild*>(stream->data);
+  if (nread > 0) {
+    // Translate NULL characters in the output into valid text.
+    for (ssize_t i = 0; i < nread; ++i) {
+      build->Output.push_back(buf->base[i] != '\0' ? buf->base[i] : ' ');
+    }
+  } else if (nread < 0) {
+    int const i =
+      stream == reinterpret_cast<uv_stream_t*>(&build->Pipes[0]) ? 0 : 1;
+    StopReading(build, i);
+    FinishBuild(build);
+  }
+}
+
+void OnExit(uv_process_t* process, int64_t exit_status, int term_signal)
+{
+  RunningBuild* build = static_cast<RunningBuild*>(process->data);
+  build->Exited = true;
+  uv_timer_stop(&build->Timer);
+  build->Ran = !build->Expired && term_signal == 0;
+  build->ExitValue = static_cast<int>(exit_status);
+  if (build->Expired) {
+    // Do not wait for output of descendants that outlived the kill.
+    StopReading(build, 0);
+    StopReading(build, 1);
+  }
+  FinishBuild(build);
+}
+
+void OnTimeout(uv_timer_t* timer)
+{
+  RunningBuild* build = static_cast<RunningBuild*>(timer->data);
+  if (!build->Exited) {
+    build->Expired = true;
+    build->Group.Kill();
+  }
+}
+
+void StartBuild(BuildQueue& queue, cmTryCompileBatch::Job& job)
+{
+  RunningBuild* build = new RunningBuild;
+  build->Queue = &queue;
+  build->Job = &job;
+  build->Reading[0] = false;
+  build->Reading[1] = false;
+  build->OpenHandles = 0;
+  build->Exited = false;
+  build->Ran = false;
+  build->Expired = false;
+  build->ExitValue = 1;
+  ++queue.Running;
+
+  cmGlobalGenerator* gg = queue.GlobalGenerator;
+  gg->UpdateTryCompileProgress();
+  cmSystemTools::OutputOption outputflag = cmSystemTools::OUTPUT_NONE;
+  gg->StartBuild(build->Command, job.BinaryDirectory, job.ProjectName,
+                 job.TargetName, job.Output, "", queue.Config, false, true,
+                 false, gg->TryCompileTimeout, outputflag);
+
+  std::vector<const char*> argv;
+  for (std::vector<std::string>::const_iterator a = build->Command.begin();
+       a != build->Command.end(); ++a) {
+    argv.push_back(a->c_str());
+  }
+  argv.push_back(CM_NULLPTR);
+
+  // The output of the build is read from pipes for stdout and stderr
+  // into one buffer as it arrives.
+  uv_stdio_container_t stdio[3];
+  stdio[0].flags = UV_IGNORE;
+  for (int i = 0; i < 2; ++i) {
+    uv_pipe_init(&queue.Loop, &build->Pipes[i], 0);
+    build->Pipes[i].data = build;
+    stdio[i + 1].flags =
+      static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+    stdio[i + 1].data.stream =
+      reinterpret_cast<uv_stream_t*>(&build->Pipes[i]);
+  }
+  uv_timer_init(&queue.Loop, &build->Timer);
+  build->Timer.data = build;
+
+  uv_process_options_t options;
+  memset(&options, 0, sizeof(options));
+  options.file = argv[0];
+  options.args = const_cast<char**>(&*argv.begin());
+  options.cwd = job.BinaryDirectory.c_str();
+  options.exit_cb = &OnExit;
+  options.flags = UV_PROCESS_WINDOWS_HIDE;
+  options.stdio_count = 3;
+  options.stdio = stdio;
+  cmUVProcessGroup::SetupOptions(options);
+  build->Process.data = build;
+  int status = uv_spawn(&queue.Loop, &build->Process, &options);
+  if (status != 0) {
+    build->Output.insert(build->Output.end(), uv_strerror(status),
+                         uv_strerror(status) + strlen(uv_strerror(status)));
+    build->Exited = true;
+    FinishBuild(build);
+    return;
+  }
+  build->Group.Attach(&build->Process);
+
+  for (int i = 0; i < 2; ++i) {
+    uv_read_start(reinterpret_cast<uv_stream_t*>(&build->Pipes[i]),
+                  &OnAllocate, &OnRead);
+    build->Reading[i] = true;
+  }
+  if (gg->TryCompileTimeout > 0) {
+    uv_timer_start(&build->Timer, &OnTimeout,
+                   static_cast<uint64_t>(gg->TryCompileTimeout) * 1000, 0);
+  }
+}
+
+void StartNextBuilds(BuildQueue& queue)
+{
+  while (queue.Next != queue.End && queue.Running < queue.Parallel) {
+    StartBuild(queue, *queue.Next++);
+  }
+}
+}
+#endif
+
+void cmTryCompileBatch::AddJob(Job const& job)
+{
+  this->Jobs.push_back(job);
+}
+
+bool cmTryCompileBatch::HasBinaryDirectory(std::string const& dir) const
+{
+  for (std::vector<Job>::const_iterator ji = this->Jobs.begin();
+       ji != this->Jobs.end(); ++ji) {
+    if (ji->BinaryDirectory == dir) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void cmTryCompileBatch::TakeJobs(std::vector<Job>& jobs)
+{
+  jobs.clear();
+  jobs.swap(this->Jobs);
+}
+
+void cmTryCompileBatch::Build(cmGlobalGenerator* gg,
+                              std::string const& config,
+                              unsigned int parallel, std::vector<Job>& jobs)
+{
+  this->TakeJobs(jobs);
+
+#ifdef CMAKE_USE_LIBUV
+  // Run the builds from an event loop that waits for any of them to
+  // provide output or exit.
+  BuildQueue queue;
+  queue.GlobalGenerator = gg;
+  queue.Config = config;
+  queue.Parallel = parallel < 1 ? 1 : parallel;
+  queue.Running = 0;
+  queue.Next = jobs.begin();
+  queue.End = jobs.end();
+  uv_loop_init(&queue.Loop);
+  StartNextBuilds(queue);
+  uv_run(&queue.Loop, UV_RUN_DEFAULT);
+  uv_loop_close(&queue.Loop);
+#else
+  // Build the projects one at a time.
+  static_cast<void>(parallel);
+  for (std::vector<Job>::iterator ji = jobs.begin(); ji != jobs.end(); ++ji) {
+    gg->UpdateTryCompileProgress();
+    ji->Result = gg->Build("", ji->BinaryDirectory, ji->ProjectName,
+                           ji->TargetName, ji->Output, "", config, false, true,
+                           false, gg->TryCompileTimeout);
+  }
+#endif
+}
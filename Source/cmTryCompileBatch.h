@@ -0,0 +1,63 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileBatch_h
+#define cmTryCompileBatch_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include "cmListFileCache.h"
+
+#include <string>
+#include <vector>
+
+class cmGlobalGenerator;
+
+/** \class cmTryCompileBatch
+ * \brief Queue of try_compile test projects whose build was deferred.
+ *
+ * The try_compile command generates a test project given the DEFER
+ * option right away but only queues its build.  The queued projects
+ * are later built together, running several native builds at once.
+ */
+class cmTryCompileBatch
+{
+public:
+  struct Job
+  {
+    Job()
+      : Result(1)
+    {
+    }
+    std::string BinaryDirectory;
+    std::string ProjectName;
+    std::string TargetName;
+    std::string ResultVariable;
+    std::string OutputVariable;
+    std::string CacheDirectory;
+    std::string CacheKey;
+    int Result;
+    std::string Output;
+    cmListFileBacktrace Backtrace;
+  };
+
+  /** Queue a generated test project to be built later.  */
+  void AddJob(Job const& job);
+
+  /** Whether a queued test project uses the given binary directory.  */
+  bool HasBinaryDirectory(std::string const& dir) const;
+
+  /** Build all queued test projects with the native build tool of the
+      given generator, running up to 'parallel' builds concurrently.
+      The queue is emptied into 'jobs' with the result and output of
+      each build filled in as cmGlobalGenerator::TryCompile would.  */
+  void Build(cmGlobalGenerator* gg, std::string const& config,
+             unsigned int parallel, std::vector<Job>& jobs);
+
+  /** Empty the queue into 'jobs' without building anything.  */
+  void TakeJobs(std::vector<Job>& jobs);
+
+private:
+  std::vector<Job> Jobs;
+};
+
+#endif
@@ -0,0 +1,92 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTryCompileCache.h"
+
+#include "cmSystemTools.h"
+
+#include <cmsys/FStream.hxx>
+#include <iterator>
+#include <sstream>
+
+// Every entry starts with this signature.  Bump the trailing version
+// number whenever the layout written by Store changes.
+static const char cmTryCompileCacheSignature[] = "CMTCC1\n";
+
+cmTryCompileCache::cmTryCompileCache()
+  : Hits(0)
+  , Misses(0)
+{
+}
+
+bool cmTryCompileCache::Lookup(std::string const& dir, std::string const& key,
+                               int& result, std::string& output)
+{
+  cmsys::ifstream fin(GetEntryPath(dir, key).c_str(),
+                      std::ios::in | std::ios::binary);
+  if (fin) {
+    std::string data((std::istreambuf_iterator<char>(fin)),
+                     std::istreambuf_iterator<char>());
+    std::string::size_type n = sizeof(cmTryCompileCacheSignature) - 1;
+    std::string::size_type eol = data.find('\n', n);
+    if (data.compare(0, n, cmTryCompileCacheSignature) == 0 &&
+        eol != std::string::npos) {
+      std::istringstream resultStr(data.substr(n, eol - n));
+      if (resultStr >> result) {
+        output = data.substr(eol + 1);
+        ++this->Hits;
+        return true;
+      }
+    }
+  }
+  ++this->Misses;
+  return false;
+}
+
+bool cmTryCompileCache::Store(std::string const& dir, std::string const& key,
+                              int result, std::string const& output)
+{
+  std::string path = GetEntryPath(dir, key);
+  if (!cmSystemTools::MakeDirectory(
+        cmSystemTools::GetFilenamePath(path).c_str())) {
+    return false;
+  }
+
+  // Other runs sharing the directory may store the same entry at the
+  // same time, so write it to a file of our own first and move that into
+  // place.  Readers then never see a partial entry.
+  std::ostringstream tempFile;
+  tempFile << path << "." << std::hex << cmSystemTools::RandomSeed()
+           << ".tmp";
+  {
+    cmsys::ofstream fout(tempFile.str().c_str(),
+                         std::ios::out | std::ios::binary);
+    if (!fout) {
+      return false;
+    }
+    fout << cmTryCompileCacheSignature << result << "\n" << output;
+    fout.close();
+    if (!fout) {
+      cmSystemTools::RemoveFile(tempFile.str());
+      return false;
+    }
+  }
+  if (!cmSystemTools::RenameFile(tempFile.str().c_str(), path.c_str())) {
+    cmSystemTools::RemoveFile(tempFile.str());
+    return false;
+  }
+  return true;
+}
+
+void cmTryCompileCache::ResetStatistics()
+{
+  this->Hits = 0;
+  this->Misses = 0;
+}
+
+std::string cmTryCompileCache::GetEntryPath(std::string const& dir,
+                                            std::string const& key)
+{
+  // Spread entries over subdirectories named by the first two key
+  // characters to keep directory sizes reasonable.
+  return dir + "/" + key.substr(0, 2) + "/" + key;
+}
@@ -0,0 +1,46 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileCache_h
+#define cmTryCompileCache_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <string>
+
+/** \class cmTryCompileCache
+ * \brief Persistent store of try_compile results shared by build trees.
+ *
+ * Each result is kept in its own file named after a key that hashes
+ * everything the test project build depends on, so entries never need
+ * to be updated in place and several build trees may share a directory.
+ * The cache also counts how many lookups were satisfied.
+ */
+class cmTryCompileCache
+{
+public:
+  cmTryCompileCache();
+
+  /** Get the result and output recorded for the key in the directory.
+      Returns false if there is no valid entry.  */
+  bool Lookup(std::string const& dir, std::string const& key, int& result,
+              std::string& output);
+
+  /** Record the result and output of a test project build.
+      Returns false if the entry could not be written.  */
+  bool Store(std::string const& dir, std::string const& key, int result,
+             std::string const& output);
+
+  /** Number of lookups satisfied / not satisfied since the last reset.  */
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+  void ResetStatistics();
+
+private:
+  unsigned long Hits;
+  unsigned long Misses;
+
+  static std::string GetEntryPath(std::string const& dir,
+                                  std::string const& key);
+};
+
+#endif
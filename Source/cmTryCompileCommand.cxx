@@ -11,6 +11,10 @@ class cmExecutionStatus;
 bool cmTryCompileCommand::InitialPass(std::vector<std::string> const& argv,
                                       cmExecutionStatus&)
 {
+  if (!argv.empty() && argv[0] == "BUILD_DEFERRED") {
+    return this->BuildDeferred(argv);
+  }
+
   if (argv.size() < 3) {
     return false;
   }
@@ -26,7 +30,7 @@ bool cmTryCompileCommand::InitialPass(std::vector<std::string> const& argv,
   this->TryCompileCode(argv, false);
 
   // if They specified clean then we clean up what we can
-  if (this->SrcFileSignature) {
+  if (this->SrcFileSignature && !this->Deferred) {
     if (!this->Makefile->GetCMakeInstance()->GetDebugTryCompile()) {
       this->CleanupFiles(this->BinaryDirectory.c_str());
     }
@@ -0,0 +1,68 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmUVProcessGroup.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <signal.h>
+#include <sys/types.h>
+#endif
+
+cmUVProcessGroup::cmUVProcessGroup()
+  : Process(CM_NULLPTR)
+  , Job(CM_NULLPTR)
+{
+}
+
+cmUVProcessGroup::~cmUVProcessGroup()
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  if (this->Job) {
+    CloseHandle(static_cast<HANDLE>(this->Job));
+  }
+#endif
+}
+
+void cmUVProcessGroup::SetupOptions(uv_process_options_t& options)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  // A detached process has no console, so each console program it runs
+  // would open a window of its own.  Attach assigns a job object instead.
+  static_cast<void>(options);
+#else
+  // The detached process calls setsid, leading a new process group.
+  options.flags |= UV_PROCESS_DETACHED;
+#endif
+}
+
+void cmUVProcessGroup::Attach(uv_process_t* process)
+{
+  this->Process = process;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  // Windows before 8 cannot put the process in a second job besides the
+  // one libuv uses.  Only the process itself can be killed then.
+  HANDLE job = CreateJobObjectW(CM_NULLPTR, CM_NULLPTR);
+  if (job && !AssignProcessToJobObject(job, process->process_handle)) {
+    CloseHandle(job);
+    job = CM_NULLPTR;
+  }
+  this->Job = job;
+#endif
+}
+
+void cmUVProcessGroup::Kill()
+{
+  if (!this->Process) {
+    return;
+  }
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  if (this->Job) {
+    TerminateJobObject(static_cast<HANDLE>(this->Job), 1);
+    return;
+  }
+  uv_process_kill(this->Process, SIGKILL);
+#else
+  kill(-static_cast<pid_t>(this->Process->pid), SIGKILL);
+#endif
+}
@@ -0,0 +1,41 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmUVProcessGroup_h
+#define cmUVProcessGroup_h
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include "cm_uv.h"
+
+/** \class cmUVProcessGroup
+ * \brief A process spawned by libuv together with its descendants.
+ *
+ * Kill ends the process and every process it started, as kwsys does on
+ * timeout, without having to find them.  On POSIX the process leads a
+ * process group of its own that its descendants join.  On Windows it is
+ * assigned to a job object.
+ */
+class cmUVProcessGroup
+{
+public:
+  cmUVProcessGroup();
+  ~cmUVProcessGroup();
+
+  /** Set up options for uv_spawn to start a process of a new group.  */
+  static void SetupOptions(uv_process_options_t& options);
+
+  /** Take the process uv_spawn started with those options.  */
+  void Attach(uv_process_t* process);
+
+  /** Kill the process and all of its descendants.  */
+  void Kill();
+
+private:
+  uv_process_t* Process;
+  void* Job;
+
+  cmUVProcessGroup(cmUVProcessGroup const&); // Purposely not implemented.
+  void operator=(cmUVProcessGroup const&);   // Purposely not implemented.
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmMessenger.h"
+#include "cmRegularExpressionCache.h"
 #include "cmState.h"
 #include "cmSystemTools.h"
 #include "cmTarget.h"
@@ -26,6 +27,10 @@
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 #include "cmGraphVizWriter.h"
+#include "cmListFileParseCache.h"
+#include "cmMakefileProfilingData.h"
+#include "cmTryCompileBatch.h"
+#include "cmTryCompileCache.h"
 #include "cmVariableWatch.h"
 #include "cm_unordered_map.hxx"
 
@@ -155,6 +160,10 @@ cmake::cmake()
   this->State = new cmState;
   this->CurrentSnapshot = this->State->CreateBaseSnapshot();
   this->Messenger = new cmMessenger(this->State);
+  this->ListFileParseCache = CM_NULLPTR;
+  this->ProfilingOutput = CM_NULLPTR;
+  this->TryCompileBatch = CM_NULLPTR;
+  this->TryCompileCache = CM_NULLPTR;
 
 #ifdef __APPLE__
   struct rlimit rlp;
@@ -173,6 +182,8 @@ cmake::cmake()
 
 #ifdef CMAKE_BUILD_WITH_CMAKE
   this->VariableWatch = new cmVariableWatch;
+  this->TryCompileBatch = new cmTryCompileBatch;
+  this->TryCompileCache = new cmTryCompileCache;
 #endif
 
   this->AddDefaultGenerators();
@@ -218,6 +229,9 @@ cmake::~cmake()
   cmDeleteAll(this->Generators);
 #ifdef CMAKE_BUILD_WITH_CMAKE
   delete this->VariableWatch;
+  delete this->ProfilingOutput;
+  delete this->TryCompileBatch;
+  delete this->TryCompileCache;
 #endif
   delete this->FileComparison;
 }
@@ -688,7 +702,27 @@ void cmake::SetArgs(const std::vector<std::string>& args,
       std::cout << "Running with trace output on.\n";
       this->SetTrace(true);
       this->SetTraceExpand(false);
-    } else if (arg.find("--warn-uninitialized", 0) == 0) {
+    }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    else if (arg.find("--profiling-output=", 0) == 0) {
+      std::string file = arg.substr(strlen("--profiling-output="));
+      if (file.empty()) {
+        cmSystemTools::Error("No file specified for --profiling-output");
+        return;
+      }
+      file = cmSystemTools::CollapseFullPath(file);
+      delete this->ProfilingOutput;
+      this->ProfilingOutput = new cmMakefileProfilingData(file);
+      if (!this->ProfilingOutput->IsValid()) {
+        cmSystemTools::Error("Could not open --profiling-output file ",
+                             file.c_str());
+        delete this->ProfilingOutput;
+        this->ProfilingOutput = CM_NULLPTR;
+        return;
+      }
+    }
+#endif
+    else if (arg.find("--warn-uninitialized", 0) == 0) {
       std::cout << "Warn about uninitialized values.\n";
       this->SetWarnUninitialized(true);
     } else if (arg.find("--warn-unused-vars", 0) == 0) {
@@ -1392,8 +1426,72 @@ int cmake::ActualConfigure()
     this->TruncateOutputLog("CMakeError.log");
   }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Load parsed list files recorded by previous runs, if enabled.
+  std::string parseCacheFile;
+  if (const char* pcf =
+        this->State->GetInitializedCacheValue("CMAKE_LISTFILE_PARSE_CACHE")) {
+    if (*pcf) {
+      parseCacheFile =
+        cmSystemTools::CollapseFullPath(pcf, this->GetHomeOutputDirectory());
+      this->ListFileParseCache = new cmListFileParseCache;
+      this->ListFileParseCache->Load(parseCacheFile);
+    }
+  }
+#endif
+
   // actually do the configure
   this->GlobalGenerator->Configure();
+
+  if (this->GetDebugOutput()) {
+    unsigned long const saved = this->State->GetCommandLookupsSaved();
+    unsigned long const total = this->State->GetCommandLookups() + saved;
+    std::ostringstream msg;
+    msg << "Command lookups: " << saved << " of " << total
+        << " reused from previous calls";
+    this->UpdateProgress(msg.str().c_str(), -1);
+    msg.str("");
+    msg << "Regular expressions: " << cmRegularExpressionCache::GetHits()
+        << " of "
+        << (cmRegularExpressionCache::GetHits() +
+            cmRegularExpressionCache::GetMisses())
+        << " compiled expressions reused from cache";
+    this->UpdateProgress(msg.str().c_str(), -1);
+  }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (this->ProfilingOutput) {
+    std::map<std::string, unsigned long> counts;
+    counts["hits"] = cmRegularExpressionCache::GetHits();
+    counts["misses"] = cmRegularExpressionCache::GetMisses();
+    this->ProfilingOutput->RecordCounters("regular expressions", counts);
+  }
+
+  if (this->ListFileParseCache) {
+    cmListFileParseCache* parseCache = this->ListFileParseCache;
+    this->ListFileParseCache = CM_NULLPTR;
+    std::ostringstream msg;
+    msg << "List file parse cache: " << parseCache->GetHits() << " of "
+        << (parseCache->GetHits() + parseCache->GetMisses())
+        << " files loaded from cache";
+    this->UpdateProgress(msg.str().c_str(), -1);
+    if (!parseCache->Save()) {
+      cmSystemTools::Error("Could not write list file parse cache ",
+                           parseCacheFile.c_str());
+    }
+    delete parseCache;
+  }
+  if (this->TryCompileCache->GetHits() + this->TryCompileCache->GetMisses()) {
+    std::ostringstream msg;
+    msg << "try_compile cache: " << this->TryCompileCache->GetHits()
+        << " of "
+        << (this->TryCompileCache->GetHits() +
+            this->TryCompileCache->GetMisses())
+        << " results loaded from cache";
+    this->UpdateProgress(msg.str().c_str(), -1);
+    this->TryCompileCache->ResetStatistics();
+  }
+#endif
   // Before saving the cache
   // if the project did not define one of the entries below, add them now
   // so users can edit the values in the cache:
@@ -2534,3 +2632,23 @@ void cmake::SetDeprecatedWarningsAsErrors(bool b)
                       " and functions.",
                       cmStateEnums::INTERNAL);
 }
+
+std::string cmake::StripExtension(const std::string& file) const
+{
+  std::string::size_type dotpos = file.rfind('.');
+  if (dotpos != std::string::npos) {
+    std::string ext = file.substr(dotpos + 1);
+#if defined(_WIN32) || defined(__APPLE__)
+    ext = cmSystemTools::LowerCase(ext);
+#endif
+    if (std::find(this->SourceFileExtensions.begin(),
+                  this->SourceFileExtensions.end(),
+                  ext) != this->SourceFileExtensions.end() ||
+        std::find(this->HeaderFileExtensions.begin(),
+                  this->HeaderFileExtensions.end(),
+                  ext) != this->HeaderFileExtensions.end()) {
+      return file.substr(0, dotpos);
+    }
+  }
+  return file;
+}
@@ -22,8 +22,12 @@ class cmExternalMakefileProjectGeneratorFactory;
 class cmFileTimeComparison;
 class cmGlobalGenerator;
 class cmGlobalGeneratorFactory;
+class cmListFileParseCache;
 class cmMakefile;
+class cmMakefileProfilingData;
 class cmMessenger;
+class cmTryCompileBatch;
+class cmTryCompileCache;
 class cmVariableWatch;
 struct cmDocumentationEntry;
 
@@ -225,6 +229,12 @@ public:
     return this->HeaderFileExtensions;
   }
 
+  /**
+   * Remove the last extension of a file name if it is one of the
+   * known source or header extensions.
+   */
+  std::string StripExtension(const std::string& file) const;
+
   /**
    * Given a variable name, return its value (as a string).
    */
@@ -407,6 +417,33 @@ public:
   void WatchUnusedCli(const std::string& var);
 
   cmState* GetState() const { return this->State; }
+
+  /** Get the cache of parsed list files enabled by the
+      CMAKE_LISTFILE_PARSE_CACHE variable, if any.  */
+  cmListFileParseCache* GetListFileParseCache() const
+  {
+    return this->ListFileParseCache;
+  }
+
+  /** Get the profiler enabled by --profiling-output, if any.  */
+  cmMakefileProfilingData* GetProfilingOutput() const
+  {
+    return this->ProfilingOutput;
+  }
+
+  /** Get the queue of try_compile test projects given DEFER.  */
+  cmTryCompileBatch* GetTryCompileBatch() const
+  {
+    return this->TryCompileBatch;
+  }
+
+  /** Get the store of try_compile results used when the
+      CMAKE_TRY_COMPILE_CACHE_DIR variable is set.  */
+  cmTryCompileCache* GetTryCompileCache() const
+  {
+    return this->TryCompileCache;
+  }
+
   void SetCurrentSnapshot(cmStateSnapshot snapshot)
   {
     this->CurrentSnapshot = snapshot;
@@ -489,6 +526,10 @@ private:
   cmState* State;
   cmStateSnapshot CurrentSnapshot;
   cmMessenger* Messenger;
+  cmListFileParseCache* ListFileParseCache;
+  cmMakefileProfilingData* ProfilingOutput;
+  cmTryCompileBatch* TryCompileBatch;
+  cmTryCompileCache* TryCompileCache;
 
   std::vector<std::string> TraceOnlyThisSources;
 
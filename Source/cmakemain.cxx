@@ -79,6 +79,8 @@ static const char* cmDocumentationOptions[][2] = {
   { "--trace-expand", "Put cmake in trace mode with variable expansion." },
   { "--trace-source=<file>",
     "Trace only this CMake file/module. Multiple options allowed." },
+  { "--profiling-output=<file>",
+    "Write a Chrome trace-event profile of the cmake run to a file." },
   { "--warn-uninitialized", "Warn about uninitialized values." },
   { "--warn-unused-vars", "Warn about unused variables." },
   { "--no-warn-unused-cli", "Don't warn about command line options." },
@@ -99,6 +99,8 @@ static const char* cmDocumentationOptions[][2] = {
   { "--force-new-ctest-process",
     "Run child CTest instances as new processes" },
   { "--schedule-random", "Use a random order for scheduling tests" },
+  { "--schedule-critical-path",
+    "Start tests holding up the longest chain of dependent tests first" },
   { "--submit-index",
     "Submit individual dashboard tests with specific index" },
   { "--timeout <seconds>", "Set a global timeout on all tests." },
@@ -0,0 +1,246 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCTestMultiProcessHandler.h"
+
+#include "cmCTestTestHandler.h"
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+typedef cmCTestTestHandler::cmCTestTestProperties TestProperties;
+
+// Orders a set of tests the way ctest would and simulates running them
+// in that order, starting tests from the front of the list whenever
+// one finishes exactly as cmCTestMultiProcessHandler::StartNextTests.
+class SchedulingSimulator : public cmCTestMultiProcessHandler
+{
+public:
+  SchedulingSimulator(size_t parallel, bool criticalPath)
+  {
+    this->SetParallelLevel(parallel);
+    this->SetCriticalPathSchedule(criticalPath);
+  }
+
+  ~SchedulingSimulator()
+  {
+    for (PropertiesMap::iterator i = this->Properties.begin();
+         i != this->Properties.end(); ++i) {
+      delete i->second;
+    }
+  }
+
+  void AddTest(int index, float cost, int processors = 1,
+               const char* lock = CM_NULLPTR)
+  {
+    TestProperties* p = new TestProperties;
+    std::ostringstream name;
+    name << "test" << index;
+    p->Name = name.str();
+    p->Cost = cost;
+    p->Index = index;
+    p->Processors = processors;
+    p->RunSerial = false;
+    if (lock) {
+      p->LockedResources.insert(lock);
+    }
+    this->Properties[index] = p;
+    this->Tests[index];
+  }
+
+  void AddDepends(int index, int dependency)
+  {
+    this->Tests[index].insert(dependency);
+  }
+
+  // Return the time at which the last test finishes, or -1 if the
+  // limits of the test properties were not honored.
+  float Simulate()
+  {
+    this->CreateTestCostList();
+    TestMap waiting = this->Tests;
+    std::map<int, float> running; // test -> end time
+    std::set<int> started;
+    float now = 0;
+    while (started.size() < this->Tests.size() || !running.empty()) {
+      size_t used = 0;
+      std::set<std::string> locks;
+      for (std::map<int, float>::const_iterator r = running.begin();
+           r != running.end(); ++r) {
+        used += this->Processors(r->first);
+        locks.insert(this->Properties[r->first]->LockedResources.begin(),
+                     this->Properties[r->first]->LockedResources.end());
+      }
+      if (used > this->ParallelLevel) {
+        return -1;
+      }
+      size_t numToStart = this->ParallelLevel - used;
+      for (TestList::const_iterator t = this->SortedTests.begin();
+           t != this->SortedTests.end() && numToStart > 0; ++t) {
+        TestProperties const* p = this->Properties[*t];
+        if (started.count(*t) || !waiting[*t].empty() ||
+            this->Processors(*t) > numToStart) {
+          continue;
+        }
+        bool locked = false;
+        for (std::set<std::string>::const_iterator l =
+               p->LockedResources.begin();
+             l != p->LockedResources.end(); ++l) {
+          locked = locked || locks.count(*l) > 0;
+        }
+        if (locked) {
+          continue;
+        }
+        locks.insert(p->LockedResources.begin(), p->LockedResources.end());
+        numToStart -= this->Processors(*t);
+        started.insert(*t);
+        running[*t] = now + p->Cost;
+      }
+      if (running.empty()) {
+        return -1;
+      }
+
+      // Advance to the next test finishing.
+      std::map<int, float>::iterator next = running.begin();
+      for (std::map<int, float>::iterator r = running.begin();
+           r != running.end(); ++r) {
+        if (r->second < next->second) {
+          next = r;
+        }
+      }
+      now = next->second;
+      for (TestMap::iterator w = waiting.begin(); w != waiting.end(); ++w) {
+        w->second.erase(next->first);
+      }
+      running.erase(next);
+    }
+    return now;
+  }
+
+private:
+  size_t Processors(int index)
+  {
+    size_t processors = this->Properties[index]->Processors;
+    return processors > this->ParallelLevel ? this->ParallelLevel
+                                            : processors;
+  }
+};
+
+// Independent tests a1..a4 that each start a short test b1..b4, and one
+// long test that nothing depends on.  The default order starts every
+// test with dependents before the long test.
+static void AddHiddenLongTest(SchedulingSimulator& sim)
+{
+  for (int i = 1; i <= 4; ++i) {
+    sim.AddTest(i, 10);
+    sim.AddTest(10 + i, 1);
+    sim.AddDepends(10 + i, i);
+  }
+  sim.AddTest(100, 100);
+}
+
+// A long test needing two processors and a resource lock shared with
+// the short tests started by other tests.
+static void AddLockedWideTest(SchedulingSimulator& sim)
+{
+  sim.AddTest(100, 60, 2, "db");
+  for (int i = 1; i <= 6; ++i) {
+    sim.AddTest(i, 10);
+    sim.AddTest(10 + i, 5, 1, "db");
+    sim.AddDepends(10 + i, i);
+  }
+}
+
+static unsigned int NextRandom(unsigned int& state)
+{
+  state = state * 1103515245u + 12345u;
+  return state >> 16;
+}
+
+// A pseudo-random suite of mostly short tests with a few long ones,
+// some of them needing two processors or a shared resource lock, and
+// about a third depending on one of the tests just before them.
+static void AddRandomSuite(SchedulingSimulator& sim, unsigned int seed)
+{
+  unsigned int state = seed;
+  for (int i = 1; i <= 60; ++i) {
+    float cost;
+    if (NextRandom(state) % 8 == 0) {
+      cost = static_cast<float>(20 + NextRandom(state) % 100);
+    } else {
+      cost = static_cast<float>(1 + NextRandom(state) % 10);
+    }
+    int processors = NextRandom(state) % 6 == 0 ? 2 : 1;
+    const char* lock = NextRandom(state) % 10 == 0 ? "db" : CM_NULLPTR;
+    sim.AddTest(i, cost, processors, lock);
+    if (i > 1 && NextRandom(state) % 3 == 0) {
+      int range = i - 1 < 3 ? i - 1 : 3;
+      sim.AddDepends(i, i - 1 - static_cast<int>(NextRandom(state) % range));
+    }
+  }
+}
+
+static bool Compare(const char* name, void (*add)(SchedulingSimulator&),
+                    size_t parallel, float expectBefore, float expectAfter)
+{
+  SchedulingSimulator before(parallel, false);
+  add(before);
+  SchedulingSimulator after(parallel, true);
+  add(after);
+  float b = before.Simulate();
+  float a = after.Simulate();
+  std::cout << name << ": default order " << b << ", critical path " << a
+            << "\n";
+  return b == expectBefore && a == expectAfter;
+}
+
+int testCTestScheduling(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  if (Compare("hidden long test", AddHiddenLongTest, 2, 120, 100)) {
+    cmPassed("Critical path starts a long independent test first");
+  } else {
+    cmFailed("Critical path starts a long independent test first");
+  }
+
+  if (Compare("locked wide test", AddLockedWideTest, 4, 100, 90)) {
+    cmPassed("Critical path honors PROCESSORS and RESOURCE_LOCK");
+  } else {
+    cmFailed("Critical path honors PROCESSORS and RESOURCE_LOCK");
+  }
+
+  // Greedy list scheduling has anomalies so single suites may come out
+  // slightly worse, but over many suites the total must improve.
+  float totalBefore = 0;
+  float totalAfter = 0;
+  bool valid = true;
+  for (unsigned int seed = 1; seed <= 100; ++seed) {
+    SchedulingSimulator before(8, false);
+    AddRandomSuite(before, seed);
+    SchedulingSimulator after(8, true);
+    AddRandomSuite(after, seed);
+    float b = before.Simulate();
+    float a = after.Simulate();
+    valid = valid && a > 0 && b > 0;
+    totalBefore += b;
+    totalAfter += a;
+  }
+  std::cout << "random suites: default order " << totalBefore
+            << ", critical path " << totalAfter << "\n";
+  if (valid && totalAfter < totalBefore) {
+    cmPassed("Critical path shortens random test suites");
+  } else {
+    cmFailed("Critical path shortens random test suites");
+  }
+
+  return failed;
+}
@@ -0,0 +1,120 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmMakefile.h"
+#include "cmPolicies.h"
+#include "cmStateSnapshot.h"
+#include "cmStateTypes.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+// Expand the arguments with the full parser the way ExpandArguments does
+// without tokens.
+static void ExpandParsed(cmMakefile& mf,
+                         std::vector<cmListFileArgument> const& args,
+                         std::vector<std::string>& out)
+{
+  for (std::vector<cmListFileArgument>::const_iterator i = args.begin();
+       i != args.end(); ++i) {
+    std::string value = i->Value;
+    mf.ExpandVariablesInString(value, false, false, false, "test", i->Line,
+                               false, false);
+    if (i->Delim == cmListFileArgument::Quoted) {
+      out.push_back(value);
+    } else {
+      cmSystemTools::ExpandListArgument(value, out);
+    }
+  }
+}
+
+static void AddArgument(std::vector<cmListFileArgument>& args,
+                        const char* value)
+{
+  args.push_back(cmListFileArgument(value, cmListFileArgument::Quoted, 1));
+  args.push_back(cmListFileArgument(value, cmListFileArgument::Unquoted, 1));
+}
+
+int testExpandArguments(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  std::string cwd = cmSystemTools::GetCurrentWorkingDirectory();
+  cmake cm;
+  cm.SetHomeDirectory(cwd);
+  cm.SetHomeOutputDirectory(cwd);
+  cmGlobalGenerator* gg = new cmGlobalGenerator(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmStateSnapshot snapshot = cm.GetCurrentSnapshot();
+  snapshot.GetDirectory().SetCurrentBinary(cwd);
+  snapshot.GetDirectory().SetCurrentSource(cwd);
+  snapshot.SetDefaultDefinitions();
+  CM_AUTO_PTR<cmMakefile> mf(new cmMakefile(gg, snapshot));
+  mf->SetPolicy(cmPolicies::CMP0053, cmPolicies::NEW);
+
+  mf->AddDefinition("one", "1");
+  mf->AddDefinition("list", "a;b;c");
+  mf->AddDefinition("a.b/c+d-e", "name");
+  mf->AddDefinition("var_1", "nested");
+  mf->AddDefinition("brace", "}${one}");
+  cm.AddCacheEntry("cached", "c", "doc", cmStateEnums::STRING);
+  cmSystemTools::PutEnv("TEST_EXPAND_ARGUMENTS=e");
+
+  std::vector<cmListFileArgument> args;
+  AddArgument(args, "");
+  AddArgument(args, "plain");
+  AddArgument(args, "${one}");
+  AddArgument(args, "a${one}b${undefined}c${}");
+  AddArgument(args, "${list};x\\;y");
+  AddArgument(args, "\\t\\n\\r\\$\\{one\\}\\ \\\\\\\"");
+  AddArgument(args, "$ENV{TEST_EXPAND_ARGUMENTS}$ENV{}");
+  AddArgument(args, "$CACHE{cached}$CACHE{undefined}");
+  AddArgument(args, "$<CONFIG>$ ${brace} } { @one@ $");
+  AddArgument(args, "${a.b/c+d-e}${line\nbreak}${a$b}");
+  AddArgument(args, "${var_${one}}");
+  AddArgument(args, "${CMAKE_CURRENT_LIST_LINE}");
+
+  std::vector<std::string> expected;
+  ExpandParsed(*mf, args, expected);
+
+  // The first expansion parses, the second tokenizes and the third one
+  // uses the tokens.
+  bool same = true;
+  for (int pass = 0; pass < 3; ++pass) {
+    std::vector<std::string> out;
+    mf->ExpandArguments(args, out, "test");
+    if (out != expected) {
+      same = false;
+      for (size_t i = 0; i < out.size() && i < expected.size(); ++i) {
+        if (out[i] != expected[i]) {
+          std::cout << "pass " << pass << ": '" << out[i] << "' != '"
+                    << expected[i] << "'\n";
+        }
+      }
+    }
+  }
+  if (same && !cmSystemTools::GetErrorOccuredFlag()) {
+    cmPassed("Tokenized arguments expand like parsed arguments");
+  } else {
+    cmFailed("Tokenized arguments expand like parsed arguments");
+  }
+
+  if (args[4].State == cmListFileArgument::Tokenized &&
+      args[20].State == cmListFileArgument::Untokenizable &&
+      args[22].State == cmListFileArgument::Untokenizable) {
+    cmPassed("Arguments are tokenized unless they need the parser");
+  } else {
+    cmFailed("Arguments are tokenized unless they need the parser");
+  }
+
+  return failed;
+}
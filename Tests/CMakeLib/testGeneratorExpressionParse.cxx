@@ -0,0 +1,59 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmGeneratorExpression.h"
+
+#include <cm_auto_ptr.hxx>
+#include <iostream>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+// Compile the text the given number of times and count the parses.
+static unsigned long CountParsed(cmGeneratorExpression& ge, const char* text,
+                                 int count)
+{
+  unsigned long before;
+  unsigned long shared;
+  unsigned long plain;
+  cmGeneratorExpression::GetCompileStatistics(before, shared, plain);
+  for (int i = 0; i < count; ++i) {
+    CM_AUTO_PTR<cmCompiledGeneratorExpression> cge = ge.Parse(text);
+    if (cge->GetInput() != text) {
+      return 0;
+    }
+  }
+  unsigned long after;
+  cmGeneratorExpression::GetCompileStatistics(after, shared, plain);
+  return after - before;
+}
+
+int testGeneratorExpressionParse(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+  cmGeneratorExpression ge;
+
+  if (CountParsed(ge, "$<1:unused>", 3) == 1) {
+    cmPassed("Expressions share the parse of the same text");
+  } else {
+    cmFailed("Expressions share the parse of the same text");
+  }
+
+  CM_AUTO_PTR<cmCompiledGeneratorExpression> kept = ge.Parse("$<1:kept>");
+  cmGeneratorExpression::ReleaseUnusedParses();
+
+  if (CountParsed(ge, "$<1:unused>", 1) == 1) {
+    cmPassed("Unused parses are released");
+  } else {
+    cmFailed("Unused parses are released");
+  }
+
+  if (CountParsed(ge, "$<1:kept>", 1) == 0) {
+    cmPassed("Parses in use are kept");
+  } else {
+    cmFailed("Parses in use are kept");
+  }
+
+  return failed;
+}
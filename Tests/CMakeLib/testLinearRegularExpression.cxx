@@ -0,0 +1,167 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmLinearRegularExpression.h"
+
+#include <cmsys/RegularExpression.hxx>
+#include <iostream>
+#include <string>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+static unsigned int Seed = 1;
+
+static unsigned int Random(unsigned int n)
+{
+  Seed = Seed * 1103515245u + 12345u;
+  return (Seed >> 16) % n;
+}
+
+static std::string RandomString(const char* alphabet, unsigned int maxLen)
+{
+  std::string const chars = alphabet;
+  std::string s;
+  for (unsigned int len = Random(maxLen + 1); len > 0; --len) {
+    s += chars[Random(static_cast<unsigned int>(chars.size()))];
+  }
+  return s;
+}
+
+// Compare the results of both matchers for a pattern and an input.
+static bool Compare(const char* pattern, const char* input)
+{
+  cmsys::RegularExpression expected;
+  cmLinearRegularExpression actual;
+  bool const valid = expected.compile(pattern);
+  if (actual.compile(pattern) != valid) {
+    std::cout << "'" << pattern << "' valid: " << !valid << "\n";
+    return false;
+  }
+  if (!valid) {
+    return true;
+  }
+  bool const found = expected.find(input);
+  if (actual.find(input) != found) {
+    std::cout << "'" << pattern << "' finds '" << input << "': " << !found
+              << "\n";
+    return false;
+  }
+  if (!found) {
+    return true;
+  }
+  if (actual.start() != expected.start() || actual.end() != expected.end()) {
+    std::cout << "'" << pattern << "' finds '" << input << "' at "
+              << actual.start() << "-" << actual.end() << " instead of "
+              << expected.start() << "-" << expected.end() << "\n";
+    return false;
+  }
+  for (int i = 1; i < cmLinearRegularExpression::NSUBEXP; ++i) {
+    if (actual.match(i) != expected.match(i)) {
+      std::cout << "'" << pattern << "' finds '" << input << "' with \\" << i
+                << " '" << actual.match(i) << "' instead of '"
+                << expected.match(i) << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+int testLinearRegularExpression(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  // Patterns like those ctest scrapes build logs with.
+  static const char* patterns[] = {
+    "^[Bb]us [Ee]rror",
+    "([^ :]+):([0-9]+): ([^ \\t])",
+    "[^ :]:[0-9]+: [^ \\t]",
+    "^Error ([0-9]+):",
+    "^\"[^\"]+\", line [0-9]+: [^Ww]",
+    ": error[ \\t]*[0-9]+[ \\t]*:",
+    "^.*\\(([0-9]+)\\) ?: (Fatal|Catastrophic) error",
+    "([^:]+): ([^ \\t]+):([0-9]+):([^ \\t])",
+    "[Ww]arning",
+    "(^|[ :])[Ww][Aa][Rr][Nn][Ii][Nn][Gg]",
+    "^make\\[[0-9]+\\]: \\*\\*\\*",
+    "x*$",
+    "a|b|",
+    "(a|ab)(c|bcd)(d*)",
+    "((a)|b)+",
+    "(a*)+",
+    "(a?)*b",
+    "([]a-]+)",
+    "[^]x]",
+    "[z-a]",
+    "(((((((((a)))))))))",
+    "((((((((((a))))))))))",
+    "a**",
+    "\\",
+    "ab(",
+    "ab)",
+    "[ab",
+    "",
+    "^*",
+    "$?",
+    CM_NULLPTR
+  };
+  static const char* inputs[] = {
+    "",
+    "a",
+    "ab",
+    "abcd",
+    "xxbaab",
+    "Bus error",
+    "foo.c:12: warning: unused variable",
+    "/path/to/foo.c:12:7: error: expected ';'",
+    "make[2]: *** [foo.o] Error 1",
+    "\"foo.c\", line 3: syntax",
+    "file.c(42) : Fatal error C1083",
+    "]]-a-",
+    CM_NULLPTR
+  };
+  bool same = true;
+  for (const char** p = patterns; *p; ++p) {
+    for (const char** i = inputs; *i; ++i) {
+      same = Compare(*p, *i) && same;
+    }
+  }
+  if (same) {
+    cmPassed("Matches are the same as with the backtracking matcher");
+  } else {
+    cmFailed("Matches are the same as with the backtracking matcher");
+  }
+
+  // Compare many random patterns.  Invalid ones are left to the list
+  // above because the backtracking matcher prints an error for each.
+  same = true;
+  for (int n = 0; n < 50000; ++n) {
+    std::string pattern = RandomString("ab.()|*+?^$[]-\\", 10);
+    std::string input = RandomString("ab-]", 8);
+    if (cmLinearRegularExpression().compile(pattern)) {
+      same = Compare(pattern.c_str(), input.c_str()) && same;
+    }
+  }
+  if (same) {
+    cmPassed("Random patterns match as with the backtracking matcher");
+  } else {
+    cmFailed("Random patterns match as with the backtracking matcher");
+  }
+
+  // A pattern that makes the backtracking matcher take exponential time
+  // in the number of repetitions.
+  std::string input(24, 'a');
+  input += "cb";
+  cmsys::RegularExpression backtracking("(a|aa)*b");
+  cmLinearRegularExpression linear("(a|aa)*b");
+  bool backtrackingFound = backtracking.find(input);
+  bool linearFound = linear.find(input);
+  if (linearFound && backtrackingFound && linear.start() == input.size() - 1) {
+    cmPassed("Pathological pattern matches");
+  } else {
+    cmFailed("Pathological pattern matches");
+  }
+
+  return failed;
+}
@@ -0,0 +1,124 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmLinearRegularExpression.h"
+#include "cmLinearRegularExpressionSet.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+static unsigned int Seed = 1;
+
+static unsigned int Random(unsigned int n)
+{
+  Seed = Seed * 1103515245u + 12345u;
+  return (Seed >> 16) % n;
+}
+
+static std::string RandomString(const char* alphabet, unsigned int maxLen)
+{
+  std::string const chars = alphabet;
+  std::string s;
+  for (unsigned int len = Random(maxLen + 1); len > 0; --len) {
+    s += chars[Random(static_cast<unsigned int>(chars.size()))];
+  }
+  return s;
+}
+
+// Compare the patterns the set finds with those found one at a time.
+static bool Compare(cmLinearRegularExpressionSet& set,
+                    std::vector<std::string> const& patterns,
+                    const char* input)
+{
+  bool const any = set.Find(input);
+  bool same = true;
+  bool found = false;
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    cmLinearRegularExpression regex(patterns[i]);
+    bool const expected = regex.is_valid() && regex.find(input);
+    if (set.Matched(i) != expected) {
+      std::cout << "'" << patterns[i] << "' finds '" << input
+                << "': " << set.Matched(i) << "\n";
+      same = false;
+    }
+    found = found || expected;
+  }
+  if (any != found) {
+    std::cout << "Set finds '" << input << "': " << any << "\n";
+    same = false;
+  }
+  return same;
+}
+
+int testLinearRegularExpressionSet(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  static const char* patterns[] = { "([^ :]+):([0-9]+): warning:",
+                                    "^ld([^:])*:([ \\t])*ERROR([^:])*:",
+                                    "^\\[WARNING\\]",
+                                    "^(Warning|Warnung)[ :]",
+                                    "make\\[.*\\]: \\*\\*\\*.*Error",
+                                    "[z-a]",
+                                    "^$",
+                                    "x*$",
+                                    "^",
+                                    "ab|^c|d$",
+                                    CM_NULLPTR };
+  static const char* inputs[] = { "",
+                                  "foo.c:12: warning: unused variable",
+                                  "ld: ERROR 33: something",
+                                  "[WARNING] x",
+                                  " [WARNING] x",
+                                  "Warnung: a",
+                                  "make[2]: *** [foo.o] Error 1",
+                                  "cab",
+                                  "xd",
+                                  CM_NULLPTR };
+  cmLinearRegularExpressionSet set;
+  std::vector<std::string> strings;
+  for (const char** p = patterns; *p; ++p) {
+    set.Add(*p);
+    strings.push_back(*p);
+  }
+  bool same = true;
+  for (const char** i = inputs; *i; ++i) {
+    same = Compare(set, strings, *i) && same;
+  }
+  if (same && set.FirstMatch(0, 5) == 5 && set.FirstMatch(5, 10) == 7) {
+    cmPassed("Set matches like each pattern on its own");
+  } else {
+    cmFailed("Set matches like each pattern on its own");
+  }
+
+  // Random sets of random patterns with random inputs.  Use many inputs
+  // for each set so that the states are built up over several of them.
+  same = true;
+  for (int n = 0; n < 300; ++n) {
+    set.Clear();
+    strings.clear();
+    for (unsigned int count = Random(8) + 1; count > 0; --count) {
+      std::string pattern = RandomString("ab.()|*+?^$[]-", 8);
+      if (cmLinearRegularExpression().compile(pattern)) {
+        set.Add(pattern);
+        strings.push_back(pattern);
+      }
+    }
+    for (int m = 0; m < 30; ++m) {
+      std::string input = RandomString("ab-]", 8);
+      same = Compare(set, strings, input.c_str()) && same;
+    }
+  }
+  if (same) {
+    cmPassed("Random sets match like each pattern on its own");
+  } else {
+    cmFailed("Random sets match like each pattern on its own");
+  }
+
+  return failed;
+}
@@ -0,0 +1,55 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmRegularExpressionCache.h"
+
+#include <cmsys/RegularExpression.hxx>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+int testRegularExpressionCache(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  unsigned long const hits = cmRegularExpressionCache::GetHits();
+  cmsys::RegularExpression* re = cmRegularExpressionCache::Get("^a(b+)c$");
+  if (re && re->find("abbc") && re->match(1) == "bb" &&
+      cmRegularExpressionCache::Get("^a(b+)c$") == re &&
+      cmRegularExpressionCache::GetHits() == hits + 1) {
+    cmPassed("Patterns compile once");
+  } else {
+    cmFailed("Patterns compile once");
+  }
+
+  if (!cmRegularExpressionCache::Get("a(b")) {
+    cmPassed("Invalid patterns are not compiled");
+  } else {
+    cmFailed("Invalid patterns are not compiled");
+  }
+
+  // Use enough other patterns to evict the first one.
+  bool matched = true;
+  for (int i = 0; i < 1000; ++i) {
+    std::ostringstream pattern;
+    pattern << "^x" << i << "(y*)$";
+    std::ostringstream input;
+    input << "x" << i << "yy";
+    re = cmRegularExpressionCache::Get(pattern.str());
+    if (!re || !re->find(input.str()) || re->match(1) != "yy") {
+      matched = false;
+    }
+  }
+  re = cmRegularExpressionCache::Get("^a(b+)c$");
+  if (matched && re && re->find("abc") && !re->find("ac")) {
+    cmPassed("Evicted patterns compile again");
+  } else {
+    cmFailed("Evicted patterns compile again");
+  }
+
+  return failed;
+}
@@ -0,0 +1,5 @@
+#include "MakeDependsCompiler.h"
+int main(void)
+{
+  return RESULT;
+}
@@ -0,0 +1,15 @@
+set(depend_make CMakeFiles/first.dir/depend.make)
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files
+  "${RunCMake_BINARY_DIR}/MakeIncludeCache-serial-build/${depend_make}"
+  "${RunCMake_TEST_BINARY_DIR}/${depend_make}"
+  RESULT_VARIABLE result)
+if(result)
+  set(RunCMake_TEST_FAILED
+    "The parallel scan wrote another ${depend_make} than the serial scan.")
+endif()
+find_include_cache_entry(entry shared.h)
+list(LENGTH entry count)
+if(NOT count EQUAL 1)
+  string(APPEND RunCMake_TEST_FAILED
+    "\nExpected one include cache entry for shared.h but found ${count}.")
+endif()
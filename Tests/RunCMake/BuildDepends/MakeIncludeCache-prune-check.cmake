@@ -0,0 +1,13 @@
+find_include_cache_entry(entry shared.h)
+if(entry)
+  set(RunCMake_TEST_FAILED "The include cache entry for shared.h was kept.")
+endif()
+find_include_cache_entry(entry nested.h)
+if(NOT entry)
+  string(APPEND RunCMake_TEST_FAILED
+    "\nThe include cache entry for nested.h was dropped.")
+endif()
+if(EXISTS "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/IncludeCache/0.tmp")
+  string(APPEND RunCMake_TEST_FAILED
+    "\nThe include cache file 0.tmp was kept.")
+endif()
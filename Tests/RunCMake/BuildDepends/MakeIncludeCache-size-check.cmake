@@ -0,0 +1,7 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/second.dir/depend.make"
+  depend_make)
+if(NOT depend_make MATCHES "include/nested[.]h" OR
+    depend_make MATCHES "include/extra[.]h")
+  set(RunCMake_TEST_FAILED
+    "second depends on extra.h instead of nested.h:\n${depend_make}")
+endif()
@@ -0,0 +1,9 @@
+enable_language(C)
+include_directories(${CMAKE_BINARY_DIR}/include)
+add_library(first STATIC
+  ${CMAKE_BINARY_DIR}/src/first1.c
+  ${CMAKE_BINARY_DIR}/src/first2.c
+  ${CMAKE_BINARY_DIR}/src/first3.c
+  ${CMAKE_BINARY_DIR}/src/first4.c
+  )
+add_library(second STATIC ${CMAKE_BINARY_DIR}/src/second.c)
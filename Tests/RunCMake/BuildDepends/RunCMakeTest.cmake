@@ -48,6 +48,109 @@ if(RunCMake_GENERATOR MATCHES "Make" AND
   run_BuildDepends(MakeInProjectOnly)
 endif()
 
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_BuildDepends(MakeDependsCompiler)
+endif()
+
+# Find the entry of the shared include line cache naming a header.  The
+# scanner names headers found in the include path relative to the build tree.
+function(find_include_cache_entry var header)
+  set(entry "")
+  file(GLOB files "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/IncludeCache/*")
+  foreach(f IN LISTS files)
+    file(STRINGS "${f}" name LIMIT_COUNT 1)
+    if(name MATCHES "(^|/)include/${header}$")
+      list(APPEND entry "${f}")
+    endif()
+  endforeach()
+  set(${var} "${entry}" PARENT_SCOPE)
+endfunction()
+
+# Make the entry for shared.h list extra.h instead of what shared.h
+# includes, giving it the size of shared.h plus the given offset.
+function(fake_include_cache_entry offset)
+  find_include_cache_entry(entry shared.h)
+  file(STRINGS "${entry}" lines LIMIT_COUNT 2)
+  list(GET lines 0 name)
+  list(GET lines 1 size)
+  math(EXPR size "${size} + ${offset}")
+  file(WRITE "${entry}" "${name}\n${size}\nextra.h\n-\n\n")
+endfunction()
+
+# Make the next build scan the objects of the second target again without
+# the include lines it cached for itself.
+function(rescan_include_cache_second)
+  file(REMOVE
+    "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/second.dir/depend.internal"
+    "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/second.dir/C.includecache"
+    )
+endfunction()
+
+function(write_include_cache_sources)
+  foreach(i 1 2 3 4)
+    file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/first${i}.h" "\n")
+    file(WRITE "${RunCMake_TEST_BINARY_DIR}/src/first${i}.c"
+      "#include \"shared.h\"\n#include \"first${i}.h\"\n")
+  endforeach()
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/src/second.c"
+    "#include \"shared.h\"\n")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/shared.h"
+    "#include \"nested.h\"\n")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/nested.h" "\n")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/extra.h" "\n")
+endfunction()
+
+function(run_MakeIncludeCache)
+  set(RunCMake_TEST_NO_CLEAN 1)
+
+  # Scan the objects of a target one at a time for reference.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/MakeIncludeCache-serial-build)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  write_include_cache_sources()
+  set(ENV{CMAKE_DEPENDS_SCAN_THREADS} 1)
+  run_cmake(MakeIncludeCache)
+  run_cmake_command(MakeIncludeCache-serial ${CMAKE_COMMAND} --build . --target first)
+
+  # Scanning them on several threads must find the same dependencies.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/MakeIncludeCache-build)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  write_include_cache_sources()
+  set(ENV{CMAKE_DEPENDS_SCAN_THREADS} 4)
+  run_cmake(MakeIncludeCache)
+  run_cmake_command(MakeIncludeCache-parallel ${CMAKE_COMMAND} --build . --target first)
+  unset(ENV{CMAKE_DEPENDS_SCAN_THREADS})
+
+  # Another target reads the include lines of shared.h from the entry
+  # written for the first one.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay}) # handle 1s resolution
+  fake_include_cache_entry(0)
+  run_cmake_command(MakeIncludeCache-reuse ${CMAKE_COMMAND} --build . --target second)
+
+  # The entry no longer matches shared.h once its size changes.
+  fake_include_cache_entry(1)
+  rescan_include_cache_second()
+  run_cmake_command(MakeIncludeCache-size ${CMAKE_COMMAND} --build . --target second)
+
+  # The entry no longer matches shared.h once it is modified.
+  fake_include_cache_entry(0)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay}) # handle 1s resolution
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/shared.h"
+    "#include \"nested.h\"\n")
+  rescan_include_cache_second()
+  run_cmake_command(MakeIncludeCache-mtime ${CMAKE_COMMAND} --build . --target second)
+
+  # Generating the build system again drops the entries of headers that
+  # changed since they were scanned and entries never moved into place.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/include/shared.h"
+    "#include \"nested.h\"\n#include \"extra.h\"\n")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/IncludeCache/0.tmp" "")
+  run_cmake_command(MakeIncludeCache-prune ${CMAKE_COMMAND} .)
+endfunction()
+
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_MakeIncludeCache()
+endif()
+
 function(run_ReGeneration)
   # test re-generation of project even if CMakeLists.txt files disappeared
 
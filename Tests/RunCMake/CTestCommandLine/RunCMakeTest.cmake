@@ -140,3 +140,36 @@ function(run_TestOutputSize)
     )
 endfunction()
 run_TestOutputSize()
+
+function(run_StopTime)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/StopTime)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(First \"${CMAKE_COMMAND}\" -E sleep 20)
+add_test(Second \"${CMAKE_COMMAND}\" -E sleep 20)
+add_test(Later \"${CMAKE_COMMAND}\" -E echo Later)
+")
+
+  # Stop a few seconds from now.  The stop time caps the timeouts of both
+  # tests running then, and the one that does not time out first must be
+  # stopped too.
+  string(TIMESTAMP start "%s")
+  string(TIMESTAMP now "%H:%M:%S")
+  string(REPLACE ":" ";" now "${now}")
+  list(GET now 0 h)
+  list(GET now 1 m)
+  list(GET now 2 s)
+  math(EXPR stop "(${h} * 3600 + ${m} * 60 + ${s} + 3) % 86400")
+  math(EXPR h "${stop} / 3600")
+  math(EXPR m "${stop} / 60 % 60")
+  math(EXPR s "${stop} % 60")
+  foreach(v h m s)
+    if(${v} LESS 10)
+      set(${v} "0${${v}}")
+    endif()
+  endforeach()
+  run_cmake_command(StopTime ${CMAKE_CTEST_COMMAND} -j2 --stop-time ${h}:${m}:${s})
+endfunction()
+run_StopTime()
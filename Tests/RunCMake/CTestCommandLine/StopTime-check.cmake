@@ -0,0 +1,13 @@
+# Tests still running when the stop time has passed are stopped rather
+# than waited for, and are not reported.
+string(TIMESTAMP end "%s")
+math(EXPR elapsed "${end} - ${start}")
+string(REGEX MATCHALL "Test +#[0-9]+: [^\n]*" reported "${actual_stdout}")
+list(LENGTH reported reported_count)
+if(elapsed GREATER 15)
+  set(RunCMake_TEST_FAILED "ctest took ${elapsed} seconds to stop.")
+elseif(NOT reported_count EQUAL 1)
+  set(RunCMake_TEST_FAILED "Expected one test reported, got:\n${reported}")
+elseif(NOT reported MATCHES "Timeout")
+  set(RunCMake_TEST_FAILED "The test did not time out at the stop time.")
+endif()
@@ -0,0 +1,46 @@
+enable_language(C)
+enable_language(CXX)
+include(CheckBatch)
+include(CheckCSourceCompiles)
+include(CheckCXXSourceCompiles)
+include(CheckFunctionExists)
+include(CheckIncludeFile)
+include(CheckIncludeFileCXX)
+include(CheckIncludeFiles)
+include(CheckSymbolExists)
+include(CheckCXXSymbolExists)
+
+macro(run_checks prefix)
+  check_c_source_compiles("int main(void) { return 0; }" ${prefix}_C_OK)
+  check_c_source_compiles("int main(void) { return undeclared; }" ${prefix}_C_BAD)
+  check_c_source_compiles("int main(void) { return 0; }" ${prefix}_C_REGEX
+    FAIL_REGEX ".")
+  check_cxx_source_compiles("int main() { return 0; }" ${prefix}_CXX_OK)
+  check_function_exists(printf ${prefix}_PRINTF)
+  check_function_exists(no_such_function_xyz ${prefix}_NO_FUNCTION)
+  check_include_file(stdio.h ${prefix}_STDIO_H)
+  check_include_file(no_such_header_xyz.h ${prefix}_NO_HEADER)
+  check_include_file_cxx(cstdio ${prefix}_CSTDIO)
+  check_include_files("stdio.h;stdlib.h" ${prefix}_STDIO_STDLIB_H)
+  check_symbol_exists(printf stdio.h ${prefix}_PRINTF_SYMBOL)
+  check_cxx_symbol_exists(printf cstdio ${prefix}_PRINTF_CXX_SYMBOL)
+endmacro()
+
+run_checks(SERIAL)
+check_batch_begin()
+run_checks(BATCH)
+if(DEFINED BATCH_STDIO_H)
+  message(SEND_ERROR "BATCH_STDIO_H defined before check_batch_end()")
+endif()
+check_batch_end(PARALLEL_LEVEL 4)
+
+foreach(check C_OK C_BAD C_REGEX CXX_OK PRINTF NO_FUNCTION STDIO_H NO_HEADER
+    CSTDIO STDIO_STDLIB_H PRINTF_SYMBOL PRINTF_CXX_SYMBOL)
+  if(NOT "${SERIAL_${check}}" STREQUAL "${BATCH_${check}}")
+    message(SEND_ERROR "Check ${check} gave \"${SERIAL_${check}}\" serially "
+      "but \"${BATCH_${check}}\" in a batch.")
+  endif()
+endforeach()
+if(NOT BATCH_STDIO_H OR BATCH_NO_HEADER)
+  message(SEND_ERROR "Batched include checks gave wrong results.")
+endif()
@@ -0,0 +1,31 @@
+enable_language(C)
+include(CheckBatch)
+include(CheckIncludeFile)
+
+# Fill a try_compile cache with the first batch so that the same check
+# is found there in the second batch without deferring its build.
+set(CMAKE_TRY_COMPILE_CACHE_DIR ${CMAKE_CURRENT_BINARY_DIR}/tc-cache)
+check_batch_begin()
+check_include_file(stdio.h STALE_1)
+check_batch_end()
+check_batch_begin()
+check_include_file(stdio.h STALE_2)
+check_batch_end()
+unset(CMAKE_TRY_COMPILE_CACHE_DIR)
+
+# The deferred check of the third batch must not take the output left
+# by the second one for its own.
+check_batch_begin()
+check_include_file(stdlib.h STALE_3)
+check_batch_end()
+
+set(log ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log)
+if(EXISTS ${log})
+  file(READ ${log} log)
+endif()
+if(log MATCHES "stdlib.h exists failed")
+  message(SEND_ERROR "Deferred check reported a result before building.")
+endif()
+if(NOT STALE_1 OR NOT STALE_2 OR NOT STALE_3)
+  message(SEND_ERROR "Checks in consecutive batches gave wrong results.")
+endif()
@@ -14,3 +14,6 @@ run_cmake(CheckTypeSizeUnknownArgument)
 run_cmake(CheckTypeSizeMixedArgs)
 
 run_cmake(CheckTypeSizeOkNoC)
+
+run_cmake(CheckBatch)
+run_cmake(CheckBatchStale)
@@ -0,0 +1,15 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(STRINGS "${ProfilingTestOutput}" counters
+  REGEX "\"generator expressions\"")
+if(NOT counters MATCHES "\"ph\":\"C\"")
+  set(RunCMake_TEST_FAILED "No generator expressions counter in profile")
+elseif(NOT counters MATCHES "\"parsed\":[1-9]" OR
+       NOT counters MATCHES "\"shared\":[1-9]" OR
+       NOT counters MATCHES "\"plain\":[1-9]")
+  set(RunCMake_TEST_FAILED
+    "Unexpected generator expressions counter:\n${counters}")
+endif()
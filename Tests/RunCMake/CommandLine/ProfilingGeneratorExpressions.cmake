@@ -0,0 +1,4 @@
+foreach(n 1 2 3)
+  add_custom_target(ProfilingGeneratorExpressions${n}
+    COMMAND ${CMAKE_COMMAND} -E echo $<$<CONFIG:Debug>:debug>)
+endforeach()
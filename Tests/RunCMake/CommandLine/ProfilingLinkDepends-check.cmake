@@ -0,0 +1,14 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(STRINGS "${ProfilingTestOutput}" counters
+  REGEX "\"link dependencies\"")
+if(NOT counters MATCHES "\"ph\":\"C\"")
+  set(RunCMake_TEST_FAILED "No link dependencies counter in profile")
+elseif(NOT counters MATCHES "\"computed\":2[,}]" OR
+       NOT counters MATCHES "\"shared\":2[,}]")
+  set(RunCMake_TEST_FAILED
+    "Unexpected link dependencies counter:\n${counters}")
+endif()
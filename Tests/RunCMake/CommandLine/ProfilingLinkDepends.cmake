@@ -0,0 +1,7 @@
+enable_language(C)
+file(WRITE ${CMAKE_CURRENT_BINARY_DIR}/empty.c "int main(void) { return 0; }\n")
+add_library(ProfilingLinkDependsLib STATIC ${CMAKE_CURRENT_BINARY_DIR}/empty.c)
+foreach(n 1 2 3)
+  add_executable(ProfilingLinkDepends${n} ${CMAKE_CURRENT_BINARY_DIR}/empty.c)
+  target_link_libraries(ProfilingLinkDepends${n} ProfilingLinkDependsLib)
+endforeach()
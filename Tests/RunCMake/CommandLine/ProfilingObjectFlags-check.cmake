@@ -0,0 +1,12 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(STRINGS "${ProfilingTestOutput}" counters REGEX "\"object flags\"")
+if(NOT counters MATCHES "\"ph\":\"C\"")
+  set(RunCMake_TEST_FAILED "No object flags counter in profile")
+elseif(NOT counters MATCHES "\"shared\":2[,}]" OR
+       NOT counters MATCHES "\"source\":1[,}]")
+  set(RunCMake_TEST_FAILED "Unexpected object flags counter:\n${counters}")
+endif()
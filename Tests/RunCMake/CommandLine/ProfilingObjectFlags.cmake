@@ -0,0 +1,12 @@
+enable_language(C)
+foreach(src shared1.c shared2.c custom.c)
+  file(WRITE ${CMAKE_CURRENT_BINARY_DIR}/${src} "")
+endforeach()
+add_library(ProfilingObjectFlags STATIC
+  ${CMAKE_CURRENT_BINARY_DIR}/shared1.c
+  ${CMAKE_CURRENT_BINARY_DIR}/shared2.c
+  ${CMAKE_CURRENT_BINARY_DIR}/custom.c
+  )
+target_compile_definitions(ProfilingObjectFlags PRIVATE SHARED)
+set_property(SOURCE ${CMAKE_CURRENT_BINARY_DIR}/custom.c
+  PROPERTY COMPILE_DEFINITIONS CUSTOM)
@@ -0,0 +1,14 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(STRINGS "${ProfilingTestOutput}" counters
+  REGEX "\"regular expressions\"")
+if(NOT counters MATCHES "\"ph\":\"C\"")
+  set(RunCMake_TEST_FAILED "No regular expressions counter in profile")
+elseif(NOT counters MATCHES "\"hits\":[1-9][0-9]*[,}]" OR
+       NOT counters MATCHES "\"misses\":[1-9][0-9]*[,}]")
+  set(RunCMake_TEST_FAILED
+    "Unexpected regular expressions counter:\n${counters}")
+endif()
@@ -0,0 +1,3 @@
+foreach(i RANGE 9)
+  string(REGEX MATCH "^Profiling([0-9]+)$" m "Profiling${i}")
+endforeach()
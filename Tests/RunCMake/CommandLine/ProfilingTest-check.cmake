@@ -0,0 +1,55 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(READ "${ProfilingTestOutput}" content)
+if(NOT content MATCHES "^\\[\n(.*)\n\\]\n$")
+  set(RunCMake_TEST_FAILED "Profile is not a JSON array:\n${content}")
+  return()
+endif()
+
+# Split into one event per line.  Brackets and semicolons would
+# confuse list handling, and the events of this test contain neither.
+set(events "${CMAKE_MATCH_1}")
+string(REGEX REPLACE "[][;]" "" events "${events}")
+string(REPLACE "\n" ";" events "${events}")
+
+# Every begin event must be closed by a matching end event.
+set(depth 0)
+set(names "")
+foreach(event IN LISTS events)
+  if(event MATCHES "^{.*\"ph\":\"B\".*},?$")
+    math(EXPR depth "${depth} + 1")
+    if(event MATCHES "\"name\":\"([^\"]*)\"")
+      list(APPEND names "${CMAKE_MATCH_1}")
+    endif()
+  elseif(event MATCHES "^{.*\"ph\":\"E\".*},?$")
+    math(EXPR depth "${depth} - 1")
+    if(depth LESS 0)
+      set(RunCMake_TEST_FAILED "Unmatched end event:\n${event}")
+      return()
+    endif()
+  elseif(event MATCHES "^{.*\"ph\":\"C\".*},?$")
+    # Counters stand on their own.
+  else()
+    set(RunCMake_TEST_FAILED "Malformed event:\n${event}")
+    return()
+  endif()
+endforeach()
+if(NOT depth EQUAL 0)
+  set(RunCMake_TEST_FAILED "${depth} begin events were never ended")
+  return()
+endif()
+
+foreach(name configure compute generate project profiling_function
+    profiling_macro include set)
+  if(NOT ";${names};" MATCHES ";${name};")
+    set(RunCMake_TEST_FAILED "No begin event for \"${name}\" in:\n${names}")
+    return()
+  endif()
+endforeach()
+
+if(NOT content MATCHES "\"location\":\"[^\"]*/ProfilingTest.cmake:7\"")
+  set(RunCMake_TEST_FAILED "No location for the profiling_function call")
+endif()
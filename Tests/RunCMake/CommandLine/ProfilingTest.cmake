@@ -0,0 +1,9 @@
+function(profiling_function)
+  set(x 1)
+endfunction()
+macro(profiling_macro)
+  set(y 1)
+endmacro()
+profiling_function()
+profiling_macro()
+include(${CMAKE_CURRENT_LIST_DIR}/trace-only-this-file.cmake)
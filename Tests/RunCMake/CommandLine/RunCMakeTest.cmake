@@ -272,6 +272,37 @@ set(RunCMake_TEST_OPTIONS --trace-source=trace-only-this-file.cmake)
 run_cmake(trace-source)
 unset(RunCMake_TEST_OPTIONS)
 
+set(ProfilingTestOutput ${RunCMake_BINARY_DIR}/ProfilingTest-build/output.json)
+set(RunCMake_TEST_OPTIONS --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingTest)
+unset(RunCMake_TEST_OPTIONS)
+
+set(ProfilingTestOutput
+  ${RunCMake_BINARY_DIR}/ProfilingGeneratorExpressions-build/output.json)
+set(RunCMake_TEST_OPTIONS --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingGeneratorExpressions)
+unset(RunCMake_TEST_OPTIONS)
+
+set(ProfilingTestOutput
+  ${RunCMake_BINARY_DIR}/ProfilingRegularExpressions-build/output.json)
+set(RunCMake_TEST_OPTIONS --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingRegularExpressions)
+unset(RunCMake_TEST_OPTIONS)
+
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  set(ProfilingTestOutput
+    ${RunCMake_BINARY_DIR}/ProfilingObjectFlags-build/output.json)
+  set(RunCMake_TEST_OPTIONS --profiling-output=${ProfilingTestOutput})
+  run_cmake(ProfilingObjectFlags)
+  unset(RunCMake_TEST_OPTIONS)
+
+  set(ProfilingTestOutput
+    ${RunCMake_BINARY_DIR}/ProfilingLinkDepends-build/output.json)
+  set(RunCMake_TEST_OPTIONS --profiling-output=${ProfilingTestOutput})
+  run_cmake(ProfilingLinkDepends)
+  unset(RunCMake_TEST_OPTIONS)
+endif()
+
 set(RunCMake_TEST_OPTIONS --debug-trycompile)
 run_cmake(debug-trycompile)
 unset(RunCMake_TEST_OPTIONS)
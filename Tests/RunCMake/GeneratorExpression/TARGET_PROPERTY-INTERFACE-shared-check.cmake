@@ -0,0 +1,11 @@
+file(READ ${RunCMake_TEST_BINARY_DIR}/test.txt TEST_TXT)
+
+set(expected "a: Y;X;MID;BASE;HEAD_a
+b: Y;X;MID;BASE;HEAD_b;Z
+c: Z;X;Y
+d: Y;X;Z;MID;BASE;HEAD_d
+")
+
+if(NOT TEST_TXT STREQUAL expected)
+  set(RunCMake_TEST_FAILED "test.txt is\n${TEST_TXT}\nnot\n${expected}")
+endif()
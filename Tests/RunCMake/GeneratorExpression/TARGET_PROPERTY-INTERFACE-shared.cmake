@@ -0,0 +1,35 @@
+enable_language(C)
+
+# Usage requirements that depend on the target reading them.
+add_library(base INTERFACE)
+target_compile_definitions(base INTERFACE BASE $<TARGET_PROPERTY:HEAD_DEF>)
+add_library(mid INTERFACE)
+target_compile_definitions(mid INTERFACE MID)
+target_link_libraries(mid INTERFACE base)
+
+# Usage requirements that are the same for all, some reached twice.
+add_library(x INTERFACE)
+target_compile_definitions(x INTERFACE X)
+add_library(y INTERFACE)
+target_compile_definitions(y INTERFACE Y)
+target_link_libraries(y INTERFACE x)
+add_library(z INTERFACE)
+target_compile_definitions(z INTERFACE Z)
+target_link_libraries(z INTERFACE x y)
+add_library(diamond INTERFACE)
+target_link_libraries(diamond INTERFACE y mid z)
+
+foreach(t a b c d)
+  add_library(${t} STATIC empty.c)
+  set_property(TARGET ${t} PROPERTY HEAD_DEF HEAD_${t})
+endforeach()
+target_link_libraries(a y mid)
+target_link_libraries(b diamond)
+target_link_libraries(c z)
+target_link_libraries(d y z diamond)
+
+file(GENERATE OUTPUT test.txt CONTENT "a: $<TARGET_PROPERTY:a,COMPILE_DEFINITIONS>
+b: $<TARGET_PROPERTY:b,COMPILE_DEFINITIONS>
+c: $<TARGET_PROPERTY:c,COMPILE_DEFINITIONS>
+d: $<TARGET_PROPERTY:d,COMPILE_DEFINITIONS>
+")
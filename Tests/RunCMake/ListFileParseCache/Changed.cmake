@@ -0,0 +1,8 @@
+# Each run writes the file with the same size just before including it.
+set(inc ${CMAKE_CURRENT_BINARY_DIR}/Changed-include.cmake)
+if(NOT EXISTS ${inc})
+  file(WRITE ${inc} "message(STATUS \"Changed run 1\")\n")
+else()
+  file(WRITE ${inc} "message(STATUS \"Changed run 2\")\n")
+endif()
+include(${inc})
@@ -0,0 +1,5 @@
+file(STRINGS ${RunCMake_TEST_BINARY_DIR}/parse.cache paths
+  REGEX "ListFileParseCache/Prune(-include)?[.]cmake")
+if(NOT paths MATCHES "/Prune-include[.]cmake")
+  set(RunCMake_TEST_FAILED "Prune-include.cmake not in the parse cache.")
+endif()
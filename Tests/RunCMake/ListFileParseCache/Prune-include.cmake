@@ -0,0 +1 @@
+message(STATUS "Prune-include")
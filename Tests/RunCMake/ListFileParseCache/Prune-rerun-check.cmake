@@ -0,0 +1,8 @@
+file(STRINGS ${RunCMake_TEST_BINARY_DIR}/parse.cache paths
+  REGEX "ListFileParseCache/Prune(-include)?[.]cmake")
+if(NOT paths MATCHES "/Prune[.]cmake")
+  set(RunCMake_TEST_FAILED "Prune.cmake not in the parse cache.")
+elseif(paths MATCHES "/Prune-include[.]cmake")
+  set(RunCMake_TEST_FAILED
+    "Prune-include.cmake is still in the parse cache but was not read.")
+endif()
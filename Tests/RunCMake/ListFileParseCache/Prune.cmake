@@ -0,0 +1,6 @@
+# Only the first run includes the file.
+set(marker ${CMAKE_CURRENT_BINARY_DIR}/Prune-marker.txt)
+if(NOT EXISTS ${marker})
+  file(WRITE ${marker} "")
+  include(${CMAKE_CURRENT_LIST_DIR}/Prune-include.cmake)
+endif()
@@ -0,0 +1,3 @@
+function(reuse_message)
+  message(STATUS "reuse_message(${ARGV})")
+endfunction()
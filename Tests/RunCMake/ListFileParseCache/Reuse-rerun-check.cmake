@@ -0,0 +1,6 @@
+if(NOT actual_stdout MATCHES "List file parse cache: ([0-9]+) of ([0-9]+) files")
+  set(RunCMake_TEST_FAILED "Parse cache statistics not reported.")
+elseif(NOT CMAKE_MATCH_1 EQUAL CMAKE_MATCH_2)
+  set(RunCMake_TEST_FAILED
+    "Expected all ${CMAKE_MATCH_2} files to be loaded from cache, but only ${CMAKE_MATCH_1} were.")
+endif()
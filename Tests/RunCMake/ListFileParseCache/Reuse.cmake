@@ -0,0 +1,2 @@
+include(${CMAKE_CURRENT_LIST_DIR}/Reuse-include.cmake)
+reuse_message(a "b" [[c]])
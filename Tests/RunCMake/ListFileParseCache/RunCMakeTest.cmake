@@ -0,0 +1,18 @@
+include(RunCMake)
+
+function(run_ParseCache test)
+  # Use a single build tree for both runs without cleaning.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/${test}-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(RunCMake_TEST_OPTIONS -DCMAKE_LISTFILE_PARSE_CACHE=parse.cache)
+  run_cmake(${test})
+  unset(RunCMake_TEST_OPTIONS)
+  run_cmake_command(${test}-rerun ${CMAKE_COMMAND} .)
+endfunction()
+
+run_ParseCache(Reuse)
+run_ParseCache(Warning)
+run_ParseCache(Changed)
+run_ParseCache(Prune)
@@ -0,0 +1,6 @@
+if(NOT actual_stdout MATCHES "List file parse cache: ([0-9]+) of ([0-9]+) files")
+  set(RunCMake_TEST_FAILED "Parse cache statistics not reported.")
+elseif(NOT CMAKE_MATCH_1 LESS CMAKE_MATCH_2)
+  set(RunCMake_TEST_FAILED
+    "Expected the file with a warning to be parsed again, but all files were loaded from cache.")
+endif()
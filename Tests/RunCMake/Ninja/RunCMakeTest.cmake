@@ -207,6 +207,31 @@ build build.ninja: RERUN ${escaped_build_ninja_dep} || ${escaped_ninja_output_pa
 
 endfunction(run_sub_cmake)
 
+function(run_SplitByDirectory)
+  # Use a single build tree for a few tests without cleaning.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SplitByDirectory-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(SplitByDirectory)
+
+  # Check an unchanged directory file is not replaced by regeneration.
+  set(sub_file "${RunCMake_TEST_BINARY_DIR}/SplitByDirectory/CMakeFiles/directory.ninja")
+  file(TIMESTAMP "${sub_file}" mtime_before UTC)
+  sleep(1) # Assume the system as 1 sec timestamp resolution.
+  run_cmake(SplitByDirectory)
+  file(TIMESTAMP "${sub_file}" mtime_after UTC)
+  if(NOT mtime_after STREQUAL mtime_before)
+    message(FATAL_ERROR
+      "unchanged directory.ninja replaced:
+  before = ${mtime_before}
+  after  = ${mtime_after}")
+  endif()
+
+  run_cmake_command(SplitByDirectory-build ${CMAKE_COMMAND} --build .)
+endfunction()
+run_SplitByDirectory()
+
 if("${ninja_version}" VERSION_LESS 1.6)
   message(WARNING "Ninja is too old; skipping rest of test.")
   return()
@@ -0,0 +1,17 @@
+set(top_file "${RunCMake_TEST_BINARY_DIR}/build.ninja")
+set(sub_file "${RunCMake_TEST_BINARY_DIR}/SplitByDirectory/CMakeFiles/directory.ninja")
+file(READ "${top_file}" top)
+if(NOT top MATCHES "\nsubninja CMakeFiles/directory\\.ninja\n")
+  set(RunCMake_TEST_FAILED "${top_file}\ndoes not include the top directory file.")
+elseif(NOT top MATCHES "\nsubninja SplitByDirectory/CMakeFiles/directory\\.ninja\n")
+  set(RunCMake_TEST_FAILED "${top_file}\ndoes not include the subdirectory file.")
+elseif(top MATCHES "Building SubTarget")
+  set(RunCMake_TEST_FAILED "${top_file}\nhas build statements of the subdirectory.")
+elseif(NOT EXISTS "${sub_file}")
+  set(RunCMake_TEST_FAILED "${sub_file}\nwas not generated.")
+else()
+  file(READ "${sub_file}" sub)
+  if(NOT sub MATCHES "Building SubTarget")
+    set(RunCMake_TEST_FAILED "${sub_file}\ndoes not have the build statements of the subdirectory.")
+  endif()
+endif()
@@ -0,0 +1,3 @@
+set(CMAKE_NINJA_SPLIT_BY_DIRECTORY 1)
+add_custom_target(TopTarget ALL COMMAND ${CMAKE_COMMAND} -E echo "Building TopTarget")
+add_subdirectory(SplitByDirectory)
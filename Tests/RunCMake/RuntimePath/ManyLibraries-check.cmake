@@ -0,0 +1,17 @@
+set(link_txt ${RunCMake_TEST_BINARY_DIR}/CMakeFiles/ManyLibraries.dir/link.txt)
+file(READ ${link_txt} link)
+if(NOT link MATCHES "-rpath,([^ ]*)")
+  set(RunCMake_TEST_FAILED "No runtime path in:\n  ${link}")
+  return()
+endif()
+string(REPLACE ":" ";" rpath "${CMAKE_MATCH_1}")
+
+set(expect)
+foreach(d RANGE 99)
+  list(INSERT expect 0 ${RunCMake_TEST_BINARY_DIR}/libs/d${d})
+endforeach()
+if(NOT rpath STREQUAL expect)
+  string(REPLACE ";" "\n  " rpath "${rpath}")
+  set(RunCMake_TEST_FAILED
+    "Runtime path is not in reverse directory order:\n  ${rpath}")
+endif()
@@ -0,0 +1,25 @@
+enable_language(C)
+
+# Put 1000 shared libraries in 100 directories.  Each directory also has
+# other files named like libraries of the next directory, so that one
+# must come first and the runtime path lists them in reverse order.
+# Half of the libraries have a known soname.
+set(root ${CMAKE_CURRENT_BINARY_DIR}/libs)
+add_executable(ManyLibraries ${CMAKE_CURRENT_SOURCE_DIR}/empty.c)
+foreach(i RANGE 999)
+  math(EXPR d "${i} / 10")
+  math(EXPR next "${i} % 10")
+  set(lib ${root}/d${d}/libm${i}.so)
+  file(WRITE ${lib} "m${i}\n")
+  if(next LESS 2 AND d GREATER 0)
+    math(EXPR prev "${d} - 1")
+    file(WRITE ${root}/d${prev}/libm${i}.so "conflict\n")
+  endif()
+  add_library(m${i} SHARED IMPORTED)
+  set_property(TARGET m${i} PROPERTY IMPORTED_LOCATION ${lib})
+  math(EXPR odd "${i} % 2")
+  if(NOT odd)
+    set_property(TARGET m${i} PROPERTY IMPORTED_SONAME libm${i}.so)
+  endif()
+  target_link_libraries(ManyLibraries m${i})
+endforeach()
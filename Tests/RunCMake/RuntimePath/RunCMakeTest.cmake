@@ -0,0 +1,3 @@
+include(RunCMake)
+
+run_cmake(ManyLibraries)
@@ -0,0 +1,27 @@
+include(Common.cmake)
+
+set_source_files_properties(
+  ${CMAKE_CURRENT_SOURCE_DIR}/ByFullPath.c PROPERTIES LOOKUP_PROP source)
+set_source_files_properties(
+  ${CMAKE_CURRENT_BINARY_DIR}/ByFullPath.c PROPERTIES LOOKUP_PROP binary)
+set_source_files_properties(
+  ${CMAKE_CURRENT_SOURCE_DIR}/sub/ByFullPath.c PROPERTIES LOOKUP_PROP sub)
+
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/ByFullPath.c source)
+check_source(${CMAKE_CURRENT_BINARY_DIR}/ByFullPath.c binary)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/sub/ByFullPath.c sub)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/sub/../ByFullPath.c source)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/ByFullPath source)
+
+# A relative path refers to the first source it can name.
+check_source(ByFullPath.c source)
+check_source(sub/ByFullPath.c sub)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/other/ByFullPath.c NOTFOUND)
+
+# A source named by relative path is found by full path, which then
+# decides the directory the source is in.
+set_source_files_properties(sub/Relative.c PROPERTIES LOOKUP_PROP relative)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/sub/Relative.c relative)
+check_source(sub/Relative.c relative)
+check_source(${CMAKE_CURRENT_BINARY_DIR}/sub/Relative.c NOTFOUND)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/Relative.c NOTFOUND)
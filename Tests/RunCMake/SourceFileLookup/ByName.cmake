@@ -0,0 +1,16 @@
+include(Common.cmake)
+
+set_source_files_properties(ByName.c PROPERTIES LOOKUP_PROP c)
+set_source_files_properties(ByName.h PROPERTIES LOOKUP_PROP h)
+set_source_files_properties(ByName.txt PROPERTIES LOOKUP_PROP txt)
+
+check_source(ByName.c c)
+check_source(ByName.h h)
+check_source(ByName.txt txt)
+
+# A name without extension refers to the first source it can name.
+check_source(ByName c)
+
+check_source(ByName.cxx NOTFOUND)
+check_source(ByName.c.c NOTFOUND)
+check_source(sub/ByName.c NOTFOUND)
@@ -0,0 +1,8 @@
+function(check_source file expect)
+  get_source_file_property(actual "${file}" LOOKUP_PROP)
+  if(NOT "${actual}" STREQUAL "${expect}")
+    message(SEND_ERROR
+      "Source \"${file}\" has LOOKUP_PROP\n  \"${actual}\"\n"
+      "but \"${expect}\" was expected.")
+  endif()
+endfunction()
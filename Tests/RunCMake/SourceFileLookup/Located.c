@@ -0,0 +1 @@
+int located(void) { return 0; }
@@ -0,0 +1,29 @@
+include(Common.cmake)
+
+# A source first named without extension takes the name of the first
+# lookup that gives one.  It must still be found by either name.
+set_source_files_properties(Renamed PROPERTIES LOOKUP_PROP renamed)
+check_source(Renamed renamed)
+check_source(Renamed.c renamed)
+check_source(Renamed renamed)
+check_source(Renamed.c renamed)
+check_source(Renamed.cxx NOTFOUND)
+
+# A source first named by relative path takes the directory of the first
+# lookup by full path.
+set_source_files_properties(sub/Moved PROPERTIES LOOKUP_PROP moved)
+check_source(${CMAKE_CURRENT_BINARY_DIR}/sub/Moved.cxx moved)
+check_source(${CMAKE_CURRENT_BINARY_DIR}/sub/Moved moved)
+check_source(sub/Moved.cxx moved)
+check_source(sub/Moved moved)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/sub/Moved.cxx NOTFOUND)
+
+# A file on disk resolves the extension of a source named without one.
+get_source_file_property(location Located LOCATION)
+if(NOT location STREQUAL "${CMAKE_CURRENT_SOURCE_DIR}/Located.c")
+  message(SEND_ERROR "Located has LOCATION\n  \"${location}\"")
+endif()
+set_source_files_properties(Located.c PROPERTIES LOOKUP_PROP located)
+check_source(Located located)
+check_source(Located.c located)
+check_source(${CMAKE_CURRENT_SOURCE_DIR}/Located.c located)
@@ -0,0 +1,5 @@
+include(RunCMake)
+
+run_cmake(ByName)
+run_cmake(ByFullPath)
+run_cmake(Renamed)
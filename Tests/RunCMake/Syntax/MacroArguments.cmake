@@ -0,0 +1,22 @@
+macro(mac a b)
+  message("${a},${b},${ARGC},${ARGN},${ARGV},${ARGV0},${ARGV2},${ARGV3}")
+  message("${${a}},${x${a}},${foo_${b}}")
+endmacro()
+set(one 1)
+set(xone x1)
+set(foo_two f2)
+set(ARGV3 v3)
+mac(one two)
+mac(one two three)
+mac("\${b}" two)
+mac(one "\${ARGC}" z)
+
+macro(dup a a)
+  message("${a},${ARGV1}")
+endmacro()
+dup(p q)
+
+macro(argc ARGC)
+  message("${ARGC}")
+endmacro()
+argc(v)
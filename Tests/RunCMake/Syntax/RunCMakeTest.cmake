@@ -24,6 +24,7 @@ run_cmake(CommandError2)
 run_cmake(ForEachBracket1)
 run_cmake(FunctionBracket1)
 run_cmake(MacroBracket1)
+run_cmake(MacroArguments)
 run_cmake(String0)
 run_cmake(String1)
 run_cmake(StringBackslash)
@@ -75,3 +75,17 @@ add_test(NAME FailingTest COMMAND ${CMAKE_COMMAND} -E no_such_command)
   run_ctest(TestOutputSize)
 endfunction()
 run_TestOutputSize()
+
+function(run_TestScheduleCriticalPath)
+  set(CASE_CTEST_TEST_ARGS PARALLEL_LEVEL 2 SCHEDULE_CRITICAL_PATH ON)
+  set(CASE_CMAKELISTS_SUFFIX_CODE [[
+add_test(NAME Setup COMMAND ${CMAKE_COMMAND} -E echo Setup)
+add_test(NAME Middle COMMAND ${CMAKE_COMMAND} -E echo Middle)
+add_test(NAME Last COMMAND ${CMAKE_COMMAND} -E echo Last)
+set_property(TEST Middle PROPERTY DEPENDS Setup)
+set_property(TEST Last PROPERTY DEPENDS Middle)
+  ]])
+
+  run_ctest(TestScheduleCriticalPath)
+endfunction()
+run_TestScheduleCriticalPath()
@@ -0,0 +1,33 @@
+cmake_policy(SET CMP0007 NEW)
+
+# Read the list between appends so that its elements are kept.
+set(mylist "")
+list(LENGTH mylist n0)
+list(APPEND mylist a b)
+list(LENGTH mylist n1)
+list(APPEND mylist "" c)
+list(LENGTH mylist n2)
+list(APPEND mylist "x\\" y)
+list(LENGTH mylist n3)
+list(GET mylist -1 last)
+message("mylist is: ${mylist} (${n0} ${n1} ${n2} ${n3} ${last})")
+
+set(bracket "[a;b")
+list(LENGTH bracket n0)
+list(APPEND bracket "c]" d)
+list(LENGTH bracket n1)
+list(GET bracket 0 first)
+message("bracket is: ${bracket} (${n0} ${n1} ${first})")
+
+function(append_in_function)
+  list(APPEND mylist inner)
+  list(LENGTH mylist n)
+  message("function mylist is: ${mylist} (${n})")
+endfunction()
+append_in_function()
+list(LENGTH mylist n)
+message("mylist is: ${mylist} (${n})")
+
+foreach(item IN LISTS mylist bracket)
+  message("item: ${item}")
+endforeach()
@@ -0,0 +1,35 @@
+# Read variables of outer scopes again after nested calls change them.
+set(G global)
+function(inner)
+  message("inner sees ${G} ${L}")
+  set(G from_inner PARENT_SCOPE)
+  set(N new_from_inner PARENT_SCOPE)
+  message("inner still sees ${G} ${N}")
+endfunction()
+function(outer)
+  set(L outer_local)
+  message("outer sees ${G} ${N}")
+  inner()
+  message("outer now sees ${G} ${N}")
+  unset(G)
+  message("outer after unset [${G}]")
+  inner()
+  unset(G PARENT_SCOPE)
+  message("outer [${G}]")
+endfunction()
+outer()
+message("top [${G}] [${N}]")
+
+function(deep n)
+  if(n GREATER 0)
+    math(EXPR m "${n}-1")
+    message("${n}: ${V}")
+    set(V "v${n}")
+    deep(${m})
+    message("${n} back: ${V}")
+    set(V "up${n}" PARENT_SCOPE)
+  endif()
+endfunction()
+set(V top)
+deep(3)
+message("V=${V}")
@@ -0,0 +1,25 @@
+macro(check_link exe has)
+  set(link_txt ${RunCMake_TEST_BINARY_DIR}/CMakeFiles/${exe}.dir/link.txt)
+  file(READ ${link_txt} link)
+  string(FIND "${link}" "${has}" pos)
+  if(pos EQUAL -1)
+    string(APPEND RunCMake_TEST_FAILED
+      "${exe} does not link ${has}:\n  ${link}\n")
+  endif()
+  foreach(lacks ${ARGN})
+    string(FIND "${link}" "${lacks}" pos)
+    if(NOT pos EQUAL -1)
+      string(APPEND RunCMake_TEST_FAILED
+        "${exe} links ${lacks}:\n  ${link}\n")
+    endif()
+  endforeach()
+endmacro()
+
+check_link(LinkDependsPlain1 LinkDependsBase LinkDependsExtra)
+check_link(LinkDependsWithExtra LinkDependsExtra)
+check_link(LinkDependsPlain2 LinkDependsBase LinkDependsExtra)
+check_link(LinkDependsOther1 -lLinkDependsSelfExe1)
+check_link(LinkDependsSelfExe1 LinkDependsSelf1 -lLinkDependsSelfExe1)
+check_link(LinkDependsOther2 -lLinkDependsSelfExe1)
+check_link(LinkDependsSelfExe2 LinkDependsSelf2 -lLinkDependsSelfExe2)
+check_link(LinkDependsOther3 -lLinkDependsSelfExe2)
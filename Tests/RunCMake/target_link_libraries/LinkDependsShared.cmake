@@ -0,0 +1,31 @@
+enable_language(C)
+cmake_policy(SET CMP0022 NEW)
+
+add_library(LinkDependsBase STATIC empty.c)
+add_library(LinkDependsMid STATIC empty.c)
+target_link_libraries(LinkDependsMid PUBLIC LinkDependsBase)
+
+# A link interface that depends on the target linking it.
+add_library(LinkDependsExtra STATIC empty.c)
+add_library(LinkDependsSensitive STATIC empty.c)
+target_link_libraries(LinkDependsSensitive INTERFACE
+  $<$<BOOL:$<TARGET_PROPERTY:LINK_DEPENDS_EXTRA>>:LinkDependsExtra>)
+foreach(exe LinkDependsPlain1 LinkDependsWithExtra LinkDependsPlain2)
+  add_executable(${exe} empty.c)
+  target_link_libraries(${exe} LinkDependsMid LinkDependsSensitive)
+endforeach()
+set_property(TARGET LinkDependsWithExtra PROPERTY LINK_DEPENDS_EXTRA 1)
+
+# Link interfaces naming a target linking them.
+add_library(LinkDependsSelf1 STATIC empty.c)
+target_link_libraries(LinkDependsSelf1 INTERFACE LinkDependsSelfExe1)
+foreach(exe LinkDependsOther1 LinkDependsSelfExe1 LinkDependsOther2)
+  add_executable(${exe} empty.c)
+  target_link_libraries(${exe} LinkDependsMid LinkDependsSelf1)
+endforeach()
+add_library(LinkDependsSelf2 STATIC empty.c)
+target_link_libraries(LinkDependsSelf2 INTERFACE LinkDependsSelfExe2)
+foreach(exe LinkDependsSelfExe2 LinkDependsOther3)
+  add_executable(${exe} empty.c)
+  target_link_libraries(${exe} LinkDependsMid LinkDependsSelf2)
+endforeach()
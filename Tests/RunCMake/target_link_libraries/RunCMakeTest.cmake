@@ -10,3 +10,7 @@ run_cmake(SubDirTarget)
 run_cmake(SharedDepNotTarget)
 run_cmake(StaticPrivateDepNotExported)
 run_cmake(StaticPrivateDepNotTarget)
+
+if(RunCMake_GENERATOR STREQUAL "Unix Makefiles")
+  run_cmake(LinkDependsShared)
+endif()
@@ -0,0 +1 @@
+try_compile(BUILD_DEFERRED PARALLEL_LEVEL many)
@@ -0,0 +1,21 @@
+enable_language(C)
+set(CMAKE_TRY_COMPILE_CACHE_DIR ${CACHE_DIR})
+try_compile(result ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out
+  )
+if(NOT result OR NOT out)
+  message(FATAL_ERROR "try_compile failed:\n${out}")
+endif()
+try_compile(result ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c ${CMAKE_CURRENT_SOURCE_DIR}/other.c
+  COMPILE_DEFINITIONS -DPP_ERROR
+  OUTPUT_VARIABLE out
+  )
+if(result OR NOT out MATCHES "PP_ERROR is defined")
+  message(FATAL_ERROR "try_compile did not fail with PP_ERROR:\n${out}")
+endif()
+file(GLOB_RECURSE tmp ${CACHE_DIR}/*.tmp)
+if(tmp)
+  message(FATAL_ERROR "Temporary files left in the cache:\n  ${tmp}")
+endif()
@@ -0,0 +1 @@
+include(CacheDir.cmake)
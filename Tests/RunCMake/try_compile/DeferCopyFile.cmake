@@ -0,0 +1,2 @@
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  DEFER COPY_FILE ${CMAKE_CURRENT_BINARY_DIR}/copied.bin)
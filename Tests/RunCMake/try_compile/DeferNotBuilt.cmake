@@ -0,0 +1,4 @@
+enable_language(C)
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR}/Deferred
+  ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  DEFER)
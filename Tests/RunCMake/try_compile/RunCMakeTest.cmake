@@ -15,6 +15,9 @@ run_cmake(BadSources1)
 run_cmake(BadSources2)
 run_cmake(NonSourceCopyFile)
 run_cmake(NonSourceCompileDefinitions)
+run_cmake(DeferCopyFile)
+run_cmake(DeferNotBuilt)
+run_cmake(BuildDeferredBadParallel)
 
 set(RunCMake_TEST_OPTIONS --debug-trycompile)
 run_cmake(PlatformVariables)
@@ -27,6 +30,13 @@ run_cmake(TargetTypeStatic)
 run_cmake(CMP0056)
 run_cmake(CMP0066)
 
+# Use a cache directory shared by two build trees.
+set(RunCMake_TEST_OPTIONS -DCACHE_DIR=${RunCMake_BINARY_DIR}/CacheDir-cache)
+file(REMOVE_RECURSE "${RunCMake_BINARY_DIR}/CacheDir-cache")
+run_cmake(CacheDir)
+run_cmake(CacheDirReuse)
+unset(RunCMake_TEST_OPTIONS)
+
 if(RunCMake_GENERATOR MATCHES "Make|Ninja")
   # Use a single build tree for a few tests without cleaning.
   set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/RerunCMake-build)
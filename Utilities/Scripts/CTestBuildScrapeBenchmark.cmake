@@ -0,0 +1,64 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Scrape a synthetic build log for errors and warnings with ctest_build so
+# that the cost of matching long compiler command lines can be timed.  The
+# default error and warning patterns look for "<file>:<line>" anywhere on
+# a line, which a backtracking matcher tries from every position of it.
+# Run it as a dashboard script under a timer:
+#
+#   time ctest -V -DLENGTH=16000 -S CTestBuildScrapeBenchmark.cmake
+#
+# BENCHMARK_DIR - where to write the log
+#                 (default: ./CTestBuildScrapeBenchmark)
+# LINES - the number of compiler command lines in the log (default: 2000)
+# LENGTH - the number of characters in each command line (default: 8000)
+
+if(NOT BENCHMARK_DIR)
+  set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/CTestBuildScrapeBenchmark")
+endif()
+if(NOT LINES)
+  set(LINES 2000)
+endif()
+if(NOT LENGTH)
+  set(LENGTH 8000)
+endif()
+
+# Double the flags to the length instead of appending them one by one.
+set(_flags " -I/benchmark/include/directory")
+string(LENGTH "${_flags}" _len)
+while(_len LESS LENGTH)
+  string(APPEND _flags "${_flags}")
+  string(LENGTH "${_flags}" _len)
+endwhile()
+string(SUBSTRING "${_flags}" 0 ${LENGTH} _flags)
+
+# Write the log in blocks as appending to a long string copies it.  Every
+# tenth command line is followed by a warning.
+file(REMOVE_RECURSE "${BENCHMARK_DIR}")
+file(WRITE "${BENCHMARK_DIR}/build.log" "")
+set(_content "")
+foreach(_i RANGE 1 ${LINES})
+  string(APPEND _content "/usr/bin/c++${_flags} -c /src/f${_i}.cxx\n")
+  math(EXPR _warn "${_i} % 10")
+  if(_warn EQUAL 0)
+    string(APPEND _content
+      "/src/f${_i}.cxx:12:5: warning: unused variable 'x'\n")
+  endif()
+  math(EXPR _block "${_i} % 100")
+  if(_block EQUAL 0 OR _i EQUAL LINES)
+    file(APPEND "${BENCHMARK_DIR}/build.log" "${_content}")
+    set(_content "")
+  endif()
+endforeach()
+file(WRITE "${BENCHMARK_DIR}/build.cmake"
+  "file(READ \"${BENCHMARK_DIR}/build.log\" log)\nmessage(\"\${log}\")\n")
+
+set(CTEST_SOURCE_DIRECTORY "${BENCHMARK_DIR}")
+set(CTEST_BINARY_DIRECTORY "${BENCHMARK_DIR}")
+set(CTEST_BUILD_COMMAND
+  "\"${CMAKE_COMMAND}\" -P \"${BENCHMARK_DIR}/build.cmake\"")
+set(CTEST_CUSTOM_MAXIMUM_NUMBER_OF_WARNINGS ${LINES})
+ctest_start(Experimental QUIET)
+ctest_build(NUMBER_WARNINGS _warnings QUIET)
+message(STATUS "${LINES} lines of ${LENGTH} characters: ${_warnings} warnings")
@@ -0,0 +1,72 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure how long ctest takes to run synthetic test suites of growing
+# size.  The time ctest spends per test should stay about the same as
+# the suites grow.
+#
+# Invoke in script mode, optionally defining these variables:
+# CTEST - the ctest to measure (default: the one next to this cmake)
+# BENCHMARK_DIR - where to write the suites (default: ./CTestScalingBenchmark)
+# COUNTS - the numbers of tests in the suites (default: 1000;10000;100000)
+# PARALLEL - the parallel level to run the suites at (default: 8)
+# CHAIN - the length of the chains of tests depending on the test before
+#         them, 1 for independent tests (default: 10)
+# RUN - whether the tests run a process.  By default they name a command
+#       that does not exist so that ctest schedules every test without
+#       starting a process, whose cost would hide that of the scheduling.
+
+if(NOT CTEST)
+  get_filename_component(_bin "${CMAKE_COMMAND}" DIRECTORY)
+  set(CTEST "${_bin}/ctest${CMAKE_EXECUTABLE_SUFFIX}")
+endif()
+if(NOT BENCHMARK_DIR)
+  set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/CTestScalingBenchmark")
+endif()
+if(NOT COUNTS)
+  set(COUNTS 1000 10000 100000)
+endif()
+if(NOT PARALLEL)
+  set(PARALLEL 8)
+endif()
+if(NOT CHAIN)
+  set(CHAIN 10)
+endif()
+if(RUN)
+  set(_command "\"${CMAKE_COMMAND}\" \"-E\" \"echo_append\"")
+else()
+  set(_command "\"no_such_command_for_ctest_benchmark\"")
+endif()
+
+foreach(_count IN LISTS COUNTS)
+  # Write the test file directly as generating it takes long for many
+  # tests.  Append it in blocks as appending to a long string copies it.
+  set(_dir "${BENCHMARK_DIR}/${_count}")
+  file(REMOVE_RECURSE "${_dir}")
+  file(WRITE "${_dir}/CTestTestfile.cmake" "")
+  set(_content "")
+  foreach(_i RANGE 1 ${_count})
+    string(APPEND _content "add_test(t${_i} ${_command})\n")
+    math(EXPR _link "${_i} % ${CHAIN}")
+    if(NOT _link EQUAL 1 AND NOT CHAIN EQUAL 1)
+      math(EXPR _prev "${_i} - 1")
+      string(APPEND _content
+        "set_tests_properties(t${_i} PROPERTIES DEPENDS t${_prev})\n")
+    endif()
+    math(EXPR _block "${_i} % 1000")
+    if(_block EQUAL 0 OR _i EQUAL _count)
+      file(APPEND "${_dir}/CTestTestfile.cmake" "${_content}")
+      set(_content "")
+    endif()
+  endforeach()
+
+  execute_process(COMMAND "${CTEST}" -j${PARALLEL}
+    WORKING_DIRECTORY "${_dir}"
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _output
+    )
+  if(NOT _output MATCHES "Total Test time \\(real\\) = *([0-9.]+) sec")
+    message(FATAL_ERROR "ctest failed to run ${_count} tests:\n${_output}")
+  endif()
+  message(STATUS "${_count} tests: ${CMAKE_MATCH_1} sec")
+endforeach()
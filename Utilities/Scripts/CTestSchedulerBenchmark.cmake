@@ -0,0 +1,51 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure what ctest spends to dispatch each test of a suite of trivial
+# tests.  Every test runs a command that returns at once, so nearly all
+# of the time per test is spent noticing that a test finished and
+# starting the next one.  At higher parallel levels the time per test
+# should drop by about the number of processors available.
+#
+# Invoke in script mode, optionally defining these variables:
+# CTEST - the ctest to measure (default: the one next to this cmake)
+# BENCHMARK_DIR - where to write the suite (default: ./CTestSchedulerBenchmark)
+# COUNT - the number of tests in the suite (default: 10000)
+# PARALLEL - the parallel levels to run the suite at (default: 1;8;64)
+
+if(NOT CTEST)
+  get_filename_component(_bin "${CMAKE_COMMAND}" DIRECTORY)
+  set(CTEST "${_bin}/ctest${CMAKE_EXECUTABLE_SUFFIX}")
+endif()
+if(NOT BENCHMARK_DIR)
+  set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/CTestSchedulerBenchmark")
+endif()
+if(NOT COUNT)
+  set(COUNT 10000)
+endif()
+if(NOT PARALLEL)
+  set(PARALLEL 1 8 64)
+endif()
+
+file(REMOVE_RECURSE "${BENCHMARK_DIR}")
+set(_content "")
+foreach(_i RANGE 1 ${COUNT})
+  string(APPEND _content
+    "add_test(t${_i} \"${CMAKE_COMMAND}\" \"-E\" \"echo\" \"t${_i}\")\n")
+endforeach()
+file(WRITE "${BENCHMARK_DIR}/CTestTestfile.cmake" "${_content}")
+
+foreach(_parallel IN LISTS PARALLEL)
+  execute_process(COMMAND "${CTEST}" -j${_parallel}
+    WORKING_DIRECTORY "${BENCHMARK_DIR}"
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _output
+    )
+  if(NOT _output MATCHES "Total Test time \\(real\\) = *([0-9]+)[.]([0-9]+) sec")
+    message(FATAL_ERROR "ctest failed to run the tests:\n${_output}")
+  endif()
+  set(_time "${CMAKE_MATCH_1}.${CMAKE_MATCH_2}")
+  # ctest reports the time with two decimals.
+  math(EXPR _us "(${CMAKE_MATCH_1} * 100 + ${CMAKE_MATCH_2}) * 10000 / ${COUNT}")
+  message(STATUS "-j${_parallel}: ${_time} sec, ${_us} us per test")
+endforeach()
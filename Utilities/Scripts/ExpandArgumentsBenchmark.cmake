@@ -0,0 +1,24 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Call commands with the same arguments over and over as loops in many
+# projects do so that the cost of expanding variable references in the
+# arguments can be timed.  Run it in script mode under a timer:
+#
+#   time cmake -DCALLS=100000 -P ExpandArgumentsBenchmark.cmake
+#
+# CALLS - the number of times each command is called (default: 20000)
+
+if(NOT CALLS)
+  set(CALLS 20000)
+endif()
+
+set(_bench_one 1)
+set(_bench_list a b c)
+set(a.b/c+d-e name)
+
+foreach(i RANGE 1 ${CALLS})
+  set(_bench_items _prefix_${_bench_one} ${_bench_list} ${a.b/c+d-e}/include)
+  set(_bench_flags "${_bench_list} -DVALUE=${_bench_one} -I${_bench_list}")
+  string(CONCAT _bench_name "${_bench_one}" ${_bench_list} "${i}")
+endforeach()
@@ -0,0 +1,99 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure how long cmake takes to compute and generate projects with
+# wide and deep graphs of link dependencies.  Each project has a chain
+# of D static libraries, each linking the next, and every tenth of them
+# also linking the library ten further down.  N directories each hold W
+# executables linking the top of the chain, and every fourth of them also
+# links a library of its own directory.
+#
+# Invoke in script mode, optionally defining these variables:
+# CMAKE - the cmake to measure (default: the one running this script)
+# BENCHMARK_DIR - where to write the projects
+#                 (default: ./LinkDependsBenchmark)
+# GRAPHS - the graphs to measure, each given as <D>x<N>x<W>
+#          (default: 100x5x100;200x5x100;400x5x100;200x5x200;200x10x100)
+
+if(NOT CMAKE)
+  set(CMAKE "${CMAKE_COMMAND}")
+endif()
+if(NOT BENCHMARK_DIR)
+  set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/LinkDependsBenchmark")
+endif()
+if(NOT GRAPHS)
+  set(GRAPHS 100x5x100 200x5x100 400x5x100 200x5x200 200x10x100)
+endif()
+
+foreach(_graph IN LISTS GRAPHS)
+  if(NOT _graph MATCHES "^([0-9]+)x([0-9]+)x([0-9]+)$")
+    message(FATAL_ERROR "Graph \"${_graph}\" is not given as <D>x<N>x<W>")
+  endif()
+  set(_depth "${CMAKE_MATCH_1}")
+  set(_dirs "${CMAKE_MATCH_2}")
+  set(_width "${CMAKE_MATCH_3}")
+
+  set(_dir "${BENCHMARK_DIR}/${_graph}")
+  file(REMOVE_RECURSE "${_dir}")
+  file(WRITE "${_dir}/lib.c" "int lib(void) { return 0; }\n")
+  file(WRITE "${_dir}/main.c" "int main(void) { return 0; }\n")
+  file(WRITE "${_dir}/CMakeLists.txt" "
+cmake_minimum_required(VERSION 3.7)
+project(LinkDependsBenchmark C)
+foreach(d RANGE 1 ${_depth})
+  add_library(chain\${d} STATIC lib.c)
+endforeach()
+foreach(d RANGE 2 ${_depth})
+  math(EXPR p \"\${d} - 1\")
+  target_link_libraries(chain\${p} chain\${d})
+  math(EXPR p \"\${d} - 10\")
+  math(EXPR r \"\${p} % 10\")
+  if(p GREATER 0 AND r EQUAL 0)
+    target_link_libraries(chain\${p} chain\${d})
+  endif()
+endforeach()
+foreach(n RANGE 1 ${_dirs})
+  add_subdirectory(dir dir\${n})
+endforeach()
+")
+  file(WRITE "${_dir}/dir/CMakeLists.txt" "
+get_filename_component(n \"\${CMAKE_CURRENT_BINARY_DIR}\" NAME)
+add_library(\${n}_lib STATIC ../lib.c)
+foreach(w RANGE 1 ${_width})
+  add_executable(\${n}_exe\${w} ../main.c)
+  target_link_libraries(\${n}_exe\${w} chain1)
+  math(EXPR r \"\${w} % 4\")
+  if(r EQUAL 0)
+    target_link_libraries(\${n}_exe\${w} \${n}_lib)
+  endif()
+endforeach()
+")
+
+  # The compute step begins the part of the profile to time, which ends
+  # with the generate step as the last event.
+  execute_process(COMMAND "${CMAKE}" --profiling-output=profile.json .
+    WORKING_DIRECTORY "${_dir}"
+    RESULT_VARIABLE _result
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _output
+    )
+  if(_result)
+    message(FATAL_ERROR "cmake failed on graph ${_graph}:\n${_output}")
+  endif()
+  file(READ "${_dir}/profile.json" _profile)
+  if(NOT _profile MATCHES "\"compute\",\"ph\":\"B\"[^}]*\"ts\":([0-9]+)")
+    message(FATAL_ERROR "No compute step in ${_dir}/profile.json")
+  endif()
+  set(_begin "${CMAKE_MATCH_1}")
+  if(NOT _profile MATCHES "\"ts\":([0-9]+)}[\r\n]*][\r\n]*$")
+    message(FATAL_ERROR "No last event in ${_dir}/profile.json")
+  endif()
+  math(EXPR _ms "(${CMAKE_MATCH_1} - ${_begin}) / 1000")
+  set(_counter "\"computed\":([0-9]+),\"shared\":([0-9]+)}")
+  string(APPEND _counter ",\"cat\":\"counter\",\"name\":\"link dependencies\"")
+  if(NOT _profile MATCHES "${_counter}")
+    message(FATAL_ERROR "No link dependencies in ${_dir}/profile.json")
+  endif()
+  message(STATUS "D=${_depth} N=${_dirs} W=${_width}: "
+    "${_ms} ms, computed ${CMAKE_MATCH_1}, shared ${CMAKE_MATCH_2}")
+endforeach()
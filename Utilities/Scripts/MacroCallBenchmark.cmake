@@ -0,0 +1,40 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Call helper macros in the way many projects do so that the cost of
+# invoking a macro can be timed.  Run it in script mode under a timer:
+#
+#   time cmake -DCALLS=100000 -P MacroCallBenchmark.cmake
+#
+# CALLS - the number of times each macro is called (default: 20000)
+
+if(NOT CALLS)
+  set(CALLS 20000)
+endif()
+
+macro(_bench_append_flags var flag)
+  if(NOT "${${var}}" MATCHES "${flag}")
+    set(${var} "${${var}} ${flag}")
+  endif()
+endmacro()
+
+macro(_bench_set_default var)
+  if(NOT DEFINED ${var})
+    set(${var} ${ARGN})
+  endif()
+  list(LENGTH ${var} _bench_len)
+  set(_bench_args "${ARGC}:${ARGV0}:${ARGV1}:${ARGV}")
+endmacro()
+
+macro(_bench_record name type value)
+  set(_bench_${name}_type "${type}")
+  set(_bench_${name}_value "${value}")
+  set(_bench_last "${name}=${value} (${type})")
+  string(LENGTH "${_bench_last}" _bench_len)
+endmacro()
+
+foreach(i RANGE 1 ${CALLS})
+  _bench_append_flags(_bench_flags -Wall)
+  _bench_set_default(_bench_default_${i} a b c)
+  _bench_record(item STRING "value ${i}")
+endforeach()
@@ -0,0 +1,64 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure how long cmake takes to configure synthetic directories that
+# set and then look up properties of a growing number of source files.
+# Each source is named once by relative path with extension and once by
+# full path without, so the lookups must resolve both the directory and
+# the extension.
+# The time per source should stay about the same as the directories grow.
+#
+# Invoke in script mode, optionally defining these variables:
+# CMAKE - the cmake to measure (default: the one running this script)
+# BENCHMARK_DIR - where to write the projects
+#                 (default: ./SourceLookupBenchmark)
+# COUNTS - the numbers of sources in the projects (default: 1000;10000;20000)
+
+if(NOT CMAKE)
+  set(CMAKE "${CMAKE_COMMAND}")
+endif()
+if(NOT BENCHMARK_DIR)
+  set(BENCHMARK_DIR "${CMAKE_CURRENT_BINARY_DIR}/SourceLookupBenchmark")
+endif()
+if(NOT COUNTS)
+  set(COUNTS 1000 10000 20000)
+endif()
+
+foreach(_count IN LISTS COUNTS)
+  set(_dir "${BENCHMARK_DIR}/${_count}")
+  file(REMOVE_RECURSE "${_dir}")
+  file(WRITE "${_dir}/CMakeLists.txt" "
+cmake_minimum_required(VERSION 3.7)
+project(SourceLookupBenchmark NONE)
+foreach(i RANGE 1 ${_count})
+  set_source_files_properties(src\${i}.c PROPERTIES LABELS \${i})
+endforeach()
+foreach(i RANGE 1 ${_count})
+  get_source_file_property(l \${CMAKE_CURRENT_SOURCE_DIR}/src\${i} LABELS)
+  if(NOT l EQUAL i)
+    message(FATAL_ERROR \"src\${i} has LABELS \${l}\")
+  endif()
+endforeach()
+")
+
+  # The configure step ends where the compute step of the profile begins.
+  execute_process(COMMAND "${CMAKE}" --profiling-output=profile.json .
+    WORKING_DIRECTORY "${_dir}"
+    RESULT_VARIABLE _result
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _output
+    )
+  if(_result)
+    message(FATAL_ERROR "cmake failed on ${_count} sources:\n${_output}")
+  endif()
+  file(READ "${_dir}/profile.json" _profile)
+  if(NOT _profile MATCHES "\"configure\",\"ph\":\"B\"[^}]*\"ts\":([0-9]+)")
+    message(FATAL_ERROR "No configure step in ${_dir}/profile.json")
+  endif()
+  set(_begin "${CMAKE_MATCH_1}")
+  if(NOT _profile MATCHES "\"compute\",\"ph\":\"B\"[^}]*\"ts\":([0-9]+)")
+    message(FATAL_ERROR "No compute step in ${_dir}/profile.json")
+  endif()
+  math(EXPR _ms "(${CMAKE_MATCH_1} - ${_begin}) / 1000")
+  message(STATUS "${_count} sources: configured in ${_ms} ms")
+endforeach()